@@ -31,6 +31,59 @@ TRACE_EVENT(tracing_mark_write,
 		__entry->type, __entry->pid, __get_str(name), __entry->value)
 );
 
+TRACE_EVENT(dpu_decon_irq_entry,
+	TP_PROTO(u32 id),
+	TP_ARGS(id),
+	TP_STRUCT__entry(
+		__field(u32, id)
+	),
+	TP_fast_assign(
+		__entry->id = id;
+	),
+	TP_printk("decon%u", __entry->id)
+);
+
+TRACE_EVENT(dpu_decon_irq_exit,
+	TP_PROTO(u32 id, u32 irq_sts, u32 ext_irq, u64 duration_ns),
+	TP_ARGS(id, irq_sts, ext_irq, duration_ns),
+	TP_STRUCT__entry(
+		__field(u32, id)
+		__field(u32, irq_sts)
+		__field(u32, ext_irq)
+		__field(u64, duration_ns)
+	),
+	TP_fast_assign(
+		__entry->id = id;
+		__entry->irq_sts = irq_sts;
+		__entry->ext_irq = ext_irq;
+		__entry->duration_ns = duration_ns;
+	),
+	TP_printk("decon%u irq_sts=%#x ext_irq=%#x duration_ns=%llu",
+		__entry->id, __entry->irq_sts, __entry->ext_irq,
+		__entry->duration_ns)
+);
+
+/* latency from the frame done IRQ to the end of the histogram readout */
+TRACE_EVENT(dpu_histogram_readout,
+	TP_PROTO(u32 id, u64 seq, u64 latency_ns, bool dropped),
+	TP_ARGS(id, seq, latency_ns, dropped),
+	TP_STRUCT__entry(
+		__field(u32, id)
+		__field(u64, seq)
+		__field(u64, latency_ns)
+		__field(bool, dropped)
+	),
+	TP_fast_assign(
+		__entry->id = id;
+		__entry->seq = seq;
+		__entry->latency_ns = latency_ns;
+		__entry->dropped = dropped;
+	),
+	TP_printk("decon%u seq=%llu latency_ns=%llu dropped=%d",
+		__entry->id, __entry->seq, __entry->latency_ns,
+		__entry->dropped)
+);
+
 #define DPU_ATRACE_INT_PID(name, value, pid) trace_tracing_mark_write('C', pid, name, value)
 #define DPU_ATRACE_INT(name, value) DPU_ATRACE_INT_PID(name, value, current->tgid)
 #define DPU_ATRACE_BEGIN(name) trace_tracing_mark_write('B', current->tgid, name, 0)
@@ -0,0 +1,39 @@
+/* SPDX-License-Identifier: GPL-2.0-only WITH Linux-syscall-note */
+/*
+ * Layout of the histogram stream exported by the dqe<N>_histogram misc
+ * device of the Samsung Exynos display driver.
+ *
+ * Copyright (c) 2020 Samsung Electronics Co., Ltd.
+ */
+
+#ifndef _UAPI_EXYNOS_HISTOGRAM_STREAM_H_
+#define _UAPI_EXYNOS_HISTOGRAM_STREAM_H_
+
+#include <linux/types.h>
+#include <drm/samsung_drm.h>
+
+/*
+ * The device maps read-only as a histogram_ring_header followed by
+ * @entry_cnt entries of @entry_size bytes. Frame @seq is stored in entry
+ * (@seq % @entry_cnt). An entry being written carries HISTOGRAM_SEQ_INVALID,
+ * so a mapped reader must see the same @seq before and after copying the bins.
+ * read() returns one histogram_ring_entry per frame.
+ */
+#define HISTOGRAM_RING_ENTRY_CNT	16
+#define HISTOGRAM_SEQ_INVALID		(~0ULL)
+
+struct histogram_ring_header {
+	__u32 entry_cnt;
+	__u32 entry_size;
+	__u64 head;		/* seq of the next frame to be written */
+};
+
+struct histogram_ring_entry {
+	__u64 seq;
+	__u64 timestamp_ns;	/* frame done, CLOCK_MONOTONIC */
+	__u32 dropped;		/* frames skipped before this one, read() only */
+	__u32 reserved;
+	struct histogram_bins bins;
+};
+
+#endif /* _UAPI_EXYNOS_HISTOGRAM_STREAM_H_ */
@@ -32,6 +32,12 @@
 #define DPP_SC_RATIO_5_8	((1 << 20) * 8 / 5)
 #define DPP_SC_RATIO_4_8	((1 << 20) * 8 / 4)
 #define DPP_SC_RATIO_3_8	((1 << 20) * 8 / 3)
+#define DPP_SC_RATIO_CNT	7
+#define DPP_SC_PHASE_CNT	9
+#define DPP_H_TAP_CNT		8
+#define DPP_V_TAP_CNT		4
+#define DPP_H_COEF_CNT		(DPP_H_TAP_CNT * DPP_SC_PHASE_CNT)
+#define DPP_V_COEF_CNT		(DPP_V_TAP_CNT * DPP_SC_PHASE_CNT)
 
 static struct cal_regs_desc regs_dpp[REGS_DPP_TYPE_MAX][REGS_DPP_ID_MAX];
 
@@ -44,6 +50,8 @@ static struct cal_regs_desc regs_dpp[REGS_DPP_TYPE_MAX][REGS_DPP_ID_MAX];
 	cal_read_mask(dpp_regs_desc(id), offset, mask)
 #define dpp_write_mask(id, offset, val, mask)	\
 	cal_write_mask(dpp_regs_desc(id), offset, val, mask)
+#define dpp_write_burst(id, offset, vals, cnt)	\
+	cal_write_burst(dpp_regs_desc(id), offset, vals, cnt)
 
 #define dma_regs_desc(id)			(&regs_dpp[REGS_DMA][id])
 #define dma_read(id, offset)			\
@@ -65,11 +73,57 @@ static struct cal_regs_desc regs_dpp[REGS_DPP_TYPE_MAX][REGS_DPP_ID_MAX];
 #define dma_com_write_mask(id, offset, val, mask)	\
 	cal_write_mask(dma_com_regs_desc(id), offset, val, mask)
 
+/*
+ * The coefficient registers are laid out tap-major, i.e. all phases of tap 0
+ * followed by all phases of tap 1 and so on, once for Y and once for C. The
+ * register images of every ratio bucket are built once from the tap tables so
+ * that a bucket change is a single burst copy per plane.
+ */
+static u32 h_coef_img[DPP_SC_RATIO_CNT][DPP_H_COEF_CNT];
+static u32 v_coef_img[DPP_SC_RATIO_CNT][DPP_V_COEF_CNT];
+
+/* ratio bucket currently held by each dpp, -1 if unknown */
+static int dpp_h_coef_bucket[REGS_DPP_ID_MAX];
+static int dpp_v_coef_bucket[REGS_DPP_ID_MAX];
+
+static void dpp_reg_build_coef_images(void)
+{
+	static bool built;
+	int r, i, j;
+
+	if (built)
+		return;
+
+	for (r = 0; r < DPP_SC_RATIO_CNT; r++) {
+		for (i = 0; i < DPP_SC_PHASE_CNT; i++) {
+			for (j = 0; j < DPP_H_TAP_CNT; j++)
+				h_coef_img[r][j * DPP_SC_PHASE_CNT + i] =
+					h_coef_8t[r][i][j];
+			for (j = 0; j < DPP_V_TAP_CNT; j++)
+				v_coef_img[r][j * DPP_SC_PHASE_CNT + i] =
+					v_coef_4t[r][i][j];
+		}
+	}
+
+	built = true;
+}
+
+static void dpp_reg_invalidate_coef(u32 id)
+{
+	dpp_h_coef_bucket[id] = -1;
+	dpp_v_coef_bucket[id] = -1;
+}
+
 void dpp_regs_desc_init(void __iomem *regs, const char *name,
 		enum dpp_regs_type type, unsigned int id)
 {
 	cal_regs_desc_check(type, id, REGS_DPP_TYPE_MAX, REGS_DPP_ID_MAX);
 	cal_regs_desc_set(regs_dpp, regs, name, type, id);
+
+	if (type == REGS_DPP) {
+		dpp_reg_build_coef_images();
+		dpp_reg_invalidate_coef(id);
+	}
 }
 
 /****************** IDMA CAL functions ******************/
@@ -525,56 +579,52 @@ static void dpp_reg_set_csc_params(u32 id, u32 std, u32 range)
 		dpp_reg_set_csc_coef(id, std, range);
 }
 
-static void dpp_reg_set_h_coef(u32 id, u32 h_ratio)
+static int dpp_reg_get_sc_ratio_bucket(u32 ratio)
 {
-	int i, j, k, sc_ratio;
-
-	if (h_ratio <= DPP_SC_RATIO_MAX)
-		sc_ratio = 0;
-	else if (h_ratio <= DPP_SC_RATIO_7_8)
-		sc_ratio = 1;
-	else if (h_ratio <= DPP_SC_RATIO_6_8)
-		sc_ratio = 2;
-	else if (h_ratio <= DPP_SC_RATIO_5_8)
-		sc_ratio = 3;
-	else if (h_ratio <= DPP_SC_RATIO_4_8)
-		sc_ratio = 4;
-	else if (h_ratio <= DPP_SC_RATIO_3_8)
-		sc_ratio = 5;
+	if (ratio <= DPP_SC_RATIO_MAX)
+		return 0;
+	else if (ratio <= DPP_SC_RATIO_7_8)
+		return 1;
+	else if (ratio <= DPP_SC_RATIO_6_8)
+		return 2;
+	else if (ratio <= DPP_SC_RATIO_5_8)
+		return 3;
+	else if (ratio <= DPP_SC_RATIO_4_8)
+		return 4;
+	else if (ratio <= DPP_SC_RATIO_3_8)
+		return 5;
 	else
-		sc_ratio = 6;
+		return 6;
+}
+
+static void dpp_reg_set_h_coef(u32 id, u32 h_ratio)
+{
+	int sc_ratio = dpp_reg_get_sc_ratio_bucket(h_ratio);
+	int k;
+
+	if (dpp_h_coef_bucket[id] == sc_ratio)
+		return;
+
+	for (k = 0; k < 2; k++)
+		dpp_write_burst(id, DPP_H_COEF(0, 0, k), h_coef_img[sc_ratio],
+				DPP_H_COEF_CNT);
 
-	for (i = 0; i < 9; i++)
-		for (j = 0; j < 8; j++)
-			for (k = 0; k < 2; k++)
-				dpp_write(id, DPP_H_COEF(i, j, k),
-						h_coef_8t[sc_ratio][i][j]);
+	dpp_h_coef_bucket[id] = sc_ratio;
 }
 
 static void dpp_reg_set_v_coef(u32 id, u32 v_ratio)
 {
-	int i, j, k, sc_ratio;
-
-	if (v_ratio <= DPP_SC_RATIO_MAX)
-		sc_ratio = 0;
-	else if (v_ratio <= DPP_SC_RATIO_7_8)
-		sc_ratio = 1;
-	else if (v_ratio <= DPP_SC_RATIO_6_8)
-		sc_ratio = 2;
-	else if (v_ratio <= DPP_SC_RATIO_5_8)
-		sc_ratio = 3;
-	else if (v_ratio <= DPP_SC_RATIO_4_8)
-		sc_ratio = 4;
-	else if (v_ratio <= DPP_SC_RATIO_3_8)
-		sc_ratio = 5;
-	else
-		sc_ratio = 6;
+	int sc_ratio = dpp_reg_get_sc_ratio_bucket(v_ratio);
+	int k;
+
+	if (dpp_v_coef_bucket[id] == sc_ratio)
+		return;
+
+	for (k = 0; k < 2; k++)
+		dpp_write_burst(id, DPP_V_COEF(0, 0, k), v_coef_img[sc_ratio],
+				DPP_V_COEF_CNT);
 
-	for (i = 0; i < 9; i++)
-		for (j = 0; j < 4; j++)
-			for (k = 0; k < 2; k++)
-				dpp_write(id, DPP_V_COEF(i, j, k),
-						v_coef_4t[sc_ratio][i][j]);
+	dpp_v_coef_bucket[id] = sc_ratio;
 }
 
 static void dpp_reg_set_scale_ratio(u32 id, struct dpp_params_info *p)
@@ -940,6 +990,7 @@ void dpp_reg_init(u32 id, const unsigned long attr)
 	}
 
 	if (test_bit(DPP_ATTR_DPP, &attr)) {
+		dpp_reg_invalidate_coef(id);
 		dpp_reg_set_irq_mask_all(id, 0);
 		dpp_reg_set_irq_enable(id);
 		dpp_reg_set_clock_gate_en_all(id, 0);
@@ -1058,6 +1109,12 @@ void dpp_reg_configure_params(u32 id, struct dpp_params_info *p,
 #endif
 }
 
+/* SFR writes aren't counted by this CAL */
+u32 dpp_reg_get_write_cnt(u32 id)
+{
+	return 0;
+}
+
 u32 dpp_reg_get_irq_and_clear(u32 id)
 {
 	u32 val;
@@ -1344,7 +1401,7 @@ int __dpp_check(u32 id, const struct dpp_params_info *p, unsigned long attr)
 	return 0;
 }
 
-#ifdef __linux__
+#ifdef __KERNEL__
 int __dpp_init_resources(struct dpp_device *dpp)
 {
 	struct resource *res;
@@ -18,7 +18,7 @@
 #include <decon_cal.h>
 #include <dqe_cal.h>
 #include <trace/dpu_trace.h>
-#ifdef __linux__
+#ifdef __KERNEL__
 #include "../exynos_drm_decon.h"
 #include <linux/of_address.h>
 #endif
@@ -1049,7 +1049,7 @@ static void dsc_reg_set_pps(u32 id, u32 dsc_id, struct decon_config *config,
 			    struct decon_dsc *dsc_enc)
 {
 	u32 val;
-	u8 b;
+	u8 b = 0;
 	const struct drm_dsc_config *cfg = dsc_enc->cfg;
 
 	if (cfg)
@@ -2402,7 +2402,7 @@ u32 decon_reg_get_rsc_win(u32 id)
 	return decon_read(id, RSC_STATUS_2);
 }
 
-#ifdef __linux__
+#ifdef __KERNEL__
 int __decon_init_resources(struct decon_device *decon)
 {
 	struct resource res;
@@ -38,14 +38,79 @@
 #define DPP_SC_RATIO_5_8	((1 << 20) * 8 / 5)
 #define DPP_SC_RATIO_4_8	((1 << 20) * 8 / 4)
 #define DPP_SC_RATIO_3_8	((1 << 20) * 8 / 3)
+#define DPP_SC_RATIO_CNT	7
+#define DPP_SC_PHASE_CNT	9
+#define DPP_H_TAP_CNT		8
+#define DPP_V_TAP_CNT		4
+#define DPP_H_COEF_CNT		(DPP_H_TAP_CNT * DPP_SC_PHASE_CNT)
+#define DPP_V_COEF_CNT		(DPP_V_TAP_CNT * DPP_SC_PHASE_CNT)
 
 struct cal_regs_desc regs_dpp[REGS_DPP_TYPE_MAX][REGS_DPP_ID_MAX];
 
+/*
+ * The coefficient registers are laid out tap-major, i.e. all phases of tap 0
+ * followed by all phases of tap 1 and so on, once for Y and once for C. The
+ * register images of every ratio bucket are built once from the tap tables so
+ * that a bucket change is a single burst copy per plane.
+ */
+static u32 h_coef_img[DPP_SC_RATIO_CNT][DPP_H_COEF_CNT];
+static u32 v_coef_img[DPP_SC_RATIO_CNT][DPP_V_COEF_CNT];
+
+/* ratio bucket currently held by each dpp, -1 if unknown */
+static int dpp_h_coef_bucket[REGS_DPP_ID_MAX];
+static int dpp_v_coef_bucket[REGS_DPP_ID_MAX];
+
+static void dpp_reg_build_coef_images(void)
+{
+	static bool built;
+	int r, i, j;
+
+	if (built)
+		return;
+
+	for (r = 0; r < DPP_SC_RATIO_CNT; r++) {
+		for (i = 0; i < DPP_SC_PHASE_CNT; i++) {
+			for (j = 0; j < DPP_H_TAP_CNT; j++)
+				h_coef_img[r][j * DPP_SC_PHASE_CNT + i] =
+					h_coef_8t[r][i][j];
+			for (j = 0; j < DPP_V_TAP_CNT; j++)
+				v_coef_img[r][j * DPP_SC_PHASE_CNT + i] =
+					v_coef_4t[r][i][j];
+		}
+	}
+
+	built = true;
+}
+
+static void dpp_reg_invalidate_coef(u32 id)
+{
+	dpp_h_coef_bucket[id] = -1;
+	dpp_v_coef_bucket[id] = -1;
+}
+
+/*
+ * Parameters last programmed to each dpp. A page flip usually changes only the
+ * buffer addresses, in which case only the changed base address registers are
+ * written. Invalidated by dpp_reg_init() so that the whole state is written
+ * again once the dpp is powered back up.
+ */
+struct dpp_params_shadow {
+	bool valid;
+	struct dpp_params_info p;
+};
+
+static struct dpp_params_shadow dpp_params_shadow[REGS_DPP_ID_MAX];
+
 void dpp_regs_desc_init(void __iomem *regs, phys_addr_t start, const char *name,
 		enum dpp_regs_type type, unsigned int id)
 {
 	cal_regs_desc_check(type, id, REGS_DPP_TYPE_MAX, REGS_DPP_ID_MAX);
 	cal_regs_desc_set(regs_dpp, regs, start, name, type, id);
+
+	if (type == REGS_DPP) {
+		dpp_reg_build_coef_images();
+		dpp_reg_invalidate_coef(id);
+	}
 }
 
 /****************** IDMA CAL functions ******************/
@@ -548,56 +613,52 @@ dpp_reg_set_csc_params(u32 id, u32 std, u32 range, const unsigned long attr)
 		dpp_reg_set_csc_coef(id, std, range, attr);
 }
 
+static int dpp_reg_get_sc_ratio_bucket(u32 ratio)
+{
+	if (ratio <= DPP_SC_RATIO_MAX)
+		return 0;
+	else if (ratio <= DPP_SC_RATIO_7_8)
+		return 1;
+	else if (ratio <= DPP_SC_RATIO_6_8)
+		return 2;
+	else if (ratio <= DPP_SC_RATIO_5_8)
+		return 3;
+	else if (ratio <= DPP_SC_RATIO_4_8)
+		return 4;
+	else if (ratio <= DPP_SC_RATIO_3_8)
+		return 5;
+	else
+		return 6;
+}
+
 static void dpp_reg_set_h_coef(u32 id, u32 h_ratio)
 {
-	int i, j, k, sc_ratio;
-
-	if (h_ratio <= DPP_SC_RATIO_MAX)
-		sc_ratio = 0;
-	else if (h_ratio <= DPP_SC_RATIO_7_8)
-		sc_ratio = 1;
-	else if (h_ratio <= DPP_SC_RATIO_6_8)
-		sc_ratio = 2;
-	else if (h_ratio <= DPP_SC_RATIO_5_8)
-		sc_ratio = 3;
-	else if (h_ratio <= DPP_SC_RATIO_4_8)
-		sc_ratio = 4;
-	else if (h_ratio <= DPP_SC_RATIO_3_8)
-		sc_ratio = 5;
-	else
-		sc_ratio = 6;
+	int sc_ratio = dpp_reg_get_sc_ratio_bucket(h_ratio);
+	int k;
+
+	if (dpp_h_coef_bucket[id] == sc_ratio)
+		return;
+
+	for (k = 0; k < 2; k++)
+		dpp_write_burst(id, DPP_H_COEF(0, 0, k), h_coef_img[sc_ratio],
+				DPP_H_COEF_CNT);
 
-	for (i = 0; i < 9; i++)
-		for (j = 0; j < 8; j++)
-			for (k = 0; k < 2; k++)
-				dpp_write(id, DPP_H_COEF(i, j, k),
-						h_coef_8t[sc_ratio][i][j]);
+	dpp_h_coef_bucket[id] = sc_ratio;
 }
 
 static void dpp_reg_set_v_coef(u32 id, u32 v_ratio)
 {
-	int i, j, k, sc_ratio;
-
-	if (v_ratio <= DPP_SC_RATIO_MAX)
-		sc_ratio = 0;
-	else if (v_ratio <= DPP_SC_RATIO_7_8)
-		sc_ratio = 1;
-	else if (v_ratio <= DPP_SC_RATIO_6_8)
-		sc_ratio = 2;
-	else if (v_ratio <= DPP_SC_RATIO_5_8)
-		sc_ratio = 3;
-	else if (v_ratio <= DPP_SC_RATIO_4_8)
-		sc_ratio = 4;
-	else if (v_ratio <= DPP_SC_RATIO_3_8)
-		sc_ratio = 5;
-	else
-		sc_ratio = 6;
+	int sc_ratio = dpp_reg_get_sc_ratio_bucket(v_ratio);
+	int k;
+
+	if (dpp_v_coef_bucket[id] == sc_ratio)
+		return;
+
+	for (k = 0; k < 2; k++)
+		dpp_write_burst(id, DPP_V_COEF(0, 0, k), v_coef_img[sc_ratio],
+				DPP_V_COEF_CNT);
 
-	for (i = 0; i < 9; i++)
-		for (j = 0; j < 4; j++)
-			for (k = 0; k < 2; k++)
-				dpp_write(id, DPP_V_COEF(i, j, k),
-						v_coef_4t[sc_ratio][i][j]);
+	dpp_v_coef_bucket[id] = sc_ratio;
 }
 
 static void dpp_reg_set_scale_ratio(u32 id, struct dpp_params_info *p)
@@ -803,6 +864,8 @@ static int dma_dpp_reg_set_format(u32 id, struct dpp_params_info *p,
  */
 void dpp_reg_init(u32 id, const unsigned long attr)
 {
+	dpp_params_shadow[id].valid = false;
+
 	if (test_bit(DPP_ATTR_RCD, &attr))
 		rcd_reg_init(id);
 
@@ -824,6 +887,7 @@ void dpp_reg_init(u32 id, const unsigned long attr)
 	}
 
 	if (test_bit(DPP_ATTR_DPP, &attr)) {
+		dpp_reg_invalidate_coef(id);
 		dpp_reg_set_irq_mask_all(id, 0);
 		dpp_reg_set_irq_enable(id);
 		dpp_reg_set_linecnt(id, 1);
@@ -906,16 +970,89 @@ static const u32 pattern_data[] = {
 };
 #endif
 
+static bool dpp_reg_params_addr_only(const struct dpp_params_info *old,
+		const struct dpp_params_info *new)
+{
+	return !memcmp(&old->src, &new->src, sizeof(new->src)) &&
+		!memcmp(&old->dst, &new->dst, sizeof(new->dst)) &&
+		!memcmp(&old->block, &new->block, sizeof(new->block)) &&
+		old->rot == new->rot &&
+		old->hdr == new->hdr &&
+		old->min_luminance == new->min_luminance &&
+		old->max_luminance == new->max_luminance &&
+		old->y_hd_y2_stride == new->y_hd_y2_stride &&
+		old->y_pl_c2_stride == new->y_pl_c2_stride &&
+		old->c_hd_stride == new->c_hd_stride &&
+		old->c_pl_stride == new->c_pl_stride &&
+		old->is_block == new->is_block &&
+		old->format == new->format &&
+		old->dataspace == new->dataspace &&
+		old->h_ratio == new->h_ratio &&
+		old->v_ratio == new->v_ratio &&
+		old->standard == new->standard &&
+		old->transfer == new->transfer &&
+		old->range == new->range &&
+		old->in_bpc == new->in_bpc &&
+		old->rcv_num == new->rcv_num &&
+		old->comp_type == new->comp_type &&
+		old->blk_size == new->blk_size &&
+		old->is_lossy == new->is_lossy;
+}
+
+/* writes the base addresses that differ from @old, see dma_reg_set_base_addr() */
+static void dma_reg_update_base_addr(u32 id, const struct dpp_params_info *old,
+		const struct dpp_params_info *p, const unsigned long attr)
+{
+	const bool afbc = p->comp_type == COMP_TYPE_AFBC;
+	const bool sbwc = p->comp_type == COMP_TYPE_SBWC;
+
+	if (test_bit(DPP_ATTR_IDMA, &attr)) {
+		if (old->addr[0] != p->addr[0]) {
+			dma_write(id, RDMA_BASEADDR_Y8, p->addr[0]);
+			if (afbc)
+				dma_write(id, RDMA_BASEADDR_C8, p->addr[0]);
+		}
+		if (!afbc && old->addr[1] != p->addr[1])
+			dma_write(id, RDMA_BASEADDR_C8, p->addr[1]);
+		if (sbwc && old->addr[2] != p->addr[2])
+			dma_write(id, RDMA_BASEADDR_Y2, p->addr[2]);
+		if (sbwc && old->addr[3] != p->addr[3])
+			dma_write(id, RDMA_BASEADDR_C2, p->addr[3]);
+	} else if (test_bit(DPP_ATTR_ODMA, &attr)) {
+		if (old->addr[0] != p->addr[0])
+			dma_write(id, WDMA_BASEADDR_Y8, p->addr[0]);
+		if (old->addr[1] != p->addr[1])
+			dma_write(id, WDMA_BASEADDR_C8, p->addr[1]);
+		if (sbwc && old->addr[2] != p->addr[2])
+			dma_write(id, WDMA_BASEADDR_Y2, p->addr[2]);
+		if (sbwc && old->addr[3] != p->addr[3])
+			dma_write(id, WDMA_BASEADDR_C2, p->addr[3]);
+	}
+
+	cal_log_debug(id, "base addr 1p(0x%lx) 2p(0x%lx) 3p(0x%lx) 4p(0x%lx)\n",
+			(unsigned long)p->addr[0], (unsigned long)p->addr[1],
+			(unsigned long)p->addr[2], (unsigned long)p->addr[3]);
+}
+
 void dpp_reg_configure_params(u32 id, struct dpp_params_info *p,
 		const unsigned long attr)
 {
-	const struct dpu_fmt *fmt = dpu_find_fmt_info(p->format);
+	struct dpp_params_shadow *shadow = &dpp_params_shadow[id];
+	const struct dpu_fmt *fmt;
 
 	if (test_bit(DPP_ATTR_RCD, &attr)) {
 		rcd_reg_configure_params(id, p, attr);
 		return;
 	}
 
+	if (shadow->valid && dpp_reg_params_addr_only(&shadow->p, p)) {
+		dma_reg_update_base_addr(id, &shadow->p, p, attr);
+		shadow->p = *p;
+		return;
+	}
+
+	fmt = dpu_find_fmt_info(p->format);
+
 	if (test_bit(DPP_ATTR_CSC, &attr) && IS_YUV(fmt))
 		dpp_reg_set_csc_params(id, p->standard, p->range, attr);
 
@@ -961,6 +1098,15 @@ void dpp_reg_configure_params(u32 id, struct dpp_params_info *p,
 #if defined(DMA_BIST)
 	idma_reg_set_test_pattern(id, 0, pattern_data);
 #endif
+
+	shadow->p = *p;
+	shadow->valid = true;
+}
+
+u32 dpp_reg_get_write_cnt(u32 id)
+{
+	return regs_dpp[REGS_DMA][id].write_cnt +
+		regs_dpp[REGS_DPP][id].write_cnt;
 }
 
 void cgc_reg_set_config(u32 id, bool en, dma_addr_t addr)
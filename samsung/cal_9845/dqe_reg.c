@@ -15,6 +15,7 @@
 #include <dqe_cal.h>
 #include <decon_cal.h>
 #include <drm/samsung_drm.h>
+#include <linux/bitmap.h>
 #include <asm/barrier.h>
 #include <drm/drm_print.h>
 
@@ -23,6 +24,49 @@
 
 struct cal_regs_dqe regs_dqe[REGS_DQE_ID_MAX];
 
+/*
+ * Images of the LUT registers last programmed, so that a table update only
+ * writes the words that changed. A word is also rewritten if it changed with
+ * the previous update, in case the table is double buffered and the bank being
+ * written still holds the older value. Invalid until the first full write and
+ * after the DQE lost its context.
+ */
+static struct dqe_lut_shadow {
+	bool degamma_valid;
+	bool regamma_valid;
+	bool cgc_valid;
+	u32 degamma[DQE_DEGAMMALUT_REG_CNT];
+	DECLARE_BITMAP(degamma_changed, DQE_DEGAMMALUT_REG_CNT);
+	u32 regamma[3 * DQE_REGAMMALUT_REG_CNT];
+	DECLARE_BITMAP(regamma_changed, 3 * DQE_REGAMMALUT_REG_CNT);
+	u32 cgc[3 * DRM_SAMSUNG_CGC_LUT_REG_CNT];
+	DECLARE_BITMAP(cgc_changed, 3 * DRM_SAMSUNG_CGC_LUT_REG_CNT);
+} dqe_lut_shadow[REGS_DQE_ID_MAX];
+
+/* returns true if @val has to be written to the register at @idx */
+static bool dqe_lut_shadow_update(u32 *regs, unsigned long *changed, bool valid,
+				  u32 idx, u32 val)
+{
+	const bool differs = !valid || regs[idx] != val;
+
+	if (!differs && !test_bit(idx, changed))
+		return false;
+
+	__assign_bit(idx, changed, differs);
+	regs[idx] = val;
+
+	return true;
+}
+
+void dqe_reg_invalidate_lut_shadow(u32 dqe_id)
+{
+	struct dqe_lut_shadow *shadow = &dqe_lut_shadow[dqe_id];
+
+	shadow->degamma_valid = false;
+	shadow->regamma_valid = false;
+	shadow->cgc_valid = false;
+}
+
 void dqe_regs_desc_init(void __iomem *regs, phys_addr_t start, const char *name,
 			enum dqe_version ver, unsigned int dqe_id)
 {
@@ -80,6 +124,7 @@ void dqe_reg_init(u32 dqe_id, u32 width, u32 height)
 
 void dqe_reg_set_degamma_lut(u32 dqe_id, const struct drm_color_lut *lut)
 {
+	struct dqe_lut_shadow *shadow = &dqe_lut_shadow[dqe_id];
 	int i, ret = 0;
 	u16 tmp_lut[DEGAMMA_LUT_SIZE] = {0};
 	u32 regs[DQE_DEGAMMALUT_REG_CNT] = {0};
@@ -103,9 +148,13 @@ void dqe_reg_set_degamma_lut(u32 dqe_id, const struct drm_color_lut *lut)
 	}
 
 	for (i = 0; i < DQE_DEGAMMALUT_REG_CNT; i++) {
+		if (!dqe_lut_shadow_update(shadow->degamma, shadow->degamma_changed,
+					shadow->degamma_valid, i, regs[i]))
+			continue;
 		degamma_write_relaxed(dqe_id, DQE_DEGAMMALUT(i), regs[i]);
 		cal_log_debug(0, "[%d]: 0x%x\n", i, regs[i]);
 	}
+	shadow->degamma_valid = true;
 	degamma_write(dqe_id, DQE_DEGAMMA_CON, DEGAMMA_EN);
 
 	cal_log_debug(0, "%s -\n", __func__);
@@ -113,6 +162,9 @@ void dqe_reg_set_degamma_lut(u32 dqe_id, const struct drm_color_lut *lut)
 
 void dqe_reg_set_cgc_lut(u32 dqe_id, const struct cgc_lut *lut)
 {
+	struct dqe_lut_shadow *shadow = &dqe_lut_shadow[dqe_id];
+	const u32 cnt = DRM_SAMSUNG_CGC_LUT_REG_CNT;
+	const bool valid = shadow->cgc_valid;
 	int i;
 
 	cal_log_debug(0, "%s +\n", __func__);
@@ -122,10 +174,17 @@ void dqe_reg_set_cgc_lut(u32 dqe_id, const struct cgc_lut *lut)
 		return;
 	}
 	for (i = 0; i < DRM_SAMSUNG_CGC_LUT_REG_CNT; ++i) {
-		dqe_write_relaxed(dqe_id, DQE_CGC_LUT_R(i), lut->r_values[i]);
-		dqe_write_relaxed(dqe_id, DQE_CGC_LUT_G(i), lut->g_values[i]);
-		dqe_write_relaxed(dqe_id, DQE_CGC_LUT_B(i), lut->b_values[i]);
+		if (dqe_lut_shadow_update(shadow->cgc, shadow->cgc_changed, valid,
+					i, lut->r_values[i]))
+			dqe_write_relaxed(dqe_id, DQE_CGC_LUT_R(i), lut->r_values[i]);
+		if (dqe_lut_shadow_update(shadow->cgc, shadow->cgc_changed, valid,
+					cnt + i, lut->g_values[i]))
+			dqe_write_relaxed(dqe_id, DQE_CGC_LUT_G(i), lut->g_values[i]);
+		if (dqe_lut_shadow_update(shadow->cgc, shadow->cgc_changed, valid,
+					2 * cnt + i, lut->b_values[i]))
+			dqe_write_relaxed(dqe_id, DQE_CGC_LUT_B(i), lut->b_values[i]);
 	}
+	shadow->cgc_valid = true;
 
 	cgc_write_mask(dqe_id, DQE_CGC_CON, ~0, CGC_EN_MASK);
 
@@ -140,6 +199,9 @@ void dqe_reg_set_regamma_lut(u32 dqe_id, const struct drm_color_lut *lut)
 		REGAMMA_BLUE = 2,
 		REGAMMA_MAX = 3
 	};
+	struct dqe_lut_shadow *shadow = &dqe_lut_shadow[dqe_id];
+	const u32 cnt = DQE_REGAMMALUT_REG_CNT;
+	const bool valid = shadow->regamma_valid;
 	int i, ret = 0;
 	u16 tmp_lut[REGAMMA_MAX][REGAMMA_LUT_SIZE] = {0};
 	u32 regs[REGAMMA_MAX][DQE_REGAMMALUT_REG_CNT] = {0};
@@ -168,13 +230,23 @@ void dqe_reg_set_regamma_lut(u32 dqe_id, const struct drm_color_lut *lut)
 	}
 
 	for (i = 0; i < DQE_REGAMMALUT_REG_CNT; i++) {
-		regamma_write_relaxed(dqe_id, DQE_REGAMMALUT_R(i), regs[REGAMMA_RED][i]);
-		regamma_write_relaxed(dqe_id, DQE_REGAMMALUT_G(i), regs[REGAMMA_GREEN][i]);
-		regamma_write_relaxed(dqe_id, DQE_REGAMMALUT_B(i), regs[REGAMMA_BLUE][i]);
+		if (dqe_lut_shadow_update(shadow->regamma, shadow->regamma_changed,
+					valid, i, regs[REGAMMA_RED][i]))
+			regamma_write_relaxed(dqe_id, DQE_REGAMMALUT_R(i),
+					regs[REGAMMA_RED][i]);
+		if (dqe_lut_shadow_update(shadow->regamma, shadow->regamma_changed,
+					valid, cnt + i, regs[REGAMMA_GREEN][i]))
+			regamma_write_relaxed(dqe_id, DQE_REGAMMALUT_G(i),
+					regs[REGAMMA_GREEN][i]);
+		if (dqe_lut_shadow_update(shadow->regamma, shadow->regamma_changed,
+					valid, 2 * cnt + i, regs[REGAMMA_BLUE][i]))
+			regamma_write_relaxed(dqe_id, DQE_REGAMMALUT_B(i),
+					regs[REGAMMA_BLUE][i]);
 		cal_log_debug(0, "[%d]  red: 0x%x\n", i, regs[REGAMMA_RED][i]);
 		cal_log_debug(0, "[%d]  green: 0x%x\n", i, regs[REGAMMA_GREEN][i]);
 		cal_log_debug(0, "[%d]  blue: 0x%x\n", i, regs[REGAMMA_BLUE][i]);
 	}
+	shadow->regamma_valid = true;
 	regamma_write(dqe_id, DQE_REGAMMA_CON, REGAMMA_EN);
 
 	cal_log_debug(0, "%s -\n", __func__);
@@ -651,6 +723,8 @@ void dqe_reg_set_cgc_en(u32 dqe_id, bool en)
 
 void dqe_reg_set_cgc_coef_dma_req(u32 dqe_id)
 {
+	/* LUT gets loaded by DMA behind the shadow image */
+	dqe_lut_shadow[dqe_id].cgc_valid = false;
 	dqe_reg_set_cgc_coef_dma_req_internal(dqe_id);
 }
 
@@ -15,6 +15,8 @@
  * published by the Free Software Foundation.
  */
 
+#include <asm/unaligned.h>
+#include <video/mipi_display.h>
 #include "regs-dsim.h"
 #include <dsim_cal.h>
 #include <cal_config.h>
@@ -27,6 +29,8 @@ static struct cal_regs_desc regs_desc[REGS_DSIM_TYPE_MAX][MAX_DSI_CNT];
 	cal_read(dsim_regs_desc(id), offset)
 #define dsim_write(id, offset, val)			\
 	cal_write(dsim_regs_desc(id), offset, val)
+#define dsim_write_relaxed(id, offset, val)		\
+	cal_write_relaxed(dsim_regs_desc(id), offset, val)
 #define dsim_read_mask(id, offset, mask)		\
 	cal_read_mask(dsim_regs_desc(id), offset, mask)
 #define dsim_write_mask(id, offset, val, mask)		\
@@ -1765,7 +1769,9 @@ static int dsim_reg_set_clocks(u32 id, const struct dsim_reg_config *config,
 
 		dsim_reg_set_esc_clk_prescaler(id, 1, esc_div);
 		/* get DPHY timing values using hs clock and escape clock */
-		dsim_reg_get_dphy_timing(id, clks->hs_clk, clks->esc_clk, &t);
+		ret = dsim_reg_get_dphy_timing(id, clks->hs_clk, clks->esc_clk, &t);
+		if (ret)
+			return ret;
 		dsim_reg_set_dphy_timing_values(id, &t, hsmode);
 		/* check dither sequence */
 		if (dphy_pms->dither_en) {
@@ -2252,6 +2258,32 @@ void dsim_reg_wr_tx_payload(u32 id, u32 payload)
 	dsim_write(id, DSIM_PAYLOAD, payload);
 }
 
+/*
+ * Pushes the long packet payload @buf of @len bytes into the payload fifo.
+ * Fifo words take the bytes in little endian order, so each word is a single
+ * little endian load from @buf whatever its alignment. The tail of up to three
+ * bytes is padded with zeroes. The writes are relaxed and ordered against later
+ * accesses by one barrier at the end.
+ */
+void dsim_reg_wr_tx_payloads(u32 id, const u8 *buf, size_t len)
+{
+	const size_t cnt = len / 4;
+	u32 word;
+	size_t i;
+
+	for (i = 0; i < cnt; i++)
+		dsim_write_relaxed(id, DSIM_PAYLOAD, get_unaligned_le32(buf + i * 4));
+
+	if (len % 4) {
+		word = 0;
+		for (i = cnt * 4; i < len; i++)
+			word |= buf[i] << ((i % 4) * 8);
+		dsim_write_relaxed(id, DSIM_PAYLOAD, word);
+	}
+
+	wmb();
+}
+
 u32 dsim_reg_header_fifo_is_empty(u32 id)
 {
 	return dsim_read_mask(id, DSIM_FIFOCTRL, DSIM_FIFOCTRL_EMPTY_PH_SFR);
@@ -2327,6 +2359,75 @@ int dsim_reg_rx_err_handler(u32 id, u32 rx_fifo)
 	return -EINVAL;
 }
 
+/*
+ * Requests a read with the short packet header @di, @d0, @d1 and turns the bus
+ * around for the response. The maximum return packet size goes out first if
+ * @rx_len differs from *@max_ret, the size last sent to the panel, which is
+ * updated. It's always sent without @max_ret. Returns true if it was sent.
+ */
+bool dsim_reg_wr_rx_request(u32 id, u8 di, u8 d0, u8 d1, u16 rx_len, u16 *max_ret)
+{
+	const bool set_rx_len = !max_ret || *max_ret != rx_len;
+
+	if (set_rx_len) {
+		dsim_reg_wr_tx_header(id, MIPI_DSI_SET_MAXIMUM_RETURN_PACKET_SIZE,
+				rx_len & 0xff, rx_len >> 8, false);
+		if (max_ret)
+			*max_ret = rx_len;
+	}
+
+	dsim_reg_wr_tx_header(id, di, d0, d1, true);
+
+	return set_rx_len;
+}
+
+/*
+ * Takes the response to a read request out of the rx fifo into @rx_buf of
+ * @rx_len bytes. Returns the number of bytes read, 0 for an EoTp or an
+ * acknowledge without error, -EINVAL for an error report and -EBUSY for a
+ * packet that isn't a read response.
+ */
+ssize_t dsim_reg_rd_rx_packet(u32 id, u8 *rx_buf, size_t rx_len)
+{
+	u32 rx_fifo = dsim_reg_get_rx_fifo(id);
+	u32 rx_size, i = 0;
+
+	cal_log_debug(id, "rx fifo:0x%8x, response:0x%x, rx_len:%zu\n", rx_fifo,
+			rx_fifo & 0xff, rx_len);
+
+	switch (rx_fifo & 0xff) {
+	case MIPI_DSI_RX_ACKNOWLEDGE_AND_ERROR_REPORT:
+		return dsim_reg_rx_err_handler(id, rx_fifo);
+	case MIPI_DSI_RX_END_OF_TRANSMISSION:
+		cal_log_debug(id, "EoTp was received\n");
+		return 0;
+	case MIPI_DSI_RX_DCS_SHORT_READ_RESPONSE_2BYTE:
+	case MIPI_DSI_RX_GENERIC_SHORT_READ_RESPONSE_2BYTE:
+		WARN_ON(rx_len > 2);
+		rx_buf[1] = (rx_fifo >> 16) & 0xff;
+		fallthrough;
+	case MIPI_DSI_RX_DCS_SHORT_READ_RESPONSE_1BYTE:
+	case MIPI_DSI_RX_GENERIC_SHORT_READ_RESPONSE_1BYTE:
+		rx_buf[0] = (rx_fifo >> 8) & 0xff;
+		return rx_len;
+	case MIPI_DSI_RX_DCS_LONG_READ_RESPONSE:
+	case MIPI_DSI_RX_GENERIC_LONG_READ_RESPONSE:
+		rx_size = (rx_fifo & 0x00ffff00) >> 8;
+
+		while (i < rx_size) {
+			const u32 rx_max = min_t(u32, rx_size, i + sizeof(rx_fifo));
+
+			rx_fifo = dsim_reg_get_rx_fifo(id);
+			for (; i < rx_max; i++, rx_fifo >>= 8)
+				rx_buf[i] = rx_fifo & 0xff;
+		}
+		return rx_size;
+	default:
+		cal_log_err(id, "packet format is invalid (rx_fifo=0x%x)\n", rx_fifo);
+		return -EBUSY;
+	}
+}
+
 /*
  * 0 = Updated Register : operating
  * 1 = Shadow Register  : programming
@@ -14,7 +14,7 @@
 #define __CAL_OS_CONFIG_H__
 
 /* include headers */
-#ifdef __linux__
+#ifdef __KERNEL__
 #include <linux/io.h>		/* readl/writel */
 #include <linux/delay.h>	/* udelay */
 #include <linux/err.h>		/* EBUSY, EINVAL */
@@ -28,33 +28,104 @@
 #include <video/mipi_display.h>
 #include <drm/drm_print.h>
 #else
+/*
+ * Outside of the kernel the CAL is backed by a simulated register file, see
+ * cal_sim.c. regs_desc->regs points to host memory holding the registers,
+ * writes land there and are logged, reads return it unless a value has been
+ * scripted for the register, e.g. to let status polls complete.
+ */
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>		/* memcpy */
+#include <strings.h>		/* ffs */
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef unsigned long long u64;
+typedef int32_t s32;
+typedef u64 phys_addr_t;
+
+struct drm_printer;
+
+struct cal_sim_write {
+	uintptr_t addr;		/* register address, or physical one if protected */
+	uint32_t val;
+	bool protected;
+};
 
-/* TODO: Check with u-boot */
-/* non-exist function define if required */
-#ifndef readl
-#define readl
-#define writel
-#endif
+uint32_t cal_sim_readl(const volatile void *addr);
+void cal_sim_writel(uint32_t val, volatile void *addr);
+void cal_sim_wmb(void);
+int set_priv_reg(phys_addr_t reg, uint32_t val);
+
+void cal_sim_reset(void);
+void cal_sim_set_write_log(struct cal_sim_write *log, size_t size);
+size_t cal_sim_get_write_count(void);
+size_t cal_sim_get_read_count(void);
+size_t cal_sim_get_barrier_count(void);
+int cal_sim_script_read(const volatile void *addr, const uint32_t *vals,
+		size_t cnt);
 
-#ifndef __iomem
 #define __iomem
+#ifndef unlikely
+#define unlikely(x)		__builtin_expect(!!(x), 0)
 #endif
-
-#ifndef udelay
-#define udelay
+#ifndef DIV_ROUND_UP
+#define DIV_ROUND_UP(n, d)	(((n) + (d) - 1) / (d))
 #endif
 
-#ifndef WARN_ON
-#define WARN_ON
-#endif
+/* like on arm64, writel() is a write barrier followed by the relaxed write */
+#define readl(addr)			cal_sim_readl(addr)
+#define writel(val, addr)		do { cal_sim_wmb(); cal_sim_writel(val, addr); } while (0)
+#define readl_relaxed(addr)		cal_sim_readl(addr)
+#define writel_relaxed(val, addr)	cal_sim_writel(val, addr)
+#define wmb()				cal_sim_wmb()
 
-#ifndef pr_info
-#define pr_debug
-#define pr_warn
-#define pr_info
-#define pr_err
-#define pr_info_ratelimited
-#endif
+static inline void __iowrite32_copy(volatile void *to, const void *from,
+		size_t count)
+{
+	volatile uint32_t *dst = to;
+	const uint32_t *src = from;
+
+	while (count--)
+		cal_sim_writel(*src++, dst++);
+}
+
+/* time doesn't pass in simulation, polls retry until a scripted value matches */
+#define udelay(us)			do { } while (0)
+#define readl_poll_timeout_atomic(addr, val, cond, delay_us, timeout_us)	\
+	({								\
+		unsigned long __tries = (delay_us) ?			\
+			(timeout_us) / (delay_us) + 1 : (timeout_us) + 1;	\
+		for (;;) {						\
+			(val) = readl(addr);				\
+			if (cond)					\
+				break;					\
+			if (!__tries--)					\
+				break;					\
+		}							\
+		(cond) ? 0 : -ETIMEDOUT;				\
+	})
+
+#define EXPORT_SYMBOL(sym)
+#define WARN_ON(cond)							\
+	({								\
+		int __ret = !!(cond);					\
+		if (__ret)						\
+			fprintf(stderr, "WARN_ON(%s) %s:%d\n", #cond,	\
+				__FILE__, __LINE__);			\
+		__ret;							\
+	})
+
+#define pr_debug(fmt, ...)	do { if (0) printf(fmt, ##__VA_ARGS__); } while (0)
+#define pr_info(fmt, ...)	printf(fmt, ##__VA_ARGS__)
+#define pr_warn(fmt, ...)	fprintf(stderr, fmt, ##__VA_ARGS__)
+#define pr_err(fmt, ...)	fprintf(stderr, fmt, ##__VA_ARGS__)
+#define pr_info_ratelimited	pr_info
 #endif
 
 enum elem_size {
@@ -67,6 +138,7 @@ struct cal_regs_desc {
 	void __iomem *regs;
 	volatile bool write_protected;
 	phys_addr_t start;
+	uint32_t write_cnt;	/* SFR writes counted by the IP accessors */
 };
 
 /* common function macro for register control file */
@@ -122,6 +194,21 @@ static inline void cal_write_relaxed(struct cal_regs_desc *regs_desc,
 	}
 }
 
+/* writes @cnt consecutive 32-bit registers starting at @offset */
+static inline void cal_write_burst(struct cal_regs_desc *regs_desc,
+		uint32_t offset, const uint32_t *vals, size_t cnt)
+{
+	size_t i;
+
+	if (unlikely(regs_desc->write_protected)) {
+		for (i = 0; i < cnt; i++)
+			cal_write(regs_desc, offset + i * 4, vals[i]);
+		return;
+	}
+
+	__iowrite32_copy(regs_desc->regs + offset, vals, cnt);
+}
+
 static inline uint32_t cal_read_mask(struct cal_regs_desc *regs_desc,
 		uint32_t offset, uint32_t mask)
 {
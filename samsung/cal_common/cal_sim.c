@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * cal_common/cal_sim.c
+ *
+ * Simulated register backend for building the CAL outside of the kernel.
+ *
+ * Registers live in host memory set up as regs_desc->regs by the caller.
+ * Every write is stored there, counted and appended to an optional write log.
+ * Write barriers are counted too, including the one writel() implies.
+ * Reads return the stored value unless a sequence of values has been scripted
+ * for the register; once a script is consumed its last value keeps being
+ * returned, which lets status polls such as run status or idle checks finish.
+ *
+ * This file is not part of the kernel module build.
+ */
+
+#ifndef __KERNEL__
+
+#include "cal_config.h"
+
+#define CAL_SIM_MAX_SCRIPTS	64
+
+struct cal_sim_script {
+	const volatile void *addr;
+	const uint32_t *vals;
+	size_t cnt;
+	size_t pos;
+};
+
+static struct {
+	struct cal_sim_write *log;
+	size_t log_size;
+	size_t write_cnt;
+	size_t read_cnt;
+	size_t barrier_cnt;
+	struct cal_sim_script scripts[CAL_SIM_MAX_SCRIPTS];
+	size_t script_cnt;
+} cal_sim;
+
+static void cal_sim_log_write(uintptr_t addr, uint32_t val, bool protected)
+{
+	if (cal_sim.log && cal_sim.write_cnt < cal_sim.log_size) {
+		struct cal_sim_write *w = &cal_sim.log[cal_sim.write_cnt];
+
+		w->addr = addr;
+		w->val = val;
+		w->protected = protected;
+	}
+	cal_sim.write_cnt++;
+}
+
+uint32_t cal_sim_readl(const volatile void *addr)
+{
+	size_t i;
+
+	cal_sim.read_cnt++;
+
+	for (i = 0; i < cal_sim.script_cnt; i++) {
+		struct cal_sim_script *s = &cal_sim.scripts[i];
+
+		if (s->addr != addr)
+			continue;
+
+		if (s->pos < s->cnt - 1)
+			return s->vals[s->pos++];
+		return s->vals[s->cnt - 1];
+	}
+
+	return *(const volatile uint32_t *)addr;
+}
+
+void cal_sim_writel(uint32_t val, volatile void *addr)
+{
+	*(volatile uint32_t *)addr = val;
+	cal_sim_log_write((uintptr_t)addr, val, false);
+}
+
+void cal_sim_wmb(void)
+{
+	cal_sim.barrier_cnt++;
+	__sync_synchronize();
+}
+
+int set_priv_reg(phys_addr_t reg, uint32_t val)
+{
+	cal_sim_log_write((uintptr_t)reg, val, true);
+	return 0;
+}
+
+/* drop scripts and counters, the write log buffer is kept */
+void cal_sim_reset(void)
+{
+	cal_sim.write_cnt = 0;
+	cal_sim.read_cnt = 0;
+	cal_sim.barrier_cnt = 0;
+	cal_sim.script_cnt = 0;
+}
+
+/* writes beyond @size are counted but not logged */
+void cal_sim_set_write_log(struct cal_sim_write *log, size_t size)
+{
+	cal_sim.log = log;
+	cal_sim.log_size = log ? size : 0;
+	cal_sim.write_cnt = 0;
+}
+
+size_t cal_sim_get_write_count(void)
+{
+	return cal_sim.write_cnt;
+}
+
+size_t cal_sim_get_read_count(void)
+{
+	return cal_sim.read_cnt;
+}
+
+size_t cal_sim_get_barrier_count(void)
+{
+	return cal_sim.barrier_cnt;
+}
+
+/*
+ * Reads of @addr return @vals in order, then the last one. @vals must stay
+ * valid until cal_sim_reset(). A new script for the same register replaces
+ * the previous one.
+ */
+int cal_sim_script_read(const volatile void *addr, const uint32_t *vals,
+		size_t cnt)
+{
+	struct cal_sim_script *s = NULL;
+	size_t i;
+
+	if (!vals || !cnt)
+		return -EINVAL;
+
+	for (i = 0; i < cal_sim.script_cnt; i++) {
+		if (cal_sim.scripts[i].addr == addr) {
+			s = &cal_sim.scripts[i];
+			break;
+		}
+	}
+
+	if (!s) {
+		if (cal_sim.script_cnt >= CAL_SIM_MAX_SCRIPTS)
+			return -ENOSPC;
+		s = &cal_sim.scripts[cal_sim.script_cnt++];
+	}
+
+	s->addr = addr;
+	s->vals = vals;
+	s->cnt = cnt;
+	s->pos = 0;
+
+	return 0;
+}
+
+#endif /* __KERNEL__ */
@@ -121,25 +121,35 @@ enum dpp_regs_type {
 
 extern struct cal_regs_desc regs_dpp[REGS_DPP_TYPE_MAX][REGS_DPP_ID_MAX];
 
+/* only DPP and DMA writes are counted, for dpp_reg_get_write_cnt() */
+static inline struct cal_regs_desc *
+dpp_count_write(struct cal_regs_desc *regs_desc, u32 cnt)
+{
+	regs_desc->write_cnt += cnt;
+	return regs_desc;
+}
+
 #define dpp_regs_desc(id)			(&regs_dpp[REGS_DPP][id])
 #define dpp_read(id, offset)			\
 	cal_read(dpp_regs_desc(id), offset)
 #define dpp_write(id, offset, val)		\
-	cal_write(dpp_regs_desc(id), offset, val)
+	cal_write(dpp_count_write(dpp_regs_desc(id), 1), offset, val)
 #define dpp_read_mask(id, offset, mask)	\
 	cal_read_mask(dpp_regs_desc(id), offset, mask)
 #define dpp_write_mask(id, offset, val, mask)	\
-	cal_write_mask(dpp_regs_desc(id), offset, val, mask)
+	cal_write_mask(dpp_count_write(dpp_regs_desc(id), 1), offset, val, mask)
+#define dpp_write_burst(id, offset, vals, cnt)	\
+	cal_write_burst(dpp_count_write(dpp_regs_desc(id), cnt), offset, vals, cnt)
 
 #define dma_regs_desc(id)			(&regs_dpp[REGS_DMA][id])
 #define dma_read(id, offset)			\
 	cal_read(dma_regs_desc(id), offset)
 #define dma_write(id, offset, val)		\
-	cal_write(dma_regs_desc(id), offset, val)
+	cal_write(dpp_count_write(dma_regs_desc(id), 1), offset, val)
 #define dma_read_mask(id, offset, mask)	\
 	cal_read_mask(dma_regs_desc(id), offset, mask)
 #define dma_write_mask(id, offset, val, mask)	\
-	cal_write_mask(dma_regs_desc(id), offset, val, mask)
+	cal_write_mask(dpp_count_write(dma_regs_desc(id), 1), offset, val, mask)
 
 struct decon_frame {
 	int x;
@@ -230,6 +240,7 @@ void dpp_reg_init(u32 id, const unsigned long attr);
 int dpp_reg_deinit(u32 id, bool reset, const unsigned long attr);
 void dpp_reg_configure_params(u32 id, struct dpp_params_info *p,
 		const unsigned long attr);
+u32 dpp_reg_get_write_cnt(u32 id);
 
 /* DPU_DMA, DPP DEBUG */
 void __dpp_dump(struct drm_printer *p, u32 id, void __iomem *regs, void __iomem *dma_regs,
@@ -253,7 +264,7 @@ void cgc_reg_set_cgc_start(u32 id);
 
 void dma_reg_get_shd_addr(u32 id, u32 shd_addr[], const unsigned long attr);
 
-#ifdef __linux__
+#ifdef __KERNEL__
 struct dpp_device;
 static inline int __dpp_init_resources(struct dpp_device *dpp) { return 0; }
 #endif
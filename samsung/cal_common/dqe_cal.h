@@ -63,7 +63,7 @@ struct cal_regs_offset {
 	u32 hist_offset;
 };
 
-static struct cal_regs_offset regs_dqe_offset[DQE_VERSION_MAX] = {
+static struct cal_regs_offset regs_dqe_offset[DQE_VERSION_MAX] __maybe_unused = {
 	{0x0,   0x0,   0x0,   0x0,   0x0,   0x0},       /* GS101(9845) EVT0/A0 */
 	{0x400, 0x800, 0x800, 0x800, 0x400, 0x400},     /* GS101(9845) EVT1/B0 */
 	{0x400, 0x800, 0x800, 0x800, 0x400, 0x400},	/* GS201(9855) */
@@ -173,6 +173,7 @@ struct exynos_atc {
 void dqe_regs_desc_init(void __iomem *regs, phys_addr_t start, const char *name,
 			enum dqe_version ver, u32 dqe_id);
 void dqe_reg_init(u32 dqe_id, u32 width, u32 height);
+void dqe_reg_invalidate_lut_shadow(u32 dqe_id);
 void dqe_reg_set_degamma_lut(u32 dqe_id, const struct drm_color_lut *lut);
 void dqe_reg_set_cgc_lut(u32 dqe_id, const struct cgc_lut *lut);
 void dqe_reg_set_regamma_lut(u32 dqe_id, const struct drm_color_lut *lut);
@@ -13,6 +13,7 @@
 #ifndef __SAMSUNG_DSIM_CAL_H__
 #define __SAMSUNG_DSIM_CAL_H__
 
+#include <cal_config.h>
 #include <exynos_panel.h>
 
 #define MAX_DSI_CNT 2
@@ -60,6 +61,7 @@
 #define MAX_RX_FIFO		((64 * 4) - RX_PHK_HEADER_SIZE)
 #define MAX_PH_FIFO		32
 #define MAX_PL_FIFO		2048
+#define PL_FIFO_THRESHOLD	mult_frac(MAX_PL_FIFO, 75, 100) /* 75% */
 
 enum dsim_regs_id {
 	REGS_DSIM0_ID = 0,
@@ -214,14 +216,78 @@ int dsim_reg_stop_and_enter_ulps(u32 id, u32 ddi_type, u32 lanes);
 int dsim_reg_get_int_and_clear(u32 id);
 void dsim_reg_clear_int(u32 id, u32 int_src);
 
+/*
+ * Room check before adding @ph packet headers and @pl payload bytes to the
+ * @pend_ph headers and @pend_pl bytes already in the cmd fifos for packet go.
+ * Returns 0 if they fit, -ENOSPC if the pending packets have to be sent out
+ * first and -EINVAL if they don't fit even into empty fifos.
+ */
+static inline int dsim_check_cmd_fifo_room(u32 pend_ph, u32 pend_pl, u32 ph, u32 pl)
+{
+	if (ph > MAX_PH_FIFO || pl > MAX_PL_FIFO)
+		return -EINVAL;
+
+	if (pend_ph + ph > MAX_PH_FIFO || pend_pl + pl > MAX_PL_FIFO)
+		return -ENOSPC;
+
+	return 0;
+}
+
+/* steps dsim_plan_cmd_batch() asks for, to be taken in this order */
+#define DSIM_BATCH_SPLIT	BIT(0)	/* send out the pending packets first */
+#define DSIM_BATCH_SINGLE	BIT(1)	/* nothing pending, send without packet go */
+#define DSIM_BATCH_START	BIT(2)	/* first packets of a batch, enable packet go */
+#define DSIM_BATCH_FLUSH	BIT(3)	/* send out the batch once they're written */
+
+/*
+ * Plans queueing @ph packet headers with @pl payload bytes behind the @pend_ph
+ * headers and @pend_pl bytes pending for packet go, @last if the caller ends
+ * the batch with them. A batch is split when the packets don't fit next to
+ * the pending ones. A single message (!@image) also ends the batch once the
+ * fifos are nearly full, and goes out on its own when it ends an empty batch.
+ * Returns a mask of DSIM_BATCH_* steps or -EINVAL if the packets don't fit
+ * even into empty fifos.
+ */
+static inline int dsim_plan_cmd_batch(u32 pend_ph, u32 pend_pl, u32 ph, u32 pl,
+				      bool last, bool image)
+{
+	int ret = dsim_check_cmd_fifo_room(pend_ph, pend_pl, ph, pl);
+	int steps = 0;
+
+	if (ret == -EINVAL)
+		return ret;
+
+	if (ret == -ENOSPC) {
+		steps |= DSIM_BATCH_SPLIT;
+		pend_ph = 0;
+		pend_pl = 0;
+	}
+
+	if (!image && (pend_ph + ph == MAX_PH_FIFO || pend_pl + pl > PL_FIFO_THRESHOLD))
+		last = true;
+
+	if (!image && last && !pend_ph)
+		return steps | DSIM_BATCH_SINGLE;
+
+	if (!pend_ph)
+		steps |= DSIM_BATCH_START;
+	if (last)
+		steps |= DSIM_BATCH_FLUSH;
+
+	return steps;
+}
+
 /* DSIM read/write command control */
 void dsim_reg_wr_tx_header(u32 id, u8 di, u8 d0, u8 d1, bool bta);
 void dsim_reg_wr_tx_payload(u32 id, u32 payload);
+void dsim_reg_wr_tx_payloads(u32 id, const u8 *buf, size_t len);
 u32 dsim_reg_header_fifo_is_empty(u32 id);
 u32 dsim_reg_payload_fifo_is_empty(u32 id);
 u32 dsim_reg_get_rx_fifo(u32 id);
 u32 dsim_reg_rx_fifo_is_empty(u32 id);
 int dsim_reg_rx_err_handler(u32 id, u32 rx_fifo);
+bool dsim_reg_wr_rx_request(u32 id, u8 di, u8 d0, u8 d1, u16 rx_len, u16 *max_ret);
+ssize_t dsim_reg_rd_rx_packet(u32 id, u8 *rx_buf, size_t rx_len);
 u32 dsim_reg_get_ph_cnt(u32 id);
 bool dsim_reg_has_pend_cmd(u32 id);
 
@@ -33,881 +33,367 @@
 #include <dt-bindings/clock/exynos9820.h>
 #endif
 
+#include <linux/hrtimer.h>
+#include <linux/jhash.h>
 #include <linux/kernel.h>
+#include <linux/workqueue.h>
 #include <trace/dpu_trace.h>
 #include "exynos_drm_decon.h"
 #include "exynos_drm_format.h"
 #include "exynos_drm_writeback.h"
 
-#define DISP_FACTOR_PCT		100UL
-#define MULTI_FACTOR		(1UL << 10)
-#define ROT_READ_BYTE		(32) /* unit : BYTE(= pixel, based on NV12) */
-
-#define ACLK_100MHZ_PERIOD	10000UL
-#define FRAME_TIME_NSEC		1000000000UL	/* 1sec */
-
-/* TODO: remove it after we move logic into bts driver */
-#define NUM_INTERCONNECT_CH		4
-
-#define DPU_DEBUG_BTS(fmt, args...)	pr_debug("[BTS] "fmt,  ##args)
-#define DPU_INFO_BTS(fmt, args...)	pr_info("[BTS] "fmt,  ##args)
-#define DPU_ERR_BTS(fmt, args...)	pr_err("[BTS] "fmt, ##args)
-
 /*
- * 1. function clock
- *    panel_clk = panel_w * panel_h * fps * margin / ppc
- *    vertical scale-down case (src_h > dst_h)
- *     clk[i] = (line_a * ratio_a + line_b * (1 - ratio_a)) *
- *                  panel_h * fps * margin / ppc
- *        - line_a = max((ratio_v - 2) * src_w + max(src_w, dst_w), panel_w + diff_w)
- *        - line_b = max((ratio_v - 1) * src_w + max(src_w, dst_w), panel_w + diff_w)
- *        - ratio_v = ceiling(src_h / dst_h)
- *        - ratio_a = ratio_v - (src_h / dst_h)
- *        - diff_w = (src_w <= dst_w) ? 0 : src_w - dst_w
- *    non-vertical scale-down case
- *     clk[i] = ((panel_w + diff_w) * ratio_v + panel_w * (1 - ratio_v)) *
- *                  panel_h * fps * margin / ppc
- *        - ratio_v = (src_h >= dst_h) ? 1 : src_h / dst_h
- *        - diff_w = (src_w <= dst_w) ? 0 : src_w - dst_w
- *    margin = 1.1 + HW bubble cycles
- *    aclk1 = max(panel_clk, clk[i])
- * 2. AXI throughput clock
- *    1) fps based
- *       clk_bw[i] = src_w * src_h * fps * (bpp / 8) * (panel_h / dst_h) * 1.1
- *                       / (bus_width * bus_util_pct)
- *    2) rotation throughput for initial latency
- *       clk_r[i] = src_h * 32 * (bpp / 8) / (bus_width * rot_util_pct) / (v_blank)
- *       # v_blank : command - TE_hi_pulse
- *                   video - (vbp) @initial-frame, (vbp+vfp) @inter-frame
- *    if (clk_bw[i] < clk_r[i])
- *       clk_bw[i] = clk_r[i]
- *    aclk2 = max(clk for sum(same axi overlap bw[i]))
- *
- * => aclk_dpu = max(aclk1, aclk2)
+ * bandwidth of all decons is summed up during calculation, serialize against
+ * commits running in parallel on other decons
  */
+static DEFINE_MUTEX(dpu_bts_lock);
 
-/* unit : usec x 1000 -> 5592 (5.592us) for WQHD+ case */
-static inline u32 dpu_bts_get_one_line_time(u32 lcd_height, u32 vbp, u32 vfp,
-		u32 vsa, u32 fps)
+static void dpu_bts_get_disp_info(const struct decon_device *decon,
+				  struct dpu_bts_disp_info *disp)
 {
-	u32 tot_v;
-	int tmp;
-
-	tot_v = lcd_height + vfp + vsa + vbp;
-	tmp = DIV_ROUND_UP(FRAME_TIME_NSEC, fps);
-
-	return (tmp / tot_v);
+	disp->id = decon->id;
+	disp->width = decon->config.image_width;
+	disp->height = decon->config.image_height;
+	disp->video_mode = decon->config.mode.op_mode == DECON_VIDEO_MODE;
+	disp->dsc_enabled = decon->config.dsc.enabled;
+	disp->dsc_count = decon->config.dsc.dsc_count;
+	disp->slice_count = decon->config.dsc.slice_count;
+	disp->fps = decon->bts.fps;
+	disp->vbp = decon->bts.vbp;
+	disp->vfp = decon->bts.vfp;
+	disp->vsa = decon->bts.vsa;
+	disp->vblank_usec = decon->bts.vblank_usec;
 }
 
-/* framebuffer compressor(AFBC, SBWC) line delay is usually 4 */
-static inline u32 dpu_bts_comp_latency(u32 src_w, u32 ppc, u32 line_delay)
+static void dpu_bts_get_frame(const struct decon_device *decon, struct dpu_bts_frame *frame)
 {
-	return mult_frac(src_w, line_delay, ppc);
-}
+	const struct decon_device *other;
+	int i, j;
 
-/* scaler line delay is usually 3
- * scaling order : horizontal -> vertical scale
- * -> need to reflect scale-ratio
- */
-static inline u32 dpu_bts_scale_latency(u32 src_w, u32 dst_w, u32 ppc,
-				u32 line_delay)
-{
-	if (src_w > dst_w)
-		return mult_frac(src_w * line_delay, src_w, dst_w * ppc);
-	else
-		return DIV_ROUND_CLOSEST(src_w * line_delay, ppc);
-}
+	memcpy(frame->win_config, decon->bts.win_config, sizeof(frame->win_config));
+	frame->wb_config = decon->bts.wb_config;
+	frame->rcd_config = decon->bts.rcd_win_config.win;
+	frame->win_cnt = decon->win_cnt;
 
-/* rotator ppc is usually 4 or 8
- * 1-read : 32BYTE (pixel)
- */
-static inline u32 dpu_bts_rotate_latency(u32 src_w, u32 r_ppc)
-{
-	return (src_w * (ROT_READ_BYTE / r_ppc));
-}
+	for (i = 0; i < MAX_DECON_CNT; i++) {
+		other = get_decon_drvdata(i);
+		if (!other || other == decon)
+			continue;
 
-/*
- * [DSC]
- * Line memory is necessary like following.
- *  1EA(1ppc) : 2-line for 2-slice, 1-line for 1-slice
- *  2EA(2ppc) : 3.5-line for 4-slice (DSCC 0.5-line + DSC 3-line)
- *        2.5-line for 2-slice (DSCC 0.5-line + DSC 2-line)
- *
- * [DECON] none
- * When 1H is filled at OUT_FIFO, it immediately transfers to DSIM.
- */
-static inline u32 dpu_bts_dsc_latency(u32 slice_num, u32 dsc_cnt,
-		u32 dst_w, u32 ppc)
-{
-	u32 lat_dsc = dst_w;
-
-	switch (slice_num) {
-	case 1:
-		/* DSC: 1EA */
-		lat_dsc = dst_w * 1;
-		break;
-	case 2:
-		if (dsc_cnt == 1)
-			lat_dsc = dst_w * 2;
-		else
-			lat_dsc = (dst_w * 25) / (10 * ppc);
-		break;
-	case 4:
-		/* DSC: 2EA */
-		lat_dsc = (dst_w * 35) / (10 * ppc);
-		break;
-	default:
-		break;
+		frame->other_rt_avg_bw += other->bts.rt_avg_bw;
+		for (j = 0; j < MAX_AXI_PORT; j++)
+			frame->other_ch_bw[j] += other->bts.ch_bw[j];
 	}
-
-	return lat_dsc;
 }
 
-/*
- * unit : nsec x 1000
- * reference aclk : 100MHz (-> 10ns x 1000)
- * # cycles = usec * aclk_mhz
- */
-static inline u32 dpu_bts_convert_aclk_to_ns(u32 aclk_mhz)
+static struct dpu_bts_cache_entry *
+dpu_bts_cache_lookup(struct dpu_bts_cache *cache, const struct dpu_bts_cache_key *key, u32 hash)
 {
-	return ((ACLK_100MHZ_PERIOD * 100) / aclk_mhz);
-}
+	int i;
 
-/*
- * return : kHz value based on 1-pixel processing pipe-line
- */
-static u64 dpu_bts_get_resol_clock(u32 xres, u32 yres, u32 fps)
-{
-	u64 margin;
-	u64 resol_khz;
+	for (i = 0; i < BTS_CACHE_SIZE; i++) {
+		struct dpu_bts_cache_entry *entry = &cache->entries[i];
 
-	/*
-	 * aclk_khz = vclk_1pix * ( 1.1 + (48+20)/WIDTH ) : x1000
-	 * @ (1.1)   : BUS Latency Considerable Margin (10%)
-	 * @ (48+20) : HW bubble cycles
-	 *      - 48 : 12 cycles per slice, total 4 slice
-	 *      - 20 : hblank cycles for other HW module
-	 */
-	margin = 1100 + ((48000 + 20000) / xres);
-	/* convert to kHz unit */
-	resol_khz = (xres * yres * fps * margin / 1000) / 1000;
+		if (entry->valid && entry->hash == hash && !memcmp(&entry->key, key, sizeof(*key)))
+			return entry;
+	}
 
-	return resol_khz;
+	return NULL;
 }
 
-static u32 dpu_bts_get_vblank_time_ns(struct decon_device *decon)
+static void dpu_bts_cache_store(struct dpu_bts_cache *cache, const struct dpu_bts_cache_key *key,
+				u32 hash, const struct dpu_bts_result *res)
 {
-	u32 line_t_ns, v_blank_t_ns;
+	struct dpu_bts_cache_entry *entry = &cache->entries[cache->next];
 
-	line_t_ns = dpu_bts_get_one_line_time(decon->config.image_height,
-		decon->bts.vbp, decon->bts.vfp, decon->bts.vsa, decon->bts.fps);
-	if (decon->config.mode.op_mode == DECON_VIDEO_MODE)
-		v_blank_t_ns = (decon->bts.vbp + decon->bts.vfp) * line_t_ns;
-	else
-		v_blank_t_ns = decon->bts.vblank_usec * 1000U;
+	cache->next = (cache->next + 1) % BTS_CACHE_SIZE;
 
-	DPU_DEBUG_BTS("  -line_t_ns(%u) v_blank_t_ns(%u)\n",
-			line_t_ns, v_blank_t_ns);
-
-	return v_blank_t_ns;
+	entry->valid = true;
+	entry->hash = hash;
+	entry->key = *key;
+	entry->res = *res;
 }
 
-static u32 dpu_bts_find_nearest_high_freq(struct decon_device *decon, u32 aclk_base)
+static void dpu_bts_apply_result(struct decon_device *decon, const struct dpu_bts_result *res)
 {
-	int i;
-
-	if (aclk_base > decon->bts.dfs_lv_khz[0]) {
-		DPU_DEBUG_BTS("  aclk_base is greater than L0 frequency!");
-		i = 0;
-	} else {
-		/* search from low frequency level */
-		for (i = (decon->bts.dfs_lv_cnt - 1); i >= 0; i--) {
-			if (aclk_base <= decon->bts.dfs_lv_khz[i])
-				break;
-		}
-	}
-	DPU_DEBUG_BTS("  Nearest DFS: %u KHz @L%d\n", decon->bts.dfs_lv_khz[i], i);
-
-	return i;
+	decon->bts.resol_clk = res->resol_clk;
+	decon->bts.peak = res->peak;
+	decon->bts.rt_avg_bw = res->rt_avg_bw;
+	decon->bts.read_bw = res->read_bw;
+	decon->bts.write_bw = res->write_bw;
+	decon->bts.total_bw = res->total_bw;
+	decon->bts.max_disp_freq = res->max_disp_freq;
+	memcpy(decon->bts.ch_bw, res->ch_bw, sizeof(decon->bts.ch_bw));
 }
 
 /*
- * [caution] src_w/h is rotated size info
- * - src_w : src_h @original input image
- * - src_h : src_w @original input image
+ * Compositor tends to send the same layer configuration frame after frame, reuse results of
+ * previous calculations whenever all inputs are the same. Since the results are the same as
+ * already voted ones, dpu_bts_update_resources() won't update the vote either.
  */
-static u64 dpu_bts_calc_rotate_aclk(struct decon_device *decon, u32 aclk_base,
-		u32 ppc, u32 src_w, u32 dst_w,
-		bool is_comp, bool is_downscale, bool is_dsc)
-{
-	u32 dfs_idx = 0;
-	u32 dpu_cycle, basic_cycle, dsi_cycle, module_cycle = 0;
-	u32 comp_cycle = 0, rot_cycle = 0, scale_cycle = 0, dsc_cycle = 0;
-	u32 rot_init_bw = 0; /* KB/s */
-	u64 rot_clk, rot_need_clk;
-	u32 aclk_x_1k_ns, dpu_lat_t_ns, max_lat_t_ns, tx_allow_t_ns;
-	u32 bus_perf;
-	u32 temp_clk;
-	bool retry_flag = false;
-
-	DPU_DEBUG_BTS("[ROT+] BEFORE latency check: %u KHz\n", aclk_base);
-
-	dfs_idx = dpu_bts_find_nearest_high_freq(decon, aclk_base);
-	rot_clk = decon->bts.dfs_lv_khz[dfs_idx];
-
-	/* post DECON OUTFIFO based on 1H transfer */
-	dsi_cycle = decon->config.image_width;
-
-	/* get additional pipeline latency */
-	if (is_comp) {
-		comp_cycle = dpu_bts_comp_latency(src_w, ppc,
-			decon->bts.delay_comp);
-		DPU_DEBUG_BTS("  COMP: lat_cycle(%u)\n", comp_cycle);
-		module_cycle += comp_cycle;
-	} else {
-		rot_cycle = dpu_bts_rotate_latency(src_w,
-			decon->bts.ppc_rotator);
-		DPU_DEBUG_BTS("  ROT: lat_cycle(%u)\n", rot_cycle);
-		module_cycle += rot_cycle;
-	}
-	if (is_downscale) {
-		scale_cycle = dpu_bts_scale_latency(src_w, dst_w,
-			decon->bts.ppc_scaler, decon->bts.delay_scaler);
-		DPU_DEBUG_BTS("  SCALE: lat_cycle(%u)\n", scale_cycle);
-		module_cycle += scale_cycle;
-	}
-	if (is_dsc) {
-		dsc_cycle = dpu_bts_dsc_latency(decon->config.dsc.slice_count,
-			decon->config.dsc.dsc_count, dst_w, ppc);
-		DPU_DEBUG_BTS("  DSC: lat_cycle(%u)\n", dsc_cycle);
-		module_cycle += dsc_cycle;
-		dsi_cycle = (dsi_cycle + 2) / 3;
-	}
-
-	/*
-	 * basic cycle(+ bubble: 10%) + additional cycle based on function
-	 * cycle count increases when ACLK goes up due to other conditions
-	 * At latency monitor experiment using unit test,
-	 *  cycles at 400Mhz were increased by about 800 compared to 200Mhz.
-	 * Here, (aclk_mhz * 2) cycles are reflected referring to the result
-	 *  because the exact value is unknown.
-	 */
-	basic_cycle = (decon->config.image_width * 11 / 10 + dsi_cycle) / ppc;
-
-retry_hi_freq:
-	dpu_cycle = (basic_cycle + module_cycle) + rot_clk * 2 / 1000U;
-	aclk_x_1k_ns = dpu_bts_convert_aclk_to_ns(rot_clk / 1000U);
-	dpu_lat_t_ns = mult_frac(aclk_x_1k_ns, dpu_cycle, 1000);
-	max_lat_t_ns = dpu_bts_get_vblank_time_ns(decon);
-	if (max_lat_t_ns > dpu_lat_t_ns) {
-		tx_allow_t_ns = max_lat_t_ns - dpu_lat_t_ns;
-	} else {
-		/* abnormal case : apply bus_util_pct of v_blank */
-		tx_allow_t_ns = (max_lat_t_ns * decon->bts.bus_util_pct) / 100;
-		DPU_DEBUG_BTS("  WARN: latency calc is abnormal!(-> %u%%)\n",
-				decon->bts.bus_util_pct);
-	}
-
-	bus_perf = decon->bts.bus_width * decon->bts.rot_util_pct;
-	/* apply as worst(P010: 3) case to simplify */
-	rot_init_bw = mult_frac(NSEC_PER_SEC, src_w * ROT_READ_BYTE * 3, tx_allow_t_ns) / 1000;
-	rot_need_clk = rot_init_bw * 100 / bus_perf;
-
-	if (rot_need_clk > rot_clk) {
-		/* not max level */
-		if (dfs_idx) {
-			/* check if calc_clk is greater than 1-step */
-			dfs_idx--;
-			temp_clk = decon->bts.dfs_lv_khz[dfs_idx];
-			if ((rot_need_clk > temp_clk) && (!retry_flag)) {
-				DPU_DEBUG_BTS("  -allow_ns(%u) dpu_ns(%u)\n",
-					tx_allow_t_ns, dpu_lat_t_ns);
-				rot_clk = temp_clk;
-				retry_flag = true;
-				goto retry_hi_freq;
-			}
-		}
-		rot_clk = rot_need_clk;
-	}
-
-	DPU_DEBUG_BTS("  -dpu_cycle(%u) aclk_x_1k_ns(%u) dpu_lat_t_ns(%u)\n",
-			dpu_cycle, aclk_x_1k_ns, dpu_lat_t_ns);
-	DPU_DEBUG_BTS("  -tx_allow_t_ns(%u) rot_init_bw(%u) rot_need_clk(%llu)\n",
-			tx_allow_t_ns, rot_init_bw, rot_need_clk);
-	DPU_DEBUG_BTS("[ROT-] AFTER latency check: %llu KHz\n", rot_clk);
-
-	return rot_clk;
-}
-
-static u64 dpu_bts_calc_aclk_disp(struct decon_device *decon,
-				  const struct dpu_bts_win_config *config, u64 resol_clk,
-				  u32 max_clk)
+static void dpu_bts_calc_bw(struct decon_device *decon)
 {
-	u64 aclk_disp, aclk_base, aclk_disp_khz;
-	u32 ppc;
-	u32 src_w, src_h;
-	u32 diff_w, ratio_v;
-	u32 is_downscale = false;
-	u32 is_dsc = false;
-	u64 margin;
-
-	if (config->is_rot) {
-		src_w = config->src_h;
-		src_h = config->src_w;
-	} else {
-		src_w = config->src_w;
-		src_h = config->src_h;
-	}
-
-	if (src_w > config->dst_w || src_h > config->dst_h)
-		is_downscale = true;
+	struct dpu_bts_cache *cache = &decon->bts.cache;
+	const struct dpu_bts_cache_entry *entry;
+	struct dpu_bts_cache_key key;
+	struct dpu_bts_result res;
+	u32 hash;
 
-	/* case for using dsc encoder 1ea at decon0 or decon1 */
-	if ((decon->id != 2) && (decon->config.dsc.dsc_count == 1))
-		ppc = ((decon->bts.ppc / 2UL) >= 1UL) ?
-				(decon->bts.ppc / 2UL) : 1UL;
-	else
-		ppc = decon->bts.ppc;
+	if (!decon->bts.enabled)
+		return;
 
-	margin = 1100 + ((48000 + 20000) / decon->config.image_width);
-	diff_w = (src_w <= config->dst_w) ? 0 : src_w - config->dst_w;
+	mutex_lock(&dpu_bts_lock);
 
-	if (src_h > config->dst_h) {
-		u32 ratio_a, line_a, line_b;
+	/* the key is hashed and compared as a whole, padding included */
+	memset(&key, 0, sizeof(key));
+	dpu_bts_get_disp_info(decon, &key.disp);
+	dpu_bts_get_frame(decon, &key.frame);
+	hash = jhash(&key, sizeof(key), 0);
 
-		ratio_v = DIV_ROUND_UP(src_h, config->dst_h);
-		ratio_a = (ratio_v * 1000) - mult_frac(src_h, 1000, config->dst_h);
-		line_a = max((ratio_v - 2) * src_w + max(src_w, config->dst_w),
-				decon->config.image_width + diff_w);
-		line_b = max((ratio_v - 1) * src_w + max(src_w, config->dst_w),
-				decon->config.image_width + diff_w);
-		aclk_disp = (u64)(line_a * ratio_a + line_b * (1000 - ratio_a));
+	entry = dpu_bts_cache_lookup(cache, &key, hash);
+	if (entry) {
+		cache->hits++;
+		DPU_DEBUG_BTS("%s: DECON%u cache hit\n", __func__, decon->id);
+		dpu_bts_apply_result(decon, &entry->res);
 	} else {
-		ratio_v = (src_h >= config->dst_h) ? 1000 : mult_frac(src_h, 1000, config->dst_h);
-		aclk_disp = (u64)((decon->config.image_width + diff_w) *
-			ratio_v + decon->config.image_width * (1000 - ratio_v));
+		cache->misses++;
+		dpu_bts_calc(&decon->bts.params, &key.disp, &key.frame, &res);
+		dpu_bts_cache_store(cache, &key, hash, &res);
+		dpu_bts_apply_result(decon, &res);
 	}
-	aclk_disp = mult_frac(aclk_disp, decon->config.image_height * decon->bts.fps, 1000);
-	aclk_disp_khz = (aclk_disp * margin / 1000) / 1000;
-
-	if (aclk_disp_khz < resol_clk)
-		aclk_disp_khz = resol_clk;
-	aclk_disp_khz /= ppc;
 
-	if (!config->is_rot)
-		return aclk_disp_khz;
-
-	/* rotation case: check if latency conditions are met */
-	if (aclk_disp_khz > max_clk)
-		aclk_base = aclk_disp_khz;
-	else
-		aclk_base = max_clk;
-
-	if (decon->config.dsc.enabled)
-		is_dsc = true;
-
-	aclk_disp_khz = dpu_bts_calc_rotate_aclk(decon, (u32)aclk_base, ppc,
-			src_w, config->dst_w, config->is_comp, is_downscale, is_dsc);
+	DPU_EVENT_LOG(DPU_EVT_BTS_CALC_BW, decon->id, NULL);
 
-	return aclk_disp_khz;
+	mutex_unlock(&dpu_bts_lock);
 }
 
-static void dpu_bts_sum_all_decon_bw(u32 id, u32 *max_overlap_bw, u32 *max_disp_ch_bw)
+static inline void dpu_bts_update_bw(struct decon_device *decon, struct bts_bw bw)
 {
-	int i, j;
-	struct decon_device *decon;
-	u32 overlap_bw = 0, disp_ch_bw[MAX_AXI_PORT] = { 0 };
-
-	if (id < 0 || id >= MAX_DECON_CNT) {
-		DPU_ERR_BTS("[%s] undefined decon id(%u)!\n", __func__, id);
-		*max_overlap_bw = 0;
-		*max_disp_ch_bw = 0;
-		return;
-	}
-
-	for (i = 0; i < MAX_DECON_CNT; i++) {
-		decon = get_decon_drvdata(i);
-		if (decon == NULL)
-			continue;
-
-		if (decon->bts.rt_avg_bw) {
-			overlap_bw += decon->bts.rt_avg_bw;
-			if (decon->id != id)
-				DPU_DEBUG_BTS("    add DECON%d Overlap BW = %u\n",
-					i, decon->bts.rt_avg_bw);
-		}
+	int ret;
 
-		for (j = 0; j < MAX_AXI_PORT; j++) {
-			if (decon->bts.ch_bw[j]) {
-				disp_ch_bw[j] += decon->bts.ch_bw[j];
-				if (decon->id != id)
-					DPU_DEBUG_BTS("    add DECON%d AXI_DPU%d = %u\n",
-						i, j, decon->bts.ch_bw[j]);
-			}
-		}
+	DPU_ATRACE_BEGIN("dpu_bts_update_bw");
+	ret = bts_update_bw(decon->bts.bw_idx, bw);
+	if (ret < 0) {
+		pr_warn("decon%u failed to update bw(%d) to bts(%d)\n", decon->id,
+			decon->bts.bw_idx, ret);
+		decon_dump_event_condition(decon, DPU_EVT_CONDITION_FAIL_UPDATE_BW);
 	}
-
-	*max_overlap_bw = overlap_bw;
-	*max_disp_ch_bw = disp_ch_bw[0];
-	for (i = 1; i < MAX_AXI_PORT; i++)
-		*max_disp_ch_bw = max(*max_disp_ch_bw, disp_ch_bw[i]);
-
-	DPU_DEBUG_BTS("  Max Overlap BW = %u, Max AXI_DPU = %u\n",
-		*max_overlap_bw, *max_disp_ch_bw);
+	DPU_ATRACE_INT("dpu_vote_peak_bw", bw.peak);
+	DPU_ATRACE_INT("dpu_vote_avg_bw", bw.read + bw.write);
+	DPU_ATRACE_INT("dpu_vote_rt_bw", bw.rt);
+	DPU_ATRACE_END("dpu_bts_update_bw");
 }
 
-static u32 dpu_bts_calc_disp_with_full_size(struct decon_device *decon)
+static inline void dpu_bts_update_disp(struct decon_device *decon, u32 disp_freq)
 {
-	struct dpu_bts_win_config config;
-
-	memset(&config, 0, sizeof(struct dpu_bts_win_config));
-	config.src_w = config.dst_w = decon->config.image_width;
-	config.src_h = config.dst_h = decon->config.image_height;
-	config.format = DRM_FORMAT_ARGB8888;
-
-	decon->bts.resol_clk = dpu_bts_get_resol_clock(
-			decon->config.image_width,
-			decon->config.image_height, decon->bts.fps);
-
-	return dpu_bts_calc_aclk_disp(decon, &config, decon->bts.resol_clk,
-		decon->bts.resol_clk);
+	DPU_ATRACE_BEGIN("dpu_bts_update_disp");
+	exynos_pm_qos_update_request(&decon->bts.disp_qos, disp_freq);
+	DPU_ATRACE_INT("dpu_vote_clock", disp_freq);
+	DPU_ATRACE_END("dpu_bts_update_disp");
 }
 
-static bool is_win_half_covered(const struct dpu_bts_win_config *config0,
-				const struct dpu_bts_win_config *config1)
+static void dpu_bts_lower_resources(struct decon_device *decon,
+				    const struct bts_bw *bw, u32 disp_freq)
 {
-	u32 start_y0;
-	u32 start_y1, end_y1;
-
-	if (unlikely(!config0) || unlikely(!config1)) {
-		pr_err("win config is invalid\n");
-		return false;
-	}
-
-	if (config0 == config1)
-		return true;
-
-	start_y0 = config0->dst_y;
-	start_y1 = config1->dst_y;
-	end_y1 = config1->dst_y + config1->dst_h;
-
-	if (start_y0 >= start_y1 && start_y0 < end_y1)
-		return true;
-
-	return false;
+	if (bw->read + bw->write < decon->bts.prev_total_bw ||
+			bw->peak < decon->bts.prev_peak ||
+			bw->rt < decon->bts.prev_rt_avg_bw)
+		dpu_bts_update_bw(decon, *bw);
+
+	if (disp_freq < decon->bts.prev_max_disp_freq)
+		dpu_bts_update_disp(decon, disp_freq);
+
+	decon->bts.prev_total_bw = bw->read + bw->write;
+	decon->bts.prev_peak = bw->peak;
+	decon->bts.prev_rt_avg_bw = bw->rt;
+	decon->bts.prev_max_disp_freq = disp_freq;
 }
 
-static void dpu_bts_update_overlap_bw(struct decon_device *decon,
-				       const struct dpu_bts_win_config *win_config,
-				       const struct dpu_bts_win_config *rcd_config)
+/* called with vote_lock held */
+static void dpu_bts_raise_resources(struct decon_device *decon,
+				    const struct bts_bw *bw, u32 disp_freq)
 {
-	int i, j;
-	u32 win_max_overlap_bw = 0, rcd_max_overlap_bw = 0;
-
-	/* overlap rt bandwidth requirement */
-	/* TODO: take write rt bandwidth into account */
-	for (i = 0; i < decon->win_cnt; i++) {
-		u32 overlap_bw;
-
-		if (win_config[i].state != DPU_WIN_STATE_BUFFER)
-			continue;
-
-		overlap_bw = 0;
-		for (j = 0; j < decon->win_cnt; j++) {
-			if (win_config[j].state != DPU_WIN_STATE_BUFFER)
-				continue;
-
-			if (is_win_half_covered(&win_config[i], &win_config[j])) {
-				int dpp_ch = win_config[j].dpp_ch;
-
-				overlap_bw += decon->bts.rt_bw[dpp_ch].val;
-			}
-		}
-
-		if (rcd_config->state == DPU_WIN_STATE_BUFFER) {
-			int dpp_ch = win_config[i].dpp_ch;
-			int rcd_dpp_ch = rcd_config->dpp_ch;
-
-			if (is_win_half_covered(&win_config[i], rcd_config))
-				overlap_bw += decon->bts.rt_bw[rcd_dpp_ch].val;
-
-			if (is_win_half_covered(rcd_config, &win_config[i]))
-				rcd_max_overlap_bw += decon->bts.rt_bw[dpp_ch].val;
-		}
-
-		DPU_DEBUG_BTS("  Overlap BW%d = %u\n", i, overlap_bw);
-		win_max_overlap_bw = max(win_max_overlap_bw, overlap_bw);
+	const struct bts_bw *release_bw = &decon->bts.release_bw;
+
+	/* a pending release to an older, lower snapshot would undercut this vote */
+	if (decon->bts.release_pending &&
+			(bw->read + bw->write > release_bw->read + release_bw->write ||
+			 bw->peak > release_bw->peak || bw->rt > release_bw->rt ||
+			 disp_freq > decon->bts.release_disp_freq)) {
+		decon->bts.release_pending = false;
+		cancel_delayed_work(&decon->bts.release_work);
 	}
 
-	if (rcd_config->state == DPU_WIN_STATE_BUFFER) {
-		int rcd_dpp_ch = rcd_config->dpp_ch;
+	if (bw->read + bw->write > decon->bts.prev_total_bw ||
+			bw->peak > decon->bts.prev_peak ||
+			bw->rt > decon->bts.prev_rt_avg_bw)
+		dpu_bts_update_bw(decon, *bw);
 
-		rcd_max_overlap_bw += decon->bts.rt_bw[rcd_dpp_ch].val;
-	}
-
-	decon->bts.rt_avg_bw = max(win_max_overlap_bw, rcd_max_overlap_bw);
+	if (disp_freq > decon->bts.prev_max_disp_freq)
+		dpu_bts_update_disp(decon, disp_freq);
 }
 
-static void dpu_bts_update_disp_ch_bw(struct decon_device *decon,
-				       const struct dpu_bts_win_config *win_config,
-				       const struct dpu_bts_win_config *rcd_config)
-{
-	int i, j;
-	u32 disp_ch_bw[MAX_AXI_PORT];
-	u32 rcd_overlap_ch_bw = 0;
-
-	/* DPU AXI bandwidth requirement */
-	/* TODO: take write rt bandwidth into account */
-	memset(disp_ch_bw, 0, sizeof(disp_ch_bw));
-	for (i = 0; i < decon->win_cnt; i++) {
-		int dpp_ch = win_config[i].dpp_ch;
-		u32 ch_num = decon->bts.rt_bw[dpp_ch].ch_num;
-		u32 overlap_ch_bw;
-
-		if (win_config[i].state != DPU_WIN_STATE_BUFFER)
-			continue;
+static void dpu_bts_flush_resources(struct decon_device *decon);
 
-		if (ch_num >= MAX_AXI_PORT) {
-			pr_err("invalid DPU AXI channel number %u\n", ch_num);
-			continue;
-		}
+static void dpu_bts_update_resources(struct decon_device *decon, bool shadow_updated)
+{
+	struct bts_bw bw = { 0 };
 
-		overlap_ch_bw = 0;
-		for (j = 0; j < decon->win_cnt; j++) {
-			int dpp_ch = win_config[j].dpp_ch;
+	DPU_DEBUG_BTS("%s +\n", __func__);
 
-			if (win_config[j].state != DPU_WIN_STATE_BUFFER)
-				continue;
+	if (!decon->bts.enabled)
+		return;
 
-			if (ch_num == decon->bts.rt_bw[dpp_ch].ch_num &&
-				(is_win_half_covered(&win_config[i], &win_config[j])))
-				overlap_ch_bw += decon->bts.rt_bw[dpp_ch].val;
-		}
+	/* raise vote scheduled for this frame must not land after the lower one */
+	if (shadow_updated)
+		dpu_bts_flush_resources(decon);
 
-		if (rcd_config->state == DPU_WIN_STATE_BUFFER) {
-			int rcd_dpp_ch = rcd_config->dpp_ch;
+	mutex_lock(&decon->bts.vote_lock);
 
-			if (ch_num == decon->bts.rt_bw[rcd_dpp_ch].ch_num) {
-				if (is_win_half_covered(&win_config[i], rcd_config))
-					overlap_ch_bw += decon->bts.rt_bw[rcd_dpp_ch].val;
+	/* update peak & R/W bandwidth per DPU port */
+	bw.peak = decon->bts.peak;
+	bw.rt = decon->bts.rt_avg_bw;
+	bw.read = decon->bts.read_bw;
+	bw.write = decon->bts.write_bw;
+	DPU_DEBUG_BTS("  peak = %u, rt = %u, read = %u, write = %u\n",
+		bw.peak, bw.rt, bw.read, bw.write);
 
-				if (is_win_half_covered(rcd_config, &win_config[i]))
-					rcd_overlap_ch_bw += decon->bts.rt_bw[dpp_ch].val;
+	if (shadow_updated) {
+		/* after DECON h/w configs are updated to shadow SFR */
+		const bool lower = decon->bts.total_bw < decon->bts.prev_total_bw ||
+				decon->bts.peak < decon->bts.prev_peak ||
+				decon->bts.rt_avg_bw < decon->bts.prev_rt_avg_bw ||
+				decon->bts.max_disp_freq < decon->bts.prev_max_disp_freq;
+
+		if (lower && decon->bts.release_hysteresis_ms) {
+			/*
+			 * keep the current vote for a while, next frames are likely to
+			 * need it again. Always release to the latest requirement.
+			 */
+			decon->bts.release_bw = bw;
+			decon->bts.release_disp_freq = decon->bts.max_disp_freq;
+			if (!decon->bts.release_pending) {
+				decon->bts.release_pending = true;
+				schedule_delayed_work(&decon->bts.release_work,
+					msecs_to_jiffies(decon->bts.release_hysteresis_ms));
 			}
+		} else {
+			decon->bts.release_pending = false;
+			dpu_bts_lower_resources(decon, &bw, decon->bts.max_disp_freq);
 		}
-		disp_ch_bw[ch_num] = max(disp_ch_bw[ch_num], overlap_ch_bw);
+	} else {
+		dpu_bts_raise_resources(decon, &bw, decon->bts.max_disp_freq);
 	}
 
-	if (rcd_config->state == DPU_WIN_STATE_BUFFER) {
-		int rcd_dpp_ch = rcd_config->dpp_ch;
-		u32 rcd_ch_num = decon->bts.rt_bw[rcd_dpp_ch].ch_num;
+	mutex_unlock(&decon->bts.vote_lock);
 
-		if (rcd_ch_num >= MAX_AXI_PORT) {
-			pr_err("invalid RCD AXI channel number %u\n", rcd_ch_num);
-		} else {
-			rcd_overlap_ch_bw += decon->bts.rt_bw[rcd_dpp_ch].val;
-			disp_ch_bw[rcd_ch_num] = max(disp_ch_bw[rcd_ch_num], rcd_overlap_ch_bw);
-		}
-	}
+	DPU_EVENT_LOG(DPU_EVT_BTS_UPDATE_BW, decon->id, NULL);
 
-	for (i = 0; i < MAX_AXI_PORT; ++i) {
-		decon->bts.ch_bw[i] = disp_ch_bw[i];
-		if (decon->bts.ch_bw[i])
-			DPU_DEBUG_BTS("  AXI_DPU%d = %u\n", i, decon->bts.ch_bw[i]);
-	}
+	DPU_DEBUG_BTS("%s -\n", __func__);
 }
 
-static void dpu_bts_find_max_disp_freq(struct decon_device *decon)
+static void dpu_bts_release_work(struct work_struct *work)
 {
-	int i;
-	u32 max_overlap_bw;
-	u32 max_disp_ch_bw;
-	u32 disp_op_freq = 0;
-	const struct dpu_bts_win_config *win_config = decon->bts.win_config;
-	const struct dpu_bts_win_config *rcd_config = &decon->bts.rcd_win_config.win;
-
-	dpu_bts_update_overlap_bw(decon, win_config, rcd_config);
-	dpu_bts_update_disp_ch_bw(decon, win_config, rcd_config);
-	dpu_bts_sum_all_decon_bw(decon->id, &max_overlap_bw, &max_disp_ch_bw);
-
-	decon->bts.max_disp_freq = max_disp_ch_bw * 100 /
-			(decon->bts.bus_width * decon->bts.bus_util_pct);
-
-	/* TODO: the final INT should be max(max_peak_bw, total_peak_bw / NUM_DRAM_CH). It nees
-	 * some changes in bts driver to allow client request peak_bw. Before we lock down the
-	 * design, DPU requests max(max_ch_bw, max_overlap_bw / NUM_INTERCONNECT_CH) as peak.
-	 * After we take write bw into account, we don't need to check write bw here.
-	 */
-	decon->bts.peak = max3(max_disp_ch_bw, max_overlap_bw / NUM_INTERCONNECT_CH,
-				decon->bts.write_bw);
-
-	for (i = 0; i < decon->win_cnt; ++i) {
-		u32 freq;
-
-		if ((win_config[i].state != DPU_WIN_STATE_BUFFER) &&
-				(win_config[i].state != DPU_WIN_STATE_COLOR))
-			continue;
-
-		freq = dpu_bts_calc_aclk_disp(decon, &win_config[i],
-				(u64)decon->bts.resol_clk, decon->bts.max_disp_freq);
-		disp_op_freq = max(disp_op_freq, freq);
+	struct decon_device *decon = container_of(to_delayed_work(work),
+			struct decon_device, bts.release_work);
+
+	mutex_lock(&decon->bts.vote_lock);
+	if (decon->bts.release_pending) {
+		decon->bts.release_pending = false;
+		dpu_bts_lower_resources(decon, &decon->bts.release_bw,
+				decon->bts.release_disp_freq);
+		DPU_EVENT_LOG(DPU_EVT_BTS_UPDATE_BW, decon->id, NULL);
 	}
-
-	/*
-	 * At least one window is used for colormap if there is a request of
-	 * disabling all windows. So, disp frequency for a window of LCD full
-	 * size is necessary.
-	 */
-	if (disp_op_freq == 0)
-		disp_op_freq = dpu_bts_calc_disp_with_full_size(decon);
-
-	DPU_DEBUG_BTS("  DISP bus freq(%u), operating freq(%u)\n",
-			decon->bts.max_disp_freq, disp_op_freq);
-
-	decon->bts.max_disp_freq = max(decon->bts.max_disp_freq, disp_op_freq);
-
-	DPU_DEBUG_BTS("  MAX DISP CH FREQ = %u\n", decon->bts.max_disp_freq);
+	mutex_unlock(&decon->bts.vote_lock);
 }
 
-static void
-dpu_bts_calc_dpp_bw(struct bts_dpp_info *dpp, u32 fps, u32 lcd_h, u32 vblank_us, int idx,
-		const struct dpu_bts *bts)
+/* votes the bandwidth snapshot taken when the raise vote was scheduled */
+static void dpu_bts_pre_vote(struct decon_device *decon)
 {
-	u32 avg_bw, rt_bw, rot_bw = 0;
-	u32 src_w = dpp->src_w;
-	u32 src_h = dpp->src_h;
-	u32 dst_h = dpp->dst.y2 - dpp->dst.y1;
-	u32 bpp = dpp->bpp;
-
-	/* Bandwidth requirement for layer
-	 * - AVG BW (KB) : sw * sh * fps * (bpp / 8) / 1000
-	 * - RT BW (KB) : AVG_BW * panel_h / dh * 1.1
-	 */
-	avg_bw = src_w * src_h * bpp / 8 * fps / 1000;
-	rt_bw = mult_frac(avg_bw, lcd_h * 11, dst_h * 10);
+	mutex_lock(&decon->bts.vote_lock);
+	dpu_bts_raise_resources(decon, &decon->bts.pre_vote_bw,
+				decon->bts.pre_vote_disp_freq);
+	mutex_unlock(&decon->bts.vote_lock);
 
-	if (dpp->rotation) {
-		/* ROT BW(KB) : sh * 32B * (bpp / 8) / v_blank */
-		rot_bw = mult_frac(src_h * ROT_READ_BYTE * bpp / 8,
-				USEC_PER_SEC, vblank_us) / 1000;
-	}
-
-	DPU_DEBUG_BTS("  DPP%d bandwidth: avg %u, rt %u, rot %u\n", idx, avg_bw, rt_bw, rot_bw);
-
-	rt_bw = max(rt_bw, rot_bw);
-	if (dpp->is_afbc) {
-		u32 afbc_util_pct, afbc_rt_util_pct;
-
-		if (dpp->is_yuv) {
-			afbc_util_pct = bts->afbc_yuv_util_pct;
-			afbc_rt_util_pct = bts->afbc_yuv_rt_util_pct;
-		} else {
-			afbc_util_pct = bts->afbc_rgb_util_pct;
-			afbc_rt_util_pct = bts->afbc_rgb_rt_util_pct;
-		}
-
-		avg_bw = mult_frac(avg_bw, afbc_util_pct, 100);
-		rt_bw = mult_frac(rt_bw, afbc_rt_util_pct, 100);
-	}
-
-	dpp->bw = avg_bw;
-	dpp->rt_bw = rt_bw;
-	DPU_DEBUG_BTS("           final: avg %u, rt %u\n", dpp->bw, dpp->rt_bw);
+	DPU_EVENT_LOG(DPU_EVT_BTS_UPDATE_BW, decon->id, NULL);
 }
 
-static void dpu_bts_convert_config_to_info(struct bts_dpp_info *dpp,
-				const struct dpu_bts_win_config *config)
+static void dpu_bts_pre_vote_work(struct work_struct *work)
 {
-	const struct dpu_fmt *fmt_info;
-
-	fmt_info = dpu_find_fmt_info(config->format);
-	dpp->bpp = fmt_info->bpp + fmt_info->padding;
-	dpp->src_w = config->src_w;
-	dpp->src_h = config->src_h;
-	dpp->dst.x1 = config->dst_x;
-	dpp->dst.x2 = config->dst_x + config->dst_w;
-	dpp->dst.y1 = config->dst_y;
-	dpp->dst.y2 = config->dst_y + config->dst_h;
-	dpp->rotation = config->is_rot;
-	dpp->is_afbc = config->is_comp;
-	dpp->is_yuv = IS_YUV(fmt_info);
-
-	DPU_DEBUG_BTS("  DPP%d : bpp(%u) src w(%u) h(%u) rot(%d) afbc(%d) yuv(%d)\n",
-			DPU_DMA2CH(config->dpp_ch), dpp->bpp, dpp->src_w,
-			dpp->src_h, dpp->rotation, dpp->is_afbc, dpp->is_yuv);
-	DPU_DEBUG_BTS("        dst x(%u) right(%u) y(%u) bottom(%u)\n",
-			dpp->dst.x1, dpp->dst.x2, dpp->dst.y1, dpp->dst.y2);
+	struct decon_device *decon = container_of(work, struct decon_device,
+			bts.pre_vote_work);
+
+	DPU_ATRACE_BEGIN("dpu_bts_pre_vote");
+	dpu_bts_pre_vote(decon);
+	DPU_ATRACE_END("dpu_bts_pre_vote");
 }
 
-static void dpu_bts_calc_bw(struct decon_device *decon)
+static enum hrtimer_restart dpu_bts_pre_vote_timer(struct hrtimer *timer)
 {
-	struct dpu_bts_win_config *config;
-	struct bts_decon_info bts_info;
-	int idx, i, wb_idx = -1, rcd_idx = -1;
-	u32 read_bw = 0, write_bw;
-	u64 resol_clock;
-	u32 vblank_us;
-
-	if (!decon->bts.enabled)
-		return;
-
-	DPU_DEBUG_BTS("%s + : DECON%u\n", __func__, decon->id);
-
-	memset(&bts_info, 0, sizeof(struct bts_decon_info));
-
-	resol_clock = dpu_bts_get_resol_clock(decon->config.image_width,
-				decon->config.image_height, decon->bts.fps);
-	decon->bts.resol_clk = (u32)resol_clock;
-	DPU_DEBUG_BTS("[Run: D%u] resol clock = %u Khz @%u fps\n",
-		decon->id, decon->bts.resol_clk, decon->bts.fps);
-
-	bts_info.vclk = decon->bts.resol_clk;
-	bts_info.lcd_w = decon->config.image_width;
-	bts_info.lcd_h = decon->config.image_height;
-	vblank_us = dpu_bts_get_vblank_time_ns(decon) / 1000U;
-	/* reflect bus_util_pct for dpu processing latency when rotation */
-	vblank_us = (vblank_us * decon->bts.rot_util_pct) / 100;
-
-	/* read bw calculation */
-	config = decon->bts.win_config;
-	for (i = 0; i < decon->win_cnt; ++i) {
-		if (config[i].state != DPU_WIN_STATE_BUFFER)
-			continue;
-
-		idx = config[i].dpp_ch;
-		dpu_bts_convert_config_to_info(&bts_info.rdma[idx], &config[i]);
-		dpu_bts_calc_dpp_bw(&bts_info.rdma[idx], decon->bts.fps,
-				decon->config.image_height, vblank_us, idx, &decon->bts);
-		read_bw += bts_info.rdma[idx].bw;
-	}
-
-	/* write bw calculation */
-	config = &decon->bts.wb_config;
-	if (config->state == DPU_WIN_STATE_BUFFER) {
-		wb_idx = config->dpp_ch;
-		dpu_bts_convert_config_to_info(&bts_info.odma, config);
-		dpu_bts_calc_dpp_bw(&bts_info.odma, decon->bts.fps, bts_info.lcd_h,
-				vblank_us, wb_idx, &decon->bts);
-		write_bw = bts_info.odma.bw;
-	} else {
-		wb_idx = -1;
-		write_bw = 0;
-	}
-
-	/* rcd bw calculation */
-	config = &decon->bts.rcd_win_config.win;
-	if (config->state == DPU_WIN_STATE_BUFFER) {
-		rcd_idx = config->dpp_ch;
-		dpu_bts_convert_config_to_info(&bts_info.rcddma, config);
-		dpu_bts_calc_dpp_bw(&bts_info.rcddma, decon->bts.fps, bts_info.lcd_h,
-				vblank_us, rcd_idx, &decon->bts);
-		read_bw += bts_info.rcddma.bw;
-	} else {
-		rcd_idx = -1;
-	}
+	struct decon_device *decon = container_of(timer, struct decon_device,
+			bts.pre_vote_timer);
 
+	/* votes may sleep, issue them from process context */
+	queue_work(system_highpri_wq, &decon->bts.pre_vote_work);
 
-	for (i = 0; i < MAX_DPP_CNT; i++) {
-		if (i < MAX_WIN_PER_DECON)
-			decon->bts.rt_bw[i].val = bts_info.rdma[i].rt_bw;
-		else if (i == wb_idx)
-			decon->bts.rt_bw[i].val = bts_info.odma.rt_bw;
-		else if (i == rcd_idx)
-			decon->bts.rt_bw[i].val = bts_info.rcddma.rt_bw;
-		else
-			decon->bts.rt_bw[i].val = 0;
-	}
-
-	decon->bts.read_bw = read_bw;
-	decon->bts.write_bw = write_bw;
-	decon->bts.total_bw = read_bw + write_bw;
-
-	DPU_DEBUG_BTS("  DECON%u total bw = %u, read bw = %u, write bw = %u\n",
-			decon->id, decon->bts.total_bw, decon->bts.read_bw,
-			decon->bts.write_bw);
-
-	if (decon->bts.total_bw) {
-		dpu_bts_find_max_disp_freq(decon);
-	} else {
-		/* no bw requirement */
-		decon->bts.peak = 0;
-		decon->bts.rt_avg_bw = 0;
-		decon->bts.max_disp_freq = dpu_bts_calc_disp_with_full_size(decon);
-	}
-
-	DPU_EVENT_LOG(DPU_EVT_BTS_CALC_BW, decon->id, NULL);
-	DPU_DEBUG_BTS("%s -\n", __func__);
+	return HRTIMER_NORESTART;
 }
 
-static inline void dpu_bts_update_bw(struct decon_device *decon, struct bts_bw bw)
+/*
+ * Raise the vote one DVFS latency ahead of the time the frame is processed
+ * instead of right away, so that the new level is reached in time without
+ * holding it while the previous frame is still being displayed.
+ */
+static void dpu_bts_schedule_resources(struct decon_device *decon, ktime_t process_time)
 {
-	int ret;
+	ktime_t vote_time;
 
-	DPU_ATRACE_BEGIN("dpu_bts_update_bw");
-	ret = bts_update_bw(decon->bts.bw_idx, bw);
-	if (ret < 0) {
-		pr_warn("decon%u failed to update bw(%d) to bts(%d)\n", decon->id,
-			decon->bts.bw_idx, ret);
-		decon_dump_event_condition(decon, DPU_EVT_CONDITION_FAIL_UPDATE_BW);
+	if (!decon->bts.enabled)
+		return;
+
+	vote_time = ktime_sub_us(process_time, decon->bts.dvfs_latency_us);
+	if (!ktime_after(vote_time, ktime_get())) {
+		dpu_bts_update_resources(decon, false);
+		return;
 	}
-	DPU_ATRACE_INT("dpu_vote_peak_bw", bw.peak);
-	DPU_ATRACE_INT("dpu_vote_avg_bw", bw.read + bw.write);
-	DPU_ATRACE_INT("dpu_vote_rt_bw", bw.rt);
-	DPU_ATRACE_END("dpu_bts_update_bw");
-}
 
-static inline void dpu_bts_update_disp(struct decon_device *decon, u32 disp_freq)
-{
-	DPU_ATRACE_BEGIN("dpu_bts_update_disp");
-	exynos_pm_qos_update_request(&decon->bts.disp_qos, disp_freq);
-	DPU_ATRACE_INT("dpu_vote_clock", disp_freq);
-	DPU_ATRACE_END("dpu_bts_update_disp");
+	/*
+	 * the next commit recalculates decon->bts before this vote may have run,
+	 * vote on a copy of what this frame needs. A vote still scheduled for the
+	 * previous frame is issued first.
+	 */
+	dpu_bts_flush_resources(decon);
+	mutex_lock(&decon->bts.vote_lock);
+	decon->bts.pre_vote_bw.peak = decon->bts.peak;
+	decon->bts.pre_vote_bw.rt = decon->bts.rt_avg_bw;
+	decon->bts.pre_vote_bw.read = decon->bts.read_bw;
+	decon->bts.pre_vote_bw.write = decon->bts.write_bw;
+	decon->bts.pre_vote_disp_freq = decon->bts.max_disp_freq;
+	mutex_unlock(&decon->bts.vote_lock);
+
+	DPU_DEBUG_BTS("decon%u: raise vote scheduled in %lld us\n", decon->id,
+			ktime_us_delta(vote_time, ktime_get()));
+	hrtimer_start(&decon->bts.pre_vote_timer, vote_time, HRTIMER_MODE_ABS);
 }
 
-static void dpu_bts_update_resources(struct decon_device *decon, bool shadow_updated)
+/* make sure the scheduled raise vote is in place before the frame is processed */
+static void dpu_bts_flush_resources(struct decon_device *decon)
 {
-	struct bts_bw bw = { 0 };
-
-	DPU_DEBUG_BTS("%s +\n", __func__);
-
 	if (!decon->bts.enabled)
 		return;
 
-	/* update peak & R/W bandwidth per DPU port */
-	bw.peak = decon->bts.peak;
-	bw.rt = decon->bts.rt_avg_bw;
-	bw.read = decon->bts.read_bw;
-	bw.write = decon->bts.write_bw;
-	DPU_DEBUG_BTS("  peak = %u, rt = %u, read = %u, write = %u\n",
-		bw.peak, bw.rt, bw.read, bw.write);
-
-	if (shadow_updated) {
-		/* after DECON h/w configs are updated to shadow SFR */
-		if (decon->bts.total_bw < decon->bts.prev_total_bw ||
-				decon->bts.peak < decon->bts.prev_peak ||
-				decon->bts.rt_avg_bw < decon->bts.prev_rt_avg_bw)
-			dpu_bts_update_bw(decon, bw);
-
-		if (decon->bts.max_disp_freq < decon->bts.prev_max_disp_freq)
-			dpu_bts_update_disp(decon, decon->bts.max_disp_freq);
-
-		decon->bts.prev_total_bw = decon->bts.total_bw;
-		decon->bts.prev_peak = decon->bts.peak;
-		decon->bts.prev_rt_avg_bw = decon->bts.rt_avg_bw;
-		decon->bts.prev_max_disp_freq = decon->bts.max_disp_freq;
-	} else {
-		if (decon->bts.total_bw > decon->bts.prev_total_bw ||
-				decon->bts.peak > decon->bts.prev_peak ||
-				decon->bts.rt_avg_bw > decon->bts.prev_rt_avg_bw)
-			dpu_bts_update_bw(decon, bw);
-
-		if (decon->bts.max_disp_freq > decon->bts.prev_max_disp_freq)
-			dpu_bts_update_disp(decon, decon->bts.max_disp_freq);
-	}
-
-	DPU_EVENT_LOG(DPU_EVT_BTS_UPDATE_BW, decon->id, NULL);
+	if (hrtimer_cancel(&decon->bts.pre_vote_timer))
+		dpu_bts_pre_vote(decon);
+	else
+		flush_work(&decon->bts.pre_vote_work);
+}
 
-	DPU_DEBUG_BTS("%s -\n", __func__);
+static void dpu_bts_cancel_scheduled(struct decon_device *decon)
+{
+	hrtimer_cancel(&decon->bts.pre_vote_timer);
+	cancel_work_sync(&decon->bts.pre_vote_work);
+	cancel_delayed_work_sync(&decon->bts.release_work);
+	decon->bts.release_pending = false;
 }
 
 static void dpu_bts_release_resources(struct decon_device *decon)
@@ -919,16 +405,22 @@ static void dpu_bts_release_resources(struct decon_device *decon)
 	if (!decon->bts.enabled)
 		return;
 
+	dpu_bts_cancel_scheduled(decon);
+
+	mutex_lock(&decon->bts.vote_lock);
 	dpu_bts_update_bw(decon, bw);
 	decon->bts.prev_peak = 0;
 	decon->bts.prev_rt_avg_bw = 0;
 	decon->bts.prev_total_bw = 0;
 	dpu_bts_update_disp(decon, 0);
 	decon->bts.prev_max_disp_freq = 0;
+	mutex_unlock(&decon->bts.vote_lock);
 
 	// clear shared decon resources
+	mutex_lock(&dpu_bts_lock);
 	decon->bts.rt_avg_bw = 0;
 	memset(decon->bts.ch_bw, 0, sizeof(decon->bts.ch_bw));
+	mutex_unlock(&dpu_bts_lock);
 
 	DPU_EVENT_LOG(DPU_EVT_BTS_RELEASE_BW, decon->id, NULL);
 	DPU_DEBUG_BTS("%s -\n", __func__);
@@ -964,6 +456,8 @@ static void dpu_bts_init(struct decon_device *decon)
 	for (i = 0; i < MAX_AXI_PORT; i++)
 		decon->bts.ch_bw[i] = 0;
 
+	memset(&decon->bts.cache, 0, sizeof(decon->bts.cache));
+
 	DPU_DEBUG_BTS("BTS_BW_TYPE(%d)\n", decon->bts.bw_idx);
 	exynos_pm_qos_add_request(&decon->bts.mif_qos,
 					PM_QOS_BUS_THROUGHPUT, 0);
@@ -973,9 +467,9 @@ static void dpu_bts_init(struct decon_device *decon)
 					PM_QOS_DISPLAY_THROUGHPUT, 0);
 
 	for (i = 0; i < decon->dpp_cnt; ++i) { /* dma type order */
-		decon->bts.rt_bw[i].ch_num = decon->dpp[DPU_DMA2CH(i)]->port;
+		decon->bts.params.ch_num[i] = decon->dpp[DPU_DMA2CH(i)]->port;
 		DPU_INFO_BTS("IDMA_TYPE(%d) CH(%d) Port(%u)\n", i,
-				DPU_DMA2CH(i), decon->bts.rt_bw[i].ch_num);
+				DPU_DMA2CH(i), decon->bts.params.ch_num[i]);
 	}
 
 	drm_for_each_encoder(encoder, decon->drm_dev) {
@@ -983,11 +477,18 @@ static void dpu_bts_init(struct decon_device *decon)
 
 		if (encoder->encoder_type == DRM_MODE_ENCODER_VIRTUAL) {
 			wb = enc_to_wb_dev(encoder);
-			decon->bts.rt_bw[wb->id].ch_num = wb->port;
+			decon->bts.params.ch_num[wb->id] = wb->port;
 			break;
 		}
 	}
 
+	mutex_init(&decon->bts.vote_lock);
+	hrtimer_init(&decon->bts.pre_vote_timer, CLOCK_MONOTONIC, HRTIMER_MODE_ABS);
+	decon->bts.pre_vote_timer.function = dpu_bts_pre_vote_timer;
+	INIT_WORK(&decon->bts.pre_vote_work, dpu_bts_pre_vote_work);
+	INIT_DELAYED_WORK(&decon->bts.release_work, dpu_bts_release_work);
+	decon->bts.release_pending = false;
+
 	decon->bts.enabled = true;
 
 	DPU_INFO_BTS("decon%u bts feature is enabled\n", decon->id);
@@ -999,6 +500,7 @@ static void dpu_bts_deinit(struct decon_device *decon)
 		return;
 
 	DPU_DEBUG_BTS("%s +\n", __func__);
+	dpu_bts_cancel_scheduled(decon);
 	exynos_pm_qos_remove_request(&decon->bts.disp_qos);
 	exynos_pm_qos_remove_request(&decon->bts.int_qos);
 	exynos_pm_qos_remove_request(&decon->bts.mif_qos);
@@ -1009,6 +511,8 @@ struct dpu_bts_ops dpu_bts_control = {
 	.init		= dpu_bts_init,
 	.calc_bw	= dpu_bts_calc_bw,
 	.update_bw	= dpu_bts_update_resources,
+	.schedule_bw	= dpu_bts_schedule_resources,
+	.flush_bw	= dpu_bts_flush_resources,
 	.release_bw	= dpu_bts_release_resources,
 	.deinit		= dpu_bts_deinit,
 };
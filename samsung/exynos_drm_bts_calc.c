@@ -0,0 +1,788 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Copyright (c) 2016 Samsung Electronics Co., Ltd.
+ *		http://www.samsung.com
+ *
+ * BTS bandwidth and clock calculation for Samsung EXYNOS DPU driver
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ */
+
+#include <linux/kernel.h>
+#include <linux/sort.h>
+#include <linux/string.h>
+#include <linux/time.h>
+#include <drm/drm_fourcc.h>
+
+#include "exynos_drm_bts_calc.h"
+
+#define DISP_FACTOR_PCT		100UL
+#define MULTI_FACTOR		(1UL << 10)
+#define ROT_READ_BYTE		(32) /* unit : BYTE(= pixel, based on NV12) */
+
+#define ACLK_100MHZ_PERIOD	10000UL
+#define FRAME_TIME_NSEC		1000000000UL	/* 1sec */
+
+/* TODO: remove it after we move logic into bts driver */
+#define NUM_INTERCONNECT_CH		4
+
+/*
+ * 1. function clock
+ *    panel_clk = panel_w * panel_h * fps * margin / ppc
+ *    vertical scale-down case (src_h > dst_h)
+ *     clk[i] = (line_a * ratio_a + line_b * (1 - ratio_a)) *
+ *                  panel_h * fps * margin / ppc
+ *        - line_a = max((ratio_v - 2) * src_w + max(src_w, dst_w), panel_w + diff_w)
+ *        - line_b = max((ratio_v - 1) * src_w + max(src_w, dst_w), panel_w + diff_w)
+ *        - ratio_v = ceiling(src_h / dst_h)
+ *        - ratio_a = ratio_v - (src_h / dst_h)
+ *        - diff_w = (src_w <= dst_w) ? 0 : src_w - dst_w
+ *    non-vertical scale-down case
+ *     clk[i] = ((panel_w + diff_w) * ratio_v + panel_w * (1 - ratio_v)) *
+ *                  panel_h * fps * margin / ppc
+ *        - ratio_v = (src_h >= dst_h) ? 1 : src_h / dst_h
+ *        - diff_w = (src_w <= dst_w) ? 0 : src_w - dst_w
+ *    margin = 1.1 + HW bubble cycles
+ *    aclk1 = max(panel_clk, clk[i])
+ * 2. AXI throughput clock
+ *    1) fps based
+ *       clk_bw[i] = src_w * src_h * fps * (bpp / 8) * (panel_h / dst_h) * 1.1
+ *                       / (bus_width * bus_util_pct)
+ *    2) rotation throughput for initial latency
+ *       clk_r[i] = src_h * 32 * (bpp / 8) / (bus_width * rot_util_pct) / (v_blank)
+ *       # v_blank : command - TE_hi_pulse
+ *                   video - (vbp) @initial-frame, (vbp+vfp) @inter-frame
+ *    if (clk_bw[i] < clk_r[i])
+ *       clk_bw[i] = clk_r[i]
+ *    aclk2 = max(clk for sum(same axi overlap bw[i]))
+ *
+ * => aclk_dpu = max(aclk1, aclk2)
+ */
+
+/* unit : usec x 1000 -> 5592 (5.592us) for WQHD+ case */
+static inline u32 dpu_bts_get_one_line_time(u32 lcd_height, u32 vbp, u32 vfp,
+		u32 vsa, u32 fps)
+{
+	u32 tot_v;
+	int tmp;
+
+	tot_v = lcd_height + vfp + vsa + vbp;
+	tmp = DIV_ROUND_UP(FRAME_TIME_NSEC, fps);
+
+	return (tmp / tot_v);
+}
+
+/* framebuffer compressor(AFBC, SBWC) line delay is usually 4 */
+static inline u32 dpu_bts_comp_latency(u32 src_w, u32 ppc, u32 line_delay)
+{
+	return mult_frac(src_w, line_delay, ppc);
+}
+
+/* scaler line delay is usually 3
+ * scaling order : horizontal -> vertical scale
+ * -> need to reflect scale-ratio
+ */
+static inline u32 dpu_bts_scale_latency(u32 src_w, u32 dst_w, u32 ppc,
+				u32 line_delay)
+{
+	if (src_w > dst_w)
+		return mult_frac(src_w * line_delay, src_w, dst_w * ppc);
+	else
+		return DIV_ROUND_CLOSEST(src_w * line_delay, ppc);
+}
+
+/* rotator ppc is usually 4 or 8
+ * 1-read : 32BYTE (pixel)
+ */
+static inline u32 dpu_bts_rotate_latency(u32 src_w, u32 r_ppc)
+{
+	return (src_w * (ROT_READ_BYTE / r_ppc));
+}
+
+/*
+ * [DSC]
+ * Line memory is necessary like following.
+ *  1EA(1ppc) : 2-line for 2-slice, 1-line for 1-slice
+ *  2EA(2ppc) : 3.5-line for 4-slice (DSCC 0.5-line + DSC 3-line)
+ *        2.5-line for 2-slice (DSCC 0.5-line + DSC 2-line)
+ *
+ * [DECON] none
+ * When 1H is filled at OUT_FIFO, it immediately transfers to DSIM.
+ */
+static inline u32 dpu_bts_dsc_latency(u32 slice_num, u32 dsc_cnt,
+		u32 dst_w, u32 ppc)
+{
+	u32 lat_dsc = dst_w;
+
+	switch (slice_num) {
+	case 1:
+		/* DSC: 1EA */
+		lat_dsc = dst_w * 1;
+		break;
+	case 2:
+		if (dsc_cnt == 1)
+			lat_dsc = dst_w * 2;
+		else
+			lat_dsc = (dst_w * 25) / (10 * ppc);
+		break;
+	case 4:
+		/* DSC: 2EA */
+		lat_dsc = (dst_w * 35) / (10 * ppc);
+		break;
+	default:
+		break;
+	}
+
+	return lat_dsc;
+}
+
+/*
+ * unit : nsec x 1000
+ * reference aclk : 100MHz (-> 10ns x 1000)
+ * # cycles = usec * aclk_mhz
+ */
+static inline u32 dpu_bts_convert_aclk_to_ns(u32 aclk_mhz)
+{
+	return ((ACLK_100MHZ_PERIOD * 100) / aclk_mhz);
+}
+
+/*
+ * return : kHz value based on 1-pixel processing pipe-line
+ */
+static u64 dpu_bts_get_resol_clock(u32 xres, u32 yres, u32 fps)
+{
+	u64 margin;
+	u64 resol_khz;
+
+	/*
+	 * aclk_khz = vclk_1pix * ( 1.1 + (48+20)/WIDTH ) : x1000
+	 * @ (1.1)   : BUS Latency Considerable Margin (10%)
+	 * @ (48+20) : HW bubble cycles
+	 *      - 48 : 12 cycles per slice, total 4 slice
+	 *      - 20 : hblank cycles for other HW module
+	 */
+	margin = 1100 + ((48000 + 20000) / xres);
+	/* convert to kHz unit */
+	resol_khz = (xres * yres * fps * margin / 1000) / 1000;
+
+	return resol_khz;
+}
+
+static u32 dpu_bts_get_vblank_time_ns(const struct dpu_bts_disp_info *disp)
+{
+	u32 line_t_ns, v_blank_t_ns;
+
+	line_t_ns = dpu_bts_get_one_line_time(disp->height,
+		disp->vbp, disp->vfp, disp->vsa, disp->fps);
+	if (disp->video_mode)
+		v_blank_t_ns = (disp->vbp + disp->vfp) * line_t_ns;
+	else
+		v_blank_t_ns = disp->vblank_usec * 1000U;
+
+	DPU_DEBUG_BTS("  -line_t_ns(%u) v_blank_t_ns(%u)\n",
+			line_t_ns, v_blank_t_ns);
+
+	return v_blank_t_ns;
+}
+
+static u32 dpu_bts_find_nearest_high_freq(const struct dpu_bts_params *params, u32 aclk_base)
+{
+	int i;
+
+	if (aclk_base > params->dfs_lv_khz[0]) {
+		DPU_DEBUG_BTS("  aclk_base is greater than L0 frequency!");
+		i = 0;
+	} else {
+		/* search from low frequency level */
+		for (i = (params->dfs_lv_cnt - 1); i >= 0; i--) {
+			if (aclk_base <= params->dfs_lv_khz[i])
+				break;
+		}
+	}
+	DPU_DEBUG_BTS("  Nearest DFS: %u KHz @L%d\n", params->dfs_lv_khz[i], i);
+
+	return i;
+}
+
+/*
+ * [caution] src_w/h is rotated size info
+ * - src_w : src_h @original input image
+ * - src_h : src_w @original input image
+ */
+static u64 dpu_bts_calc_rotate_aclk(const struct dpu_bts_params *params,
+		const struct dpu_bts_disp_info *disp, u32 aclk_base,
+		u32 ppc, u32 src_w, u32 dst_w,
+		bool is_comp, bool is_downscale, bool is_dsc)
+{
+	u32 dfs_idx = 0;
+	u32 dpu_cycle, basic_cycle, dsi_cycle, module_cycle = 0;
+	u32 comp_cycle = 0, rot_cycle = 0, scale_cycle = 0, dsc_cycle = 0;
+	u32 rot_init_bw = 0; /* KB/s */
+	u64 rot_clk, rot_need_clk;
+	u32 aclk_x_1k_ns, dpu_lat_t_ns, max_lat_t_ns, tx_allow_t_ns;
+	u32 bus_perf;
+	u32 temp_clk;
+	bool retry_flag = false;
+
+	DPU_DEBUG_BTS("[ROT+] BEFORE latency check: %u KHz\n", aclk_base);
+
+	dfs_idx = dpu_bts_find_nearest_high_freq(params, aclk_base);
+	rot_clk = params->dfs_lv_khz[dfs_idx];
+
+	/* post DECON OUTFIFO based on 1H transfer */
+	dsi_cycle = disp->width;
+
+	/* get additional pipeline latency */
+	if (is_comp) {
+		comp_cycle = dpu_bts_comp_latency(src_w, ppc,
+			params->delay_comp);
+		DPU_DEBUG_BTS("  COMP: lat_cycle(%u)\n", comp_cycle);
+		module_cycle += comp_cycle;
+	} else {
+		rot_cycle = dpu_bts_rotate_latency(src_w,
+			params->ppc_rotator);
+		DPU_DEBUG_BTS("  ROT: lat_cycle(%u)\n", rot_cycle);
+		module_cycle += rot_cycle;
+	}
+	if (is_downscale) {
+		scale_cycle = dpu_bts_scale_latency(src_w, dst_w,
+			params->ppc_scaler, params->delay_scaler);
+		DPU_DEBUG_BTS("  SCALE: lat_cycle(%u)\n", scale_cycle);
+		module_cycle += scale_cycle;
+	}
+	if (is_dsc) {
+		dsc_cycle = dpu_bts_dsc_latency(disp->slice_count,
+			disp->dsc_count, dst_w, ppc);
+		DPU_DEBUG_BTS("  DSC: lat_cycle(%u)\n", dsc_cycle);
+		module_cycle += dsc_cycle;
+		dsi_cycle = (dsi_cycle + 2) / 3;
+	}
+
+	/*
+	 * basic cycle(+ bubble: 10%) + additional cycle based on function
+	 * cycle count increases when ACLK goes up due to other conditions
+	 * At latency monitor experiment using unit test,
+	 *  cycles at 400Mhz were increased by about 800 compared to 200Mhz.
+	 * Here, (aclk_mhz * 2) cycles are reflected referring to the result
+	 *  because the exact value is unknown.
+	 */
+	basic_cycle = (disp->width * 11 / 10 + dsi_cycle) / ppc;
+
+retry_hi_freq:
+	dpu_cycle = (basic_cycle + module_cycle) + rot_clk * 2 / 1000U;
+	aclk_x_1k_ns = dpu_bts_convert_aclk_to_ns(rot_clk / 1000U);
+	dpu_lat_t_ns = mult_frac(aclk_x_1k_ns, dpu_cycle, 1000);
+	max_lat_t_ns = dpu_bts_get_vblank_time_ns(disp);
+	if (max_lat_t_ns > dpu_lat_t_ns) {
+		tx_allow_t_ns = max_lat_t_ns - dpu_lat_t_ns;
+	} else {
+		/* abnormal case : apply bus_util_pct of v_blank */
+		tx_allow_t_ns = (max_lat_t_ns * params->bus_util_pct) / 100;
+		DPU_DEBUG_BTS("  WARN: latency calc is abnormal!(-> %u%%)\n",
+				params->bus_util_pct);
+	}
+
+	bus_perf = params->bus_width * params->rot_util_pct;
+	/* apply as worst(P010: 3) case to simplify */
+	rot_init_bw = mult_frac(NSEC_PER_SEC, src_w * ROT_READ_BYTE * 3, tx_allow_t_ns) / 1000;
+	rot_need_clk = rot_init_bw * 100 / bus_perf;
+
+	if (rot_need_clk > rot_clk) {
+		/* not max level */
+		if (dfs_idx) {
+			/* check if calc_clk is greater than 1-step */
+			dfs_idx--;
+			temp_clk = params->dfs_lv_khz[dfs_idx];
+			if ((rot_need_clk > temp_clk) && (!retry_flag)) {
+				DPU_DEBUG_BTS("  -allow_ns(%u) dpu_ns(%u)\n",
+					tx_allow_t_ns, dpu_lat_t_ns);
+				rot_clk = temp_clk;
+				retry_flag = true;
+				goto retry_hi_freq;
+			}
+		}
+		rot_clk = rot_need_clk;
+	}
+
+	DPU_DEBUG_BTS("  -dpu_cycle(%u) aclk_x_1k_ns(%u) dpu_lat_t_ns(%u)\n",
+			dpu_cycle, aclk_x_1k_ns, dpu_lat_t_ns);
+	DPU_DEBUG_BTS("  -tx_allow_t_ns(%u) rot_init_bw(%u) rot_need_clk(%llu)\n",
+			tx_allow_t_ns, rot_init_bw, rot_need_clk);
+	DPU_DEBUG_BTS("[ROT-] AFTER latency check: %llu KHz\n", rot_clk);
+
+	return rot_clk;
+}
+
+static u64 dpu_bts_calc_aclk_disp(const struct dpu_bts_params *params,
+				  const struct dpu_bts_disp_info *disp,
+				  const struct dpu_bts_win_config *config, u64 resol_clk,
+				  u32 max_clk)
+{
+	u64 aclk_disp, aclk_base, aclk_disp_khz;
+	u32 ppc;
+	u32 src_w, src_h;
+	u32 diff_w, ratio_v;
+	u32 is_downscale = false;
+	u32 is_dsc = false;
+	u64 margin;
+
+	if (config->is_rot) {
+		src_w = config->src_h;
+		src_h = config->src_w;
+	} else {
+		src_w = config->src_w;
+		src_h = config->src_h;
+	}
+
+	if (src_w > config->dst_w || src_h > config->dst_h)
+		is_downscale = true;
+
+	/* case for using dsc encoder 1ea at decon0 or decon1 */
+	if ((disp->id != 2) && (disp->dsc_count == 1))
+		ppc = ((params->ppc / 2UL) >= 1UL) ?
+				(params->ppc / 2UL) : 1UL;
+	else
+		ppc = params->ppc;
+
+	margin = 1100 + ((48000 + 20000) / disp->width);
+	diff_w = (src_w <= config->dst_w) ? 0 : src_w - config->dst_w;
+
+	if (src_h > config->dst_h) {
+		u32 ratio_a, line_a, line_b;
+
+		ratio_v = DIV_ROUND_UP(src_h, config->dst_h);
+		ratio_a = (ratio_v * 1000) - mult_frac(src_h, 1000, config->dst_h);
+		line_a = max((ratio_v - 2) * src_w + max(src_w, config->dst_w),
+				disp->width + diff_w);
+		line_b = max((ratio_v - 1) * src_w + max(src_w, config->dst_w),
+				disp->width + diff_w);
+		aclk_disp = (u64)(line_a * ratio_a + line_b * (1000 - ratio_a));
+	} else {
+		ratio_v = (src_h >= config->dst_h) ? 1000 : mult_frac(src_h, 1000, config->dst_h);
+		aclk_disp = (u64)((disp->width + diff_w) *
+			ratio_v + disp->width * (1000 - ratio_v));
+	}
+	aclk_disp = mult_frac(aclk_disp, disp->height * disp->fps, 1000);
+	aclk_disp_khz = (aclk_disp * margin / 1000) / 1000;
+
+	if (aclk_disp_khz < resol_clk)
+		aclk_disp_khz = resol_clk;
+	aclk_disp_khz /= ppc;
+
+	if (!config->is_rot)
+		return aclk_disp_khz;
+
+	/* rotation case: check if latency conditions are met */
+	if (aclk_disp_khz > max_clk)
+		aclk_base = aclk_disp_khz;
+	else
+		aclk_base = max_clk;
+
+	if (disp->dsc_enabled)
+		is_dsc = true;
+
+	aclk_disp_khz = dpu_bts_calc_rotate_aclk(params, disp, (u32)aclk_base, ppc,
+			src_w, config->dst_w, config->is_comp, is_downscale, is_dsc);
+
+	return aclk_disp_khz;
+}
+
+static u32 dpu_bts_calc_disp_with_full_size(const struct dpu_bts_params *params,
+		const struct dpu_bts_disp_info *disp)
+{
+	struct dpu_bts_win_config config;
+	u64 resol_clk;
+
+	memset(&config, 0, sizeof(struct dpu_bts_win_config));
+	config.src_w = config.dst_w = disp->width;
+	config.src_h = config.dst_h = disp->height;
+	config.format = DRM_FORMAT_ARGB8888;
+	config.bpp = 32;
+
+	resol_clk = dpu_bts_get_resol_clock(disp->width, disp->height, disp->fps);
+
+	return dpu_bts_calc_aclk_disp(params, disp, &config, resol_clk, resol_clk);
+}
+
+/*
+ * Window edge on the vertical axis. A window with buffer occupies
+ * [dst_y, dst_y + dst_h) and requests its rt bandwidth while the scanout is
+ * inside that range. A window of zero height covers nothing, but its own
+ * bandwidth is still counted on top of what covers dst_y.
+ *
+ * At equal y, windows ending there are removed before windows starting there
+ * are added, and zero height windows are checked last.
+ */
+enum dpu_bts_edge_type {
+	BTS_EDGE_END,
+	BTS_EDGE_START,
+	BTS_EDGE_POINT,
+};
+
+struct dpu_bts_edge {
+	u32 y;
+	enum dpu_bts_edge_type type;
+	u32 bw;
+	u32 ch_num;
+};
+
+#define BTS_MAX_EDGES	((MAX_WIN_PER_DECON + 1) * 2)
+
+static int dpu_bts_edge_cmp(const void *a, const void *b)
+{
+	const struct dpu_bts_edge *e0 = a, *e1 = b;
+
+	if (e0->y != e1->y)
+		return e0->y < e1->y ? -1 : 1;
+
+	return (int)e0->type - (int)e1->type;
+}
+
+static int dpu_bts_add_edges(struct dpu_bts_edge *edges, int cnt,
+			     const struct dpu_bts_win_config *config, u32 bw, u32 ch_num)
+{
+	edges[cnt].y = config->dst_y;
+	edges[cnt].bw = bw;
+	edges[cnt].ch_num = ch_num;
+
+	if (!config->dst_h) {
+		edges[cnt].type = BTS_EDGE_POINT;
+		return cnt + 1;
+	}
+
+	edges[cnt].type = BTS_EDGE_START;
+	edges[cnt + 1] = edges[cnt];
+	edges[cnt + 1].y = config->dst_y + config->dst_h;
+	edges[cnt + 1].type = BTS_EDGE_END;
+
+	return cnt + 2;
+}
+
+/*
+ * Peak rt bandwidth of overlapping edges, in total and per DPU AXI channel into @ch_bw. The
+ * peak is found with a single sweep over the sorted edges instead of comparing every pair of
+ * windows.
+ */
+static u32 dpu_bts_sweep_edges(struct dpu_bts_edge *edges, int cnt, u32 ch_bw[MAX_AXI_PORT])
+{
+	u32 overlap_bw = 0, max_overlap_bw = 0;
+	u32 cur_ch_bw[MAX_AXI_PORT] = { 0 };
+	int i;
+
+	sort(edges, cnt, sizeof(edges[0]), dpu_bts_edge_cmp, NULL);
+
+	memset(ch_bw, 0, sizeof(cur_ch_bw));
+	for (i = 0; i < cnt; i++) {
+		const struct dpu_bts_edge *edge = &edges[i];
+		bool valid_ch = edge->ch_num < MAX_AXI_PORT;
+
+		switch (edge->type) {
+		case BTS_EDGE_END:
+			overlap_bw -= edge->bw;
+			if (valid_ch)
+				cur_ch_bw[edge->ch_num] -= edge->bw;
+			break;
+		case BTS_EDGE_START:
+			overlap_bw += edge->bw;
+			DPU_DEBUG_BTS("  Overlap BW @%u = %u\n", edge->y, overlap_bw);
+			max_overlap_bw = max(max_overlap_bw, overlap_bw);
+			if (valid_ch) {
+				cur_ch_bw[edge->ch_num] += edge->bw;
+				ch_bw[edge->ch_num] = max(ch_bw[edge->ch_num],
+						cur_ch_bw[edge->ch_num]);
+			}
+			break;
+		case BTS_EDGE_POINT:
+			max_overlap_bw = max(max_overlap_bw, overlap_bw + edge->bw);
+			if (valid_ch)
+				ch_bw[edge->ch_num] = max(ch_bw[edge->ch_num],
+						cur_ch_bw[edge->ch_num] + edge->bw);
+			break;
+		}
+	}
+
+	return max_overlap_bw;
+}
+
+/* RCD is accounted as one more window */
+static void dpu_bts_update_overlap_bw(const struct dpu_bts_params *params,
+				       const struct dpu_bts_frame *frame,
+				       struct dpu_bts_result *res)
+{
+	const struct dpu_bts_win_config *config;
+	struct dpu_bts_edge edges[BTS_MAX_EDGES];
+	int i, cnt = 0;
+
+	/* TODO: take write rt bandwidth into account */
+	for (i = 0; i < frame->win_cnt; i++) {
+		if (frame->win_config[i].state != DPU_WIN_STATE_BUFFER)
+			continue;
+
+		config = &frame->win_config[i];
+		cnt = dpu_bts_add_edges(edges, cnt, config, res->rt_bw[config->dpp_ch],
+					params->ch_num[config->dpp_ch]);
+		if (edges[cnt - 1].ch_num >= MAX_AXI_PORT)
+			pr_err("invalid DPU AXI channel number %u\n",
+					edges[cnt - 1].ch_num);
+	}
+
+	if (frame->rcd_config.state == DPU_WIN_STATE_BUFFER) {
+		config = &frame->rcd_config;
+		cnt = dpu_bts_add_edges(edges, cnt, config, res->rt_bw[config->dpp_ch],
+					params->ch_num[config->dpp_ch]);
+		if (edges[cnt - 1].ch_num >= MAX_AXI_PORT)
+			pr_err("invalid RCD AXI channel number %u\n",
+					edges[cnt - 1].ch_num);
+	}
+
+	res->rt_avg_bw = dpu_bts_sweep_edges(edges, cnt, res->ch_bw);
+
+	for (i = 0; i < MAX_AXI_PORT; ++i) {
+		if (res->ch_bw[i])
+			DPU_DEBUG_BTS("  AXI_DPU%d = %u\n", i, res->ch_bw[i]);
+	}
+}
+
+/* bandwidth of other decons goes through the same DPU AXI ports */
+static void dpu_bts_sum_all_decon_bw(const struct dpu_bts_frame *frame,
+				     const struct dpu_bts_result *res,
+				     u32 *max_overlap_bw, u32 *max_disp_ch_bw)
+{
+	u32 disp_ch_bw;
+	int i;
+
+	*max_overlap_bw = res->rt_avg_bw + frame->other_rt_avg_bw;
+	*max_disp_ch_bw = 0;
+	for (i = 0; i < MAX_AXI_PORT; i++) {
+		disp_ch_bw = res->ch_bw[i] + frame->other_ch_bw[i];
+		if (frame->other_ch_bw[i])
+			DPU_DEBUG_BTS("    add other DECONs AXI_DPU%d = %u\n", i,
+					frame->other_ch_bw[i]);
+		*max_disp_ch_bw = max(*max_disp_ch_bw, disp_ch_bw);
+	}
+
+	DPU_DEBUG_BTS("  Max Overlap BW = %u, Max AXI_DPU = %u\n",
+		*max_overlap_bw, *max_disp_ch_bw);
+}
+
+static void dpu_bts_find_max_disp_freq(const struct dpu_bts_params *params,
+		const struct dpu_bts_disp_info *disp, const struct dpu_bts_frame *frame,
+		struct dpu_bts_result *res)
+{
+	int i;
+	u32 max_overlap_bw;
+	u32 max_disp_ch_bw;
+	u32 disp_op_freq = 0;
+	const struct dpu_bts_win_config *win_config = frame->win_config;
+
+	dpu_bts_update_overlap_bw(params, frame, res);
+	dpu_bts_sum_all_decon_bw(frame, res, &max_overlap_bw, &max_disp_ch_bw);
+
+	res->max_disp_freq = max_disp_ch_bw * 100 /
+			(params->bus_width * params->bus_util_pct);
+
+	/* TODO: the final INT should be max(max_peak_bw, total_peak_bw / NUM_DRAM_CH). It nees
+	 * some changes in bts driver to allow client request peak_bw. Before we lock down the
+	 * design, DPU requests max(max_ch_bw, max_overlap_bw / NUM_INTERCONNECT_CH) as peak.
+	 * After we take write bw into account, we don't need to check write bw here.
+	 */
+	res->peak = max3(max_disp_ch_bw, max_overlap_bw / NUM_INTERCONNECT_CH,
+				res->write_bw);
+
+	for (i = 0; i < frame->win_cnt; ++i) {
+		u32 freq;
+
+		if ((win_config[i].state != DPU_WIN_STATE_BUFFER) &&
+				(win_config[i].state != DPU_WIN_STATE_COLOR))
+			continue;
+
+		freq = dpu_bts_calc_aclk_disp(params, disp, &win_config[i],
+				(u64)res->resol_clk, res->max_disp_freq);
+		disp_op_freq = max(disp_op_freq, freq);
+	}
+
+	/*
+	 * At least one window is used for colormap if there is a request of
+	 * disabling all windows. So, disp frequency for a window of LCD full
+	 * size is necessary.
+	 */
+	if (disp_op_freq == 0)
+		disp_op_freq = dpu_bts_calc_disp_with_full_size(params, disp);
+
+	DPU_DEBUG_BTS("  DISP bus freq(%u), operating freq(%u)\n",
+			res->max_disp_freq, disp_op_freq);
+
+	res->max_disp_freq = max(res->max_disp_freq, disp_op_freq);
+
+	DPU_DEBUG_BTS("  MAX DISP CH FREQ = %u\n", res->max_disp_freq);
+}
+
+static void
+dpu_bts_calc_dpp_bw(struct bts_dpp_info *dpp, u32 fps, u32 lcd_h, u32 vblank_us, int idx,
+		const struct dpu_bts_params *params)
+{
+	u32 avg_bw, rt_bw, rot_bw = 0;
+	u32 src_w = dpp->src_w;
+	u32 src_h = dpp->src_h;
+	u32 dst_h = dpp->dst.y2 - dpp->dst.y1;
+	u32 bpp = dpp->bpp;
+
+	/* Bandwidth requirement for layer
+	 * - AVG BW (KB) : sw * sh * fps * (bpp / 8) / 1000
+	 * - RT BW (KB) : AVG_BW * panel_h / dh * 1.1
+	 */
+	avg_bw = src_w * src_h * bpp / 8 * fps / 1000;
+	rt_bw = mult_frac(avg_bw, lcd_h * 11, dst_h * 10);
+
+	if (dpp->rotation) {
+		/* ROT BW(KB) : sh * 32B * (bpp / 8) / v_blank */
+		rot_bw = mult_frac(src_h * ROT_READ_BYTE * bpp / 8,
+				USEC_PER_SEC, vblank_us) / 1000;
+	}
+
+	DPU_DEBUG_BTS("  DPP%d bandwidth: avg %u, rt %u, rot %u\n", idx, avg_bw, rt_bw, rot_bw);
+
+	rt_bw = max(rt_bw, rot_bw);
+	if (dpp->is_afbc) {
+		u32 afbc_util_pct, afbc_rt_util_pct;
+
+		if (dpp->is_yuv) {
+			afbc_util_pct = params->afbc_yuv_util_pct;
+			afbc_rt_util_pct = params->afbc_yuv_rt_util_pct;
+		} else {
+			afbc_util_pct = params->afbc_rgb_util_pct;
+			afbc_rt_util_pct = params->afbc_rgb_rt_util_pct;
+		}
+
+		avg_bw = mult_frac(avg_bw, afbc_util_pct, 100);
+		rt_bw = mult_frac(rt_bw, afbc_rt_util_pct, 100);
+	}
+
+	dpp->bw = avg_bw;
+	dpp->rt_bw = rt_bw;
+	DPU_DEBUG_BTS("           final: avg %u, rt %u\n", dpp->bw, dpp->rt_bw);
+}
+
+static void dpu_bts_convert_config_to_info(struct bts_dpp_info *dpp,
+				const struct dpu_bts_win_config *config)
+{
+	dpp->bpp = config->bpp;
+	dpp->src_w = config->src_w;
+	dpp->src_h = config->src_h;
+	dpp->dst.x1 = config->dst_x;
+	dpp->dst.x2 = config->dst_x + config->dst_w;
+	dpp->dst.y1 = config->dst_y;
+	dpp->dst.y2 = config->dst_y + config->dst_h;
+	dpp->rotation = config->is_rot;
+	dpp->is_afbc = config->is_comp;
+	dpp->is_yuv = config->is_yuv;
+
+	DPU_DEBUG_BTS("  DPP%d : bpp(%u) src w(%u) h(%u) rot(%d) afbc(%d) yuv(%d)\n",
+			DPU_DMA2CH(config->dpp_ch), dpp->bpp, dpp->src_w,
+			dpp->src_h, dpp->rotation, dpp->is_afbc, dpp->is_yuv);
+	DPU_DEBUG_BTS("        dst x(%u) right(%u) y(%u) bottom(%u)\n",
+			dpp->dst.x1, dpp->dst.x2, dpp->dst.y1, dpp->dst.y2);
+}
+
+/**
+ * dpu_bts_calc - calculate bandwidth and DISP clock requirement of a frame
+ * @params: DPU characteristics
+ * @disp: output path and timing of the display mode
+ * @frame: layers of the frame and bandwidth of other decons
+ * @res: calculated bandwidth and clock
+ *
+ * Doesn't depend on any device state, so it can be used to evaluate arbitrary
+ * frames as well as the one being committed.
+ */
+void dpu_bts_calc(const struct dpu_bts_params *params, const struct dpu_bts_disp_info *disp,
+		  const struct dpu_bts_frame *frame, struct dpu_bts_result *res)
+{
+	const struct dpu_bts_win_config *config;
+	struct bts_decon_info bts_info;
+	int idx, i, wb_idx = -1, rcd_idx = -1;
+	u32 read_bw = 0, write_bw;
+	u32 vblank_us;
+
+	DPU_DEBUG_BTS("%s + : DECON%u\n", __func__, disp->id);
+
+	memset(&bts_info, 0, sizeof(struct bts_decon_info));
+	memset(res, 0, sizeof(*res));
+
+	res->resol_clk = (u32)dpu_bts_get_resol_clock(disp->width, disp->height, disp->fps);
+	DPU_DEBUG_BTS("[Run: D%u] resol clock = %u Khz @%u fps\n",
+		disp->id, res->resol_clk, disp->fps);
+
+	bts_info.vclk = res->resol_clk;
+	bts_info.lcd_w = disp->width;
+	bts_info.lcd_h = disp->height;
+	vblank_us = dpu_bts_get_vblank_time_ns(disp) / 1000U;
+	/* reflect bus_util_pct for dpu processing latency when rotation */
+	vblank_us = (vblank_us * params->rot_util_pct) / 100;
+
+	/* read bw calculation */
+	config = frame->win_config;
+	for (i = 0; i < frame->win_cnt; ++i) {
+		if (config[i].state != DPU_WIN_STATE_BUFFER)
+			continue;
+
+		idx = config[i].dpp_ch;
+		dpu_bts_convert_config_to_info(&bts_info.rdma[idx], &config[i]);
+		dpu_bts_calc_dpp_bw(&bts_info.rdma[idx], disp->fps, disp->height, vblank_us,
+				idx, params);
+		read_bw += bts_info.rdma[idx].bw;
+	}
+
+	/* write bw calculation */
+	config = &frame->wb_config;
+	if (config->state == DPU_WIN_STATE_BUFFER) {
+		wb_idx = config->dpp_ch;
+		dpu_bts_convert_config_to_info(&bts_info.odma, config);
+		dpu_bts_calc_dpp_bw(&bts_info.odma, disp->fps, bts_info.lcd_h,
+				vblank_us, wb_idx, params);
+		write_bw = bts_info.odma.bw;
+	} else {
+		wb_idx = -1;
+		write_bw = 0;
+	}
+
+	/* rcd bw calculation */
+	config = &frame->rcd_config;
+	if (config->state == DPU_WIN_STATE_BUFFER) {
+		rcd_idx = config->dpp_ch;
+		dpu_bts_convert_config_to_info(&bts_info.rcddma, config);
+		dpu_bts_calc_dpp_bw(&bts_info.rcddma, disp->fps, bts_info.lcd_h,
+				vblank_us, rcd_idx, params);
+		read_bw += bts_info.rcddma.bw;
+	} else {
+		rcd_idx = -1;
+	}
+
+	for (i = 0; i < MAX_DPP_CNT; i++) {
+		if (i < MAX_WIN_PER_DECON)
+			res->rt_bw[i] = bts_info.rdma[i].rt_bw;
+		else if (i == wb_idx)
+			res->rt_bw[i] = bts_info.odma.rt_bw;
+		else if (i == rcd_idx)
+			res->rt_bw[i] = bts_info.rcddma.rt_bw;
+		else
+			res->rt_bw[i] = 0;
+	}
+
+	res->read_bw = read_bw;
+	res->write_bw = write_bw;
+	res->total_bw = read_bw + write_bw;
+
+	DPU_DEBUG_BTS("  DECON%u total bw = %u, read bw = %u, write bw = %u\n",
+			disp->id, res->total_bw, res->read_bw, res->write_bw);
+
+	if (res->total_bw) {
+		dpu_bts_find_max_disp_freq(params, disp, frame, res);
+	} else {
+		/* no bw requirement */
+		res->max_disp_freq = dpu_bts_calc_disp_with_full_size(params, disp);
+	}
+
+	DPU_DEBUG_BTS("%s -\n", __func__);
+}
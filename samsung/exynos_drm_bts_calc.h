@@ -0,0 +1,148 @@
+/* SPDX-License-Identifier: GPL-2.0-only
+ *
+ * Copyright (c) 2016 Samsung Electronics Co., Ltd.
+ *		http://www.samsung.com
+ *
+ * Header file for the BTS bandwidth and clock calculation of Samsung EXYNOS DPU driver
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ */
+
+#ifndef __EXYNOS_DRM_BTS_CALC_H__
+#define __EXYNOS_DRM_BTS_CALC_H__
+
+#include <linux/types.h>
+
+#include <decon_cal.h>
+#include <dpp_cal.h>
+
+#define DPU_DEBUG_BTS(fmt, args...)	pr_debug("[BTS] "fmt,  ##args)
+#define DPU_INFO_BTS(fmt, args...)	pr_info("[BTS] "fmt,  ##args)
+#define DPU_ERR_BTS(fmt, args...)	pr_err("[BTS] "fmt, ##args)
+
+enum dpu_win_state {
+	DPU_WIN_STATE_DISABLED = 0,
+	DPU_WIN_STATE_COLOR,
+	DPU_WIN_STATE_BUFFER,
+};
+
+struct dpu_bts_win_config {
+	enum dpu_win_state state;
+	u32 src_x;
+	u32 src_y;
+	u32 src_w;
+	u32 src_h;
+	int dst_x;
+	int dst_y;
+	u32 dst_w;
+	u32 dst_h;
+	bool is_rot;
+	bool is_comp;
+	bool is_secure;
+	bool is_yuv;
+	int dpp_ch;
+	u32 format;
+	u32 bpp;
+	u64 comp_src;
+};
+
+struct decon_win_config {
+	struct dpu_bts_win_config win;
+	dma_addr_t dma_addr;
+};
+
+struct bts_layer_position {
+	u32 x1;
+	u32 x2; /* x2 = x1 + width */
+	u32 y1;
+	u32 y2; /* y2 = y1 + height */
+};
+
+struct bts_dpp_info {
+	u32 bpp;
+	u32 src_h;
+	u32 src_w;
+	struct bts_layer_position dst;
+	u32 bw;
+	u32 rt_bw;
+	bool rotation;
+	bool is_afbc;
+	bool is_yuv;
+};
+
+struct bts_decon_info {
+	struct bts_dpp_info rdma[MAX_WIN_PER_DECON];
+	struct bts_dpp_info odma;
+	struct bts_dpp_info rcddma;
+	u32 vclk; /* Khz */
+	u32 lcd_w;
+	u32 lcd_h;
+};
+
+/* DPU characteristics the calculation depends on, from device tree */
+struct dpu_bts_params {
+	u64 ppc;
+	u32 ppc_rotator;
+	u32 ppc_scaler;
+	u32 delay_comp;
+	u32 delay_scaler;
+	u32 bus_width;
+	u32 bus_util_pct;
+	u32 rot_util_pct;
+	u32 afbc_rgb_util_pct;
+	u32 afbc_yuv_util_pct;
+	u32 afbc_rgb_rt_util_pct;
+	u32 afbc_yuv_rt_util_pct;
+	u32 dfs_lv_cnt;
+	u32 dfs_lv_khz[BTS_DFS_MAX];
+	/* DPU AXI port of each dpp channel, includes writeback dpp */
+	u32 ch_num[MAX_DPP_CNT];
+};
+
+/* output path and timing of the current display mode */
+struct dpu_bts_disp_info {
+	u32 id;
+	u32 width;
+	u32 height;
+	bool video_mode;
+	bool dsc_enabled;
+	u32 dsc_count;
+	u32 slice_count;
+	u32 fps;
+	u32 vbp;
+	u32 vfp;
+	u32 vsa;
+	u32 vblank_usec;
+};
+
+/*
+ * Layers of a frame, with the bandwidth other decons currently request since
+ * it's summed up into the peak of this one.
+ */
+struct dpu_bts_frame {
+	struct dpu_bts_win_config win_config[MAX_WIN_PER_DECON];
+	struct dpu_bts_win_config wb_config;
+	struct dpu_bts_win_config rcd_config;
+	u32 win_cnt;
+	u32 other_rt_avg_bw;
+	u32 other_ch_bw[MAX_AXI_PORT];
+};
+
+struct dpu_bts_result {
+	u32 resol_clk;
+	u32 peak;
+	u32 rt_avg_bw;
+	u32 read_bw;
+	u32 write_bw;
+	u32 total_bw;
+	u32 max_disp_freq;
+	u32 rt_bw[MAX_DPP_CNT];
+	u32 ch_bw[MAX_AXI_PORT];
+};
+
+void dpu_bts_calc(const struct dpu_bts_params *params, const struct dpu_bts_disp_info *disp,
+		  const struct dpu_bts_frame *frame, struct dpu_bts_result *res);
+
+#endif /* __EXYNOS_DRM_BTS_CALC_H__ */
@@ -44,6 +44,84 @@ struct exynos_drm_connector;
 #define EXYNOS_DSI_MSG_FORCE_BATCH BIT(13)
 /* Mark the end of mipi commands transaction */
 #define EXYNOS_DSI_MSG_FORCE_FLUSH  BIT(12)
+/* tx_buf points to a struct exynos_dsi_cmd_image to be pushed as is */
+#define EXYNOS_DSI_MSG_CMD_IMAGE  BIT(11)
+
+/**
+ * struct exynos_dsi_cmd_image - dsi packets laid out as pushed to the cmd fifos
+ * @num_pkts:  number of packets, fits in the packet header fifo
+ * @pl_len:    payload fifo bytes used by the long packets
+ * @num_words: number of words in @words
+ * @words:     for each packet, its header (data type, data 0 and data 1 in
+ *             bits 0-23) followed by the payload words of a long packet
+ */
+struct exynos_dsi_cmd_image {
+	u32 num_pkts;
+	u32 pl_len;
+	u32 num_words;
+	const u32 *words;
+};
+
+/* tx_buf points to a struct exynos_dsi_async_req, queued and sent later */
+#define EXYNOS_DSI_MSG_ASYNC  BIT(10)
+
+/**
+ * struct exynos_dsi_async_cmd - one write of an asynchronous request
+ * @type:     dsi data type
+ * @flags:    mipi_dsi_msg flags
+ * @tx_buf:   data to send
+ * @tx_len:   length of @tx_buf
+ * @delay_us: time to wait after this command before sending the next one
+ */
+struct exynos_dsi_async_cmd {
+	u8 type;
+	u16 flags;
+	const void *tx_buf;
+	size_t tx_len;
+	u32 delay_us;
+};
+
+/**
+ * struct exynos_dsi_async_req - writes sent in order by the dsi host
+ * @num_cmds: number of entries in @cmds
+ * @cmds:     the writes, copied by the host on submission
+ * @complete: optional, called from the host worker once the request is done,
+ *            with 0 or the error of the first failed write. Later writes of
+ *            a failed request are dropped. Must not block on the host.
+ * @data:     passed to @complete
+ */
+struct exynos_dsi_async_req {
+	u32 num_cmds;
+	const struct exynos_dsi_async_cmd *cmds;
+	void (*complete)(void *data, int ret);
+	void *data;
+};
+
+/* tx_buf points to a struct exynos_dsi_read_batch, the reads run back to back */
+#define EXYNOS_DSI_MSG_READ_BATCH  BIT(9)
+
+/**
+ * struct exynos_dsi_read - one read of a batch
+ * @type:   dsi read request data type
+ * @tx_buf: read request parameters, e.g. the dcs command
+ * @tx_len: length of @tx_buf
+ * @rx_buf: buffer for the response
+ * @rx_len: expected response length
+ * @ret:    set by the host to the number of bytes read or an error
+ */
+struct exynos_dsi_read {
+	u8 type;
+	const void *tx_buf;
+	size_t tx_len;
+	void *rx_buf;
+	size_t rx_len;
+	ssize_t ret;
+};
+
+struct exynos_dsi_read_batch {
+	u32 num_reads;
+	struct exynos_dsi_read *reads;
+};
 
 struct exynos_drm_connector_properties {
 	struct drm_property *max_luminance;
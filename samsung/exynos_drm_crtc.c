@@ -179,11 +179,9 @@ static int exynos_crtc_atomic_check(struct drm_crtc *crtc,
 	} else if (new_exynos_state->force_bpc == EXYNOS_BPC_MODE_UNSPECIFIED) {
 		max_bpc = 8; /* initial bpc value */
 		drm_atomic_crtc_state_for_each_plane_state(plane, plane_state, crtc_state) {
-			const struct drm_format_info *info;
-			const struct dpu_fmt *fmt_info;
+			const struct dpu_fmt *fmt_info =
+				to_exynos_plane_state(plane_state)->fmt_info;
 
-			info = plane_state->fb->format;
-			fmt_info = dpu_find_fmt_info(info->format);
 			if (fmt_info->bpc == 10) {
 				max_bpc = 10;
 				break;
@@ -443,6 +441,7 @@ exynos_drm_crtc_duplicate_state(struct drm_crtc *crtc)
 	copy->skip_update = false;
 	copy->planes_updated = false;
 	copy->hibernation_exit = false;
+	copy->freed_win_mask = 0;
 
 	return &copy->base;
 }
@@ -584,7 +583,7 @@ static int exynos_drm_crtc_get_property(struct drm_crtc *crtc,
 	if (property == exynos_crtc->props.color_mode)
 		*val = exynos_crtc_state->color_mode;
 	else if (property == exynos_crtc->props.ppc)
-		*val = decon->bts.ppc;
+		*val = decon->bts.params.ppc;
 	else if (property == exynos_crtc->props.max_disp_freq)
 		*val = decon->bts.dvfs_max_disp_freq;
 	else if (property == exynos_crtc->props.force_bpc)
@@ -643,6 +642,7 @@ static void exynos_drm_crtc_print_state(struct drm_printer *p,
 	exynos_state = container_of(state, struct exynos_drm_crtc_state, base);
 
 	drm_printf(p, "\treserved_win_mask=0x%x\n", exynos_crtc_state->reserved_win_mask);
+	drm_printf(p, "\tfreed_win_mask=0x%x\n", exynos_crtc_state->freed_win_mask);
 	drm_printf(p, "\tDecon #%u (state:%d)\n", decon->id, decon->state);
 	drm_printf(p, "\t\ttype=0x%x\n", cfg->out_type);
 	drm_printf(p, "\t\tsize=%dx%d\n", cfg->image_width, cfg->image_height);
@@ -14,9 +14,11 @@
 #include <linux/console.h>
 #include <linux/debugfs.h>
 #include <linux/ktime.h>
+#include <linux/log2.h>
 #include <linux/moduleparam.h>
 #include <linux/pm_runtime.h>
 #include <linux/time.h>
+#include <linux/uaccess.h>
 #include <video/mipi_display.h>
 #include <drm/drm_print.h>
 #include <drm/drm_managed.h>
@@ -41,7 +43,7 @@
 #include "exynos_drm_dsim.h"
 #include "exynos_drm_writeback.h"
 
-/* Default is 1024 entries array for event log buffer */
+/* Default event log buffer is large enough for 1024 of the largest entries */
 static unsigned int dpu_event_log_max = 1024;
 static unsigned int dpu_event_print_max = 512;
 static unsigned int dpu_event_print_underrun = 128;
@@ -54,7 +56,7 @@ module_param_named(event_log_max, dpu_event_log_max, uint, 0);
 module_param_named(event_print_max, dpu_event_print_max, uint, 0600);
 module_param_named(debug_dump_mask, dpu_debug_dump_mask, uint, 0600);
 
-MODULE_PARM_DESC(event_log_max, "entry count of event log buffer array");
+MODULE_PARM_DESC(event_log_max, "event log buffer size in count of largest entries");
 MODULE_PARM_DESC(event_print_max, "print entry count of event log buffer");
 MODULE_PARM_DESC(debug_dump_mask, "mask for dump debug event log");
 
@@ -62,19 +64,158 @@ MODULE_PARM_DESC(debug_dump_mask, "mask for dump debug event log");
 static bool dpu_event_ignore
 	(enum dpu_event_type type, struct decon_device *decon)
 {
-	int latest = atomic_read(&decon->d.event_log_idx) % dpu_event_log_max;
-	int idx, offset;
-
 	if (IS_ERR_OR_NULL(decon->d.event_log))
 		return true;
 
-	for (offset = 0; offset < DPU_EVENT_KEEP_CNT; ++offset) {
-		idx = (latest + dpu_event_log_max - offset) % dpu_event_log_max;
-		if (type != decon->d.event_log[idx].type)
-			return false;
+	return READ_ONCE(decon->d.last_event_type) == type &&
+		READ_ONCE(decon->d.last_event_repeat_cnt) >= DPU_EVENT_KEEP_CNT;
+}
+
+#define DPU_LOG_HDR_SIZE	offsetof(struct dpu_log, data)
+#define DPU_LOG_DATA_SIZE(member)	sizeof(((struct dpu_log *)0)->data.member)
+#define DPU_EVENT_LOG_MIN_SIZE	ALIGN(DPU_LOG_HDR_SIZE + sizeof(u32), DPU_EVENT_LOG_ALIGN)
+
+/* size of the data stored by each event type */
+static size_t dpu_event_data_size(enum dpu_event_type type)
+{
+	switch (type) {
+	case DPU_EVT_DPP_FRAMEDONE:
+	case DPU_EVT_DMA_RECOVERY:
+	case DPU_EVT_IDMA_AFBC_CONFLICT:
+	case DPU_EVT_IDMA_FBC_ERROR:
+	case DPU_EVT_IDMA_READ_SLAVE_ERROR:
+	case DPU_EVT_IDMA_DEADLOCK:
+	case DPU_EVT_IDMA_CFG_ERROR:
+		return DPU_LOG_DATA_SIZE(dpp);
+	case DPU_EVT_DECON_RSC_OCCUPANCY:
+		return DPU_LOG_DATA_SIZE(rsc);
+	case DPU_EVT_DECON_RUNTIME_SUSPEND:
+	case DPU_EVT_DECON_RUNTIME_RESUME:
+	case DPU_EVT_DECON_SUSPEND:
+	case DPU_EVT_DECON_RESUME:
+	case DPU_EVT_ENTER_HIBERNATION_IN:
+	case DPU_EVT_ENTER_HIBERNATION_OUT:
+	case DPU_EVT_EXIT_HIBERNATION_IN:
+	case DPU_EVT_EXIT_HIBERNATION_OUT:
+	case DPU_EVT_DSIM_RUNTIME_SUSPEND:
+	case DPU_EVT_DSIM_RUNTIME_RESUME:
+	case DPU_EVT_DSIM_SUSPEND:
+	case DPU_EVT_DSIM_RESUME:
+		return DPU_LOG_DATA_SIZE(pd);
+	case DPU_EVT_PLANE_PREPARE_FB:
+	case DPU_EVT_PLANE_CLEANUP_FB:
+		return DPU_LOG_DATA_SIZE(plane_info);
+	case DPU_EVT_PLANE_UPDATE:
+	case DPU_EVT_PLANE_DISABLE:
+		return DPU_LOG_DATA_SIZE(win);
+	case DPU_EVT_REQ_CRTC_INFO_OLD:
+	case DPU_EVT_REQ_CRTC_INFO_NEW:
+		return DPU_LOG_DATA_SIZE(crtc_info);
+	case DPU_EVT_BTS_RELEASE_BW:
+	case DPU_EVT_BTS_UPDATE_BW:
+		return DPU_LOG_DATA_SIZE(bts_update);
+	case DPU_EVT_BTS_CALC_BW:
+		return DPU_LOG_DATA_SIZE(bts_cal);
+	case DPU_EVT_DSIM_UNDERRUN:
+		return DPU_LOG_DATA_SIZE(bts_event);
+	case DPU_EVT_PARTIAL_INIT:
+	case DPU_EVT_PARTIAL_PREPARE:
+	case DPU_EVT_PARTIAL_RESTORE:
+	case DPU_EVT_PARTIAL_UPDATE:
+		return DPU_LOG_DATA_SIZE(partial);
+	case DPU_EVT_DSIM_CRC:
+	case DPU_EVT_DSIM_ECC:
+	case DPU_EVT_TE_INTERRUPT:
+		return DPU_LOG_DATA_SIZE(value);
+	case DPU_EVT_ATOMIC_COMMIT:
+		return DPU_LOG_DATA_SIZE(atomic);
+	case DPU_EVT_DSIM_COMMAND:
+		return DPU_LOG_DATA_SIZE(cmd);
+	default:
+		return 0;
+	}
+}
+
+/*
+ * Event log records are written without any locking. Each writer reserves space for its
+ * record in the ring by moving the head and claims a sequence number, records never wrap
+ * around the end of the ring. The record sequence is cleared while it's being written and
+ * only set once all data is in place, so that readers can detect records which are torn or
+ * overwritten.
+ */
+static struct dpu_log *dpu_event_log_begin(struct decon_device *decon, enum dpu_event_type type,
+					   u32 *seq)
+{
+	const u32 ring_size = decon->d.event_log_size;
+	const u32 size = ALIGN(DPU_LOG_HDR_SIZE + dpu_event_data_size(type), DPU_EVENT_LOG_ALIGN);
+	struct dpu_log *log;
+	u32 head, pos;
+
+	do {
+		head = (u32)atomic_read(&decon->d.event_log_head);
+		pos = head;
+		/* skip remaining space at the end of ring if record doesn't fit */
+		if ((pos % ring_size) + size > ring_size)
+			pos = round_up(pos, ring_size);
+	} while (atomic_cmpxchg(&decon->d.event_log_head, head, pos + size) != head);
+
+	*seq = (u32)atomic_inc_return(&decon->d.event_log_idx);
+	log = decon->d.event_log + (pos % ring_size);
+
+	WRITE_ONCE(log->seq, 0);
+	/* make sure record is marked invalid before data is updated */
+	smp_wmb();
+	WRITE_ONCE(decon->d.event_log_pos[*seq % decon->d.event_log_cnt], pos);
+
+	log->size = size;
+	log->type = DPU_EVT_NONE;
+	log->time = ktime_get();
+
+	return log;
+}
+
+static void dpu_event_log_commit(struct decon_device *decon, struct dpu_log *log,
+				 enum dpu_event_type type, u32 seq)
+{
+	log->type = type;
+	/* make sure data is visible before record is marked valid */
+	smp_wmb();
+	WRITE_ONCE(log->seq, seq + 1);
+
+	if (READ_ONCE(decon->d.last_event_type) == type) {
+		WRITE_ONCE(decon->d.last_event_repeat_cnt, decon->d.last_event_repeat_cnt + 1);
+	} else {
+		WRITE_ONCE(decon->d.last_event_type, type);
+		WRITE_ONCE(decon->d.last_event_repeat_cnt, 1);
 	}
+}
 
-	return true;
+/*
+ * Copy event log record with sequence number @seq into @out. Returns false if the record is
+ * missing, still being written or was already overwritten by newer ones.
+ */
+static bool dpu_event_log_read(const struct decon_device *decon, u32 seq, struct dpu_log *out)
+{
+	const u32 pos = READ_ONCE(decon->d.event_log_pos[seq % decon->d.event_log_cnt]);
+	const struct dpu_log *log = decon->d.event_log + (pos % decon->d.event_log_size);
+	u32 seq_begin, seq_end, head;
+	u16 size;
+
+	seq_begin = READ_ONCE(log->seq);
+	/* read record data only after sequence */
+	smp_rmb();
+	size = READ_ONCE(log->size);
+	if (seq_begin != seq + 1 || size < DPU_LOG_HDR_SIZE || size > sizeof(*out))
+		return false;
+
+	memcpy(out, log, size);
+	/* read sequence and head again only after data */
+	smp_rmb();
+	seq_end = READ_ONCE(log->seq);
+	head = (u32)atomic_read(&decon->d.event_log_head);
+
+	/* newer records may have been written over this one without touching its header */
+	return seq_begin == seq_end && (head - pos) <= decon->d.event_log_size;
 }
 
 #if IS_ENABLED(CONFIG_ARM_EXYNOS_DEVFREQ)
@@ -110,8 +251,7 @@ void DPU_EVENT_LOG(enum dpu_event_type type, int index, void *priv)
 	const struct drm_format_info *fb_format;
 	struct exynos_partial *partial;
 	struct drm_rect *partial_region;
-	unsigned long flags;
-	int idx;
+	u32 seq;
 	bool skip_excessive = true;
 
 	if (index < 0 || index >= MAX_DECON_CNT) {
@@ -163,13 +303,7 @@ void DPU_EVENT_LOG(enum dpu_event_type type, int index, void *priv)
 	if (skip_excessive && dpu_event_ignore(type, decon))
 		return;
 
-	spin_lock_irqsave(&decon->d.event_lock, flags);
-	idx = atomic_inc_return(&decon->d.event_log_idx) % dpu_event_log_max;
-	log = &decon->d.event_log[idx];
-	log->type = DPU_EVT_NONE;
-	spin_unlock_irqrestore(&decon->d.event_lock, flags);
-
-	log->time = ktime_get();
+	log = dpu_event_log_begin(decon, type, &seq);
 
 	switch (type) {
 	case DPU_EVT_DPP_FRAMEDONE:
@@ -298,7 +432,7 @@ void DPU_EVENT_LOG(enum dpu_event_type type, int index, void *priv)
 		break;
 	}
 
-	log->type = type;
+	dpu_event_log_commit(decon, log, type, seq);
 }
 
 /*
@@ -312,8 +446,8 @@ void DPU_EVENT_LOG_ATOMIC_COMMIT(int index)
 {
 	struct decon_device *decon;
 	struct dpu_log *log;
-	unsigned long flags;
-	int idx, i, dpp_ch;
+	u32 seq;
+	int i, dpp_ch;
 
 	if (index < 0) {
 		DRM_ERROR("%s: decon id is not valid(%d)\n", __func__, index);
@@ -325,13 +459,7 @@ void DPU_EVENT_LOG_ATOMIC_COMMIT(int index)
 	if (IS_ERR_OR_NULL(decon->d.event_log))
 		return;
 
-	spin_lock_irqsave(&decon->d.event_lock, flags);
-	idx = atomic_inc_return(&decon->d.event_log_idx) % dpu_event_log_max;
-	log = &decon->d.event_log[idx];
-	log->type = DPU_EVT_NONE;
-	spin_unlock_irqrestore(&decon->d.event_lock, flags);
-
-	log->time = ktime_get();
+	log = dpu_event_log_begin(decon, DPU_EVT_ATOMIC_COMMIT, &seq);
 
 	decon->d.auto_refresh_frames = 0;
 
@@ -351,36 +479,11 @@ void DPU_EVENT_LOG_ATOMIC_COMMIT(int index)
 	memcpy(&log->data.atomic.rcd_win_config, &decon->bts.rcd_win_config,
 	       sizeof(log->data.atomic.rcd_win_config));
 
-	log->type = DPU_EVT_ATOMIC_COMMIT;
+	dpu_event_log_commit(decon, log, DPU_EVT_ATOMIC_COMMIT, seq);
 }
 
 extern void *return_address(unsigned int);
 
-static struct dpu_log *dpu_event_get_next(struct decon_device *decon)
-{
-	struct dpu_log *log;
-	unsigned long flags;
-	int idx;
-
-	if (!decon) {
-		pr_err("%s: invalid decon\n", __func__);
-		return NULL;
-	}
-
-	if (IS_ERR_OR_NULL(decon->d.event_log))
-		return NULL;
-
-	spin_lock_irqsave(&decon->d.event_lock, flags);
-	idx = atomic_inc_return(&decon->d.event_log_idx) % dpu_event_log_max;
-	log = &decon->d.event_log[idx];
-	log->type = DPU_EVT_NONE;
-	spin_unlock_irqrestore(&decon->d.event_lock, flags);
-
-	log->time = ktime_get();
-
-	return log;
-}
-
 /*
  * DPU_EVENT_LOG_CMD() - store DSIM command information
  * @index: event log index
@@ -397,10 +500,18 @@ DPU_EVENT_LOG_CMD(struct dsim_device *dsim, u8 type, u8 d0, u16 len)
 {
 	int i;
 	struct decon_device *decon = (struct decon_device *)dsim_get_decon(dsim);
-	struct dpu_log *log = dpu_event_get_next(decon);
+	struct dpu_log *log;
+	u32 seq;
 
-	if (!log)
+	if (!decon) {
+		pr_err("%s: invalid decon\n", __func__);
 		return;
+	}
+
+	if (IS_ERR_OR_NULL(decon->d.event_log))
+		return;
+
+	log = dpu_event_log_begin(decon, DPU_EVT_DSIM_COMMAND, &seq);
 
 	log->data.cmd.id = type;
 	log->data.cmd.d0 = d0;
@@ -410,7 +521,7 @@ DPU_EVENT_LOG_CMD(struct dsim_device *dsim, u8 type, u8 d0, u16 len)
 		log->data.cmd.caller[i] =
 			(void *)((size_t)return_address(i + 1));
 
-	log->type = DPU_EVT_DSIM_COMMAND;
+	dpu_event_log_commit(decon, log, DPU_EVT_DSIM_COMMAND, seq);
 }
 
 static void dpu_print_log_win_config(const struct decon_win_config *const win_config, int index,
@@ -712,42 +823,37 @@ static bool is_skip_dpu_event_dump(enum dpu_event_type type, enum dpu_event_cond
 static void dpu_event_log_print(const struct decon_device *decon, struct drm_printer *p,
 				size_t max_logs, enum dpu_event_condition condition)
 {
-	int idx = atomic_read(&decon->d.event_log_idx);
-	struct decon_device *decon_dev = (struct decon_device *)decon;
+	const u32 latest = (u32)atomic_read(&decon->d.event_log_idx);
+	u32 seq;
 	struct dpu_log dump_log;
 	struct dpu_log *log = &dump_log;
-	int latest = idx % dpu_event_log_max;
 	struct timespec64 ts;
 	const char *str_comp;
 	char buf[LOG_BUF_SIZE];
 	const struct dpu_fmt *fmt;
+	size_t i;
 	int len;
-	unsigned long flags;
 
-	if (IS_ERR_OR_NULL(decon_dev->d.event_log))
+	if (IS_ERR_OR_NULL(decon->d.event_log))
+		return;
+
+	if (max_logs > decon->d.event_log_cnt)
+		max_logs = decon->d.event_log_cnt;
+
+	if (!max_logs)
 		return;
 
 	drm_printf(p, "----------------------------------------------------\n");
 	drm_printf(p, "%14s  %20s  %20s\n", "Time", "Event ID", "Remarks");
 	drm_printf(p, "----------------------------------------------------\n");
 
-	/* Seek a oldest from current index */
-	if (max_logs > dpu_event_log_max)
-		max_logs = dpu_event_log_max;
+	/* Seek a oldest from current sequence, at most one pass of the ring */
+	for (i = 0; i < max_logs; i++) {
+		seq = latest - max_logs + 1 + i;
 
-	if (idx < max_logs)
-		idx = 0;
-	else
-		idx = (idx - max_logs) % dpu_event_log_max;
-
-	do {
-		if (++idx >= dpu_event_log_max)
-			idx = 0;
-
-		/* Seek a index and copy log for dump */
-		spin_lock_irqsave(&decon_dev->d.event_lock, flags);
-		memcpy(&dump_log, &decon_dev->d.event_log[idx], sizeof(dump_log));
-		spin_unlock_irqrestore(&decon_dev->d.event_lock, flags);
+		/* copy log for dump, skip entries which are empty or being overwritten */
+		if (!dpu_event_log_read(decon, seq, log))
+			continue;
 
 		if (is_skip_dpu_event_dump(log->type, condition))
 			continue;
@@ -755,10 +861,6 @@ static void dpu_event_log_print(const struct decon_device *decon, struct drm_pri
 		/* TIME */
 		ts = ktime_to_timespec64(log->time);
 
-		/* If there is no timestamp, then exit directly */
-		if (!ts.tv_sec)
-			break;
-
 		len = scnprintf(buf, sizeof(buf), "[%6lld.%06ld] %20s", ts.tv_sec,
 				ts.tv_nsec / NSEC_PER_USEC, get_event_name(log->type));
 
@@ -904,7 +1006,7 @@ static void dpu_event_log_print(const struct decon_device *decon, struct drm_pri
 		default:
 			break;
 		}
-	} while (latest != idx);
+	}
 
 	drm_printf(p, "----------------------------------------------------\n");
 }
@@ -914,7 +1016,7 @@ static int dpu_debug_event_show(struct seq_file *s, void *unused)
 	struct decon_device *decon = s->private;
 	struct drm_printer p = drm_seq_file_printer(s);
 
-	dpu_event_log_print(decon, &p, dpu_event_log_max, DPU_EVT_CONDITION_DEFAULT);
+	dpu_event_log_print(decon, &p, decon->d.event_log_cnt, DPU_EVT_CONDITION_DEFAULT);
 	return 0;
 }
 
@@ -930,6 +1032,60 @@ static const struct file_operations dpu_event_fops = {
 	.release = seq_release,
 };
 
+/*
+ * Streams event log as binary variable length struct dpu_log records, each record starts with
+ * its size. File position is the sequence number of next record to be read, readers falling
+ * behind the log skip ahead to oldest available record.
+ */
+static ssize_t dpu_event_raw_read(struct file *file, char __user *buf, size_t count,
+				  loff_t *ppos)
+{
+	const struct decon_device *decon = file->private_data;
+	const u32 latest = (u32)atomic_read(&decon->d.event_log_idx);
+	struct dpu_log log;
+	size_t copied = 0;
+	u32 seq, avail;
+
+	if (IS_ERR_OR_NULL(decon->d.event_log))
+		return -ENODEV;
+
+	if (!*ppos)
+		*ppos = (latest + 1) > decon->d.event_log_cnt ?
+			latest + 1 - decon->d.event_log_cnt : 0;
+
+	seq = (u32)*ppos;
+	avail = latest + 1 - seq;
+	if (avail > decon->d.event_log_cnt) {
+		seq = latest + 1 - decon->d.event_log_cnt;
+		avail = decon->d.event_log_cnt;
+	}
+
+	while (avail) {
+		if (dpu_event_log_read(decon, seq, &log)) {
+			if ((count - copied) < log.size)
+				break;
+
+			if (copy_to_user(buf + copied, &log, log.size))
+				return copied ? : -EFAULT;
+
+			copied += log.size;
+		}
+
+		seq++;
+		avail--;
+	}
+
+	*ppos = seq;
+
+	return copied;
+}
+
+static const struct file_operations dpu_event_raw_fops = {
+	.open = simple_open,
+	.read = dpu_event_raw_read,
+	.llseek = no_llseek,
+};
+
 static bool is_dqe_supported(struct drm_device *drm_dev, u32 dqe_id)
 {
 	struct drm_crtc *crtc;
@@ -1299,6 +1455,7 @@ static struct dentry *exynos_debugfs_add_histogram(struct exynos_dqe *dqe,
 	}
 
 	debugfs_create_bool("verbose", 0664, dent, &dqe->verbose_hist);
+	debugfs_create_u32("dropped", 0444, dent, &dqe->hist_dropped_cnt);
 	exynos_debugfs_add_dump(DUMP_TYPE_HISTOGRAM, 0444, dent, 0, 0, drm);
 
 	return dent;
@@ -1404,6 +1561,10 @@ exynos_debugfs_add_dqe(struct exynos_dqe *dqe, struct dentry *parent)
 
 	debugfs_create_bool("force_disabled", 0664, dent_dir,
 			&dqe->force_disabled);
+	debugfs_create_u32("table_applied_cnt", 0444, dent_dir,
+			&dqe->table_applied_cnt);
+	debugfs_create_u32("table_skipped_cnt", 0444, dent_dir,
+			&dqe->table_skipped_cnt);
 
 	return;
 
@@ -1560,10 +1721,217 @@ static const struct file_operations force_te_fops = {
 	.release = seq_release,
 };
 
+static const char * const dpu_commit_stage_names[DPU_COMMIT_STAGE_MAX] = {
+	[DPU_COMMIT_WAIT_FENCES]		= "wait_for_fences",
+	[DPU_COMMIT_MODESET]			= "modeset",
+	[DPU_COMMIT_CONNECTOR_PRE_COMMIT]	= "connector_pre_commit",
+	[DPU_COMMIT_PLANES]			= "commit_planes",
+	[DPU_COMMIT_CONNECTOR_COMMIT]		= "connector_commit",
+	[DPU_COMMIT_WAIT_CRTC_FLIP]		= "wait_for_crtc_flip",
+	[DPU_COMMIT_WAIT_FLIP_DONE]		= "wait_for_flip_done",
+	[DPU_COMMIT_BTS_POST_UPDATE]		= "bts_post_update",
+	[DPU_COMMIT_TAIL]			= "commit_tail",
+};
+
+static void dpu_commit_hist_add(struct decon_device *decon,
+		enum dpu_commit_stage stage, s64 us)
+{
+	struct dpu_commit_hist *hist = &decon->d.commit_hist[stage];
+	u32 bucket;
+
+	if (us < 0)
+		us = 0;
+	bucket = min_t(u32, fls64(us), DPU_COMMIT_HIST_BUCKETS - 1);
+
+	spin_lock(&decon->d.commit_hist_lock);
+	hist->buckets[bucket]++;
+	hist->count++;
+	if (us > hist->max_us)
+		hist->max_us = min_t(s64, us, U32_MAX);
+	spin_unlock(&decon->d.commit_hist_lock);
+}
+
+void dpu_commit_stage_done(struct decon_device *decon,
+		enum dpu_commit_stage stage, ktime_t start)
+{
+	dpu_commit_hist_add(decon, stage, ktime_us_delta(ktime_get(), start));
+}
+
+/* records the stage for every crtc of @state in @crtc_mask */
+void dpu_atomic_commit_stage_done(struct drm_atomic_state *state, u32 crtc_mask,
+		enum dpu_commit_stage stage, ktime_t start)
+{
+	const s64 us = ktime_us_delta(ktime_get(), start);
+	struct drm_crtc_state *new_crtc_state;
+	struct drm_crtc *crtc;
+	int i;
+
+	for_each_new_crtc_in_state(state, crtc, new_crtc_state, i) {
+		if (crtc_mask & drm_crtc_mask(crtc))
+			dpu_commit_hist_add(crtc_to_decon(crtc), stage, us);
+	}
+}
+
+/* upper bound in us of the bucket holding the @pct percentile */
+static u32 dpu_commit_hist_percentile(const struct dpu_commit_hist *hist,
+		u32 pct)
+{
+	u64 target = DIV_ROUND_UP_ULL((u64)hist->count * pct, 100);
+	u64 sum = 0;
+	int i;
+
+	for (i = 0; i < DPU_COMMIT_HIST_BUCKETS - 1; i++) {
+		sum += hist->buckets[i];
+		if (sum >= target)
+			return min_t(u32, 1U << i, hist->max_us);
+	}
+
+	return hist->max_us;
+}
+
+static int commit_latency_show(struct seq_file *s, void *unused)
+{
+	struct decon_device *decon = s->private;
+	struct dpu_commit_hist *hist;
+	int i, j;
+
+	hist = kmalloc_array(DPU_COMMIT_STAGE_MAX, sizeof(*hist), GFP_KERNEL);
+	if (!hist)
+		return -ENOMEM;
+
+	spin_lock(&decon->d.commit_hist_lock);
+	memcpy(hist, decon->d.commit_hist, sizeof(*hist) * DPU_COMMIT_STAGE_MAX);
+	spin_unlock(&decon->d.commit_hist_lock);
+
+	seq_printf(s, "%-22s %10s %10s %10s %10s\n", "stage", "count",
+			"p50(us)", "p99(us)", "max(us)");
+	for (i = 0; i < DPU_COMMIT_STAGE_MAX; i++) {
+		if (!hist[i].count)
+			continue;
+
+		seq_printf(s, "%-22s %10u %10u %10u %10u\n",
+				dpu_commit_stage_names[i], hist[i].count,
+				dpu_commit_hist_percentile(&hist[i], 50),
+				dpu_commit_hist_percentile(&hist[i], 99),
+				hist[i].max_us);
+	}
+
+	seq_puts(s, "\nbuckets(us): <1");
+	for (j = 1; j < DPU_COMMIT_HIST_BUCKETS; j++)
+		seq_printf(s, " <%u", 1U << j);
+	seq_puts(s, " more\n");
+	for (i = 0; i < DPU_COMMIT_STAGE_MAX; i++) {
+		if (!hist[i].count)
+			continue;
+
+		seq_printf(s, "%s:", dpu_commit_stage_names[i]);
+		for (j = 0; j < DPU_COMMIT_HIST_BUCKETS; j++)
+			seq_printf(s, " %u", hist[i].buckets[j]);
+		seq_putc(s, '\n');
+	}
+
+	kfree(hist);
+
+	return 0;
+}
+
+static int commit_latency_open(struct inode *inode, struct file *file)
+{
+	return single_open(file, commit_latency_show, inode->i_private);
+}
+
+/* any write clears the histograms */
+static ssize_t commit_latency_write(struct file *file, const char __user *buf,
+				    size_t count, loff_t *f_pos)
+{
+	struct seq_file *s = file->private_data;
+	struct decon_device *decon = s->private;
+
+	spin_lock(&decon->d.commit_hist_lock);
+	memset(decon->d.commit_hist, 0, sizeof(decon->d.commit_hist));
+	spin_unlock(&decon->d.commit_hist_lock);
+
+	return count;
+}
+
+static const struct file_operations commit_latency_fops = {
+	.open = commit_latency_open,
+	.read = seq_read,
+	.write = commit_latency_write,
+	.llseek = seq_lseek,
+	.release = seq_release,
+};
+
+static int frame_pacing_show(struct seq_file *s, void *unused)
+{
+	struct decon_device *decon = s->private;
+	const struct decon_frame_sched *sched = &decon->frame_sched;
+	u32 waited, wait_max_us, presented, missed, missed_max_us;
+	u64 wait_total_us, missed_total_us;
+	unsigned long flags;
+
+	spin_lock_irqsave(&decon->slock, flags);
+	waited = sched->wait_cnt;
+	wait_max_us = sched->wait_max_us;
+	wait_total_us = sched->wait_total_us;
+	presented = sched->checked_cnt;
+	missed = sched->missed_cnt;
+	missed_max_us = sched->missed_max_us;
+	missed_total_us = sched->missed_total_us;
+	spin_unlock_irqrestore(&decon->slock, flags);
+
+	seq_printf(s, "waited: %u\n", waited);
+	seq_printf(s, "waited avg(us): %llu\n",
+			waited ? div_u64(wait_total_us, waited) : 0);
+	seq_printf(s, "waited max(us): %u\n", wait_max_us);
+	seq_printf(s, "presented: %u\n", presented);
+	seq_printf(s, "missed: %u\n", missed);
+	seq_printf(s, "missed avg(us): %llu\n",
+			missed ? div_u64(missed_total_us, missed) : 0);
+	seq_printf(s, "missed max(us): %u\n", missed_max_us);
+
+	return 0;
+}
+
+static int frame_pacing_open(struct inode *inode, struct file *file)
+{
+	return single_open(file, frame_pacing_show, inode->i_private);
+}
+
+/* any write clears the counters */
+static ssize_t frame_pacing_write(struct file *file, const char __user *buf,
+				  size_t count, loff_t *f_pos)
+{
+	struct seq_file *s = file->private_data;
+	struct decon_device *decon = s->private;
+	struct decon_frame_sched *sched = &decon->frame_sched;
+	unsigned long flags;
+
+	spin_lock_irqsave(&decon->slock, flags);
+	sched->wait_cnt = 0;
+	sched->wait_max_us = 0;
+	sched->wait_total_us = 0;
+	sched->checked_cnt = 0;
+	sched->missed_cnt = 0;
+	sched->missed_max_us = 0;
+	sched->missed_total_us = 0;
+	spin_unlock_irqrestore(&decon->slock, flags);
+
+	return count;
+}
+
+static const struct file_operations frame_pacing_fops = {
+	.open = frame_pacing_open,
+	.read = seq_read,
+	.write = frame_pacing_write,
+	.llseek = seq_lseek,
+	.release = seq_release,
+};
+
 int dpu_init_debug(struct decon_device *decon)
 {
 	int i;
-	u32 event_cnt;
+	u32 event_cnt, event_size = 0;
 	struct drm_crtc *crtc;
 	struct exynos_dqe *dqe = decon->dqe;
 	struct dentry *debug_event;
@@ -1572,21 +1940,31 @@ int dpu_init_debug(struct decon_device *decon)
 	decon->d.event_log = NULL;
 	event_cnt = dpu_event_log_max;
 
+	/*
+	 * ring is sized to hold event_log_max of the largest records, smaller records take up
+	 * less space so many more of them fit. Index holds an offset for each of the smallest
+	 * records with data that can fit in the ring.
+	 */
 	for (i = 0; i < DPU_EVENT_LOG_RETRY; ++i) {
 		event_cnt = event_cnt >> i;
-		decon->d.event_log =
-			vzalloc(sizeof(struct dpu_log) * event_cnt);
+		event_size = rounddown_pow_of_two(sizeof(struct dpu_log) * event_cnt);
+		decon->d.event_log_cnt = event_size / DPU_EVENT_LOG_MIN_SIZE;
+		decon->d.event_log = vzalloc(event_size +
+				sizeof(*decon->d.event_log_pos) * decon->d.event_log_cnt);
 		if (IS_ERR_OR_NULL(decon->d.event_log)) {
 			DRM_WARN("failed to alloc event log buf[%d]. retry\n",
-					event_cnt);
+					event_size);
 			continue;
 		}
 
-		DRM_INFO("#%d event log buffers are allocated\n", event_cnt);
+		DRM_INFO("%d bytes event log buffer is allocated\n", event_size);
 		break;
 	}
-	spin_lock_init(&decon->d.event_lock);
-	decon->d.event_log_cnt = event_cnt;
+	decon->d.event_log_size = event_size;
+	decon->d.event_log_pos = decon->d.event_log + event_size;
+	atomic_set(&decon->d.event_log_head, 0);
+	decon->d.last_event_type = DPU_EVT_NONE;
+	decon->d.last_event_repeat_cnt = 0;
 	atomic_set(&decon->d.event_log_idx, -1);
 
 	kthread_init_work(&decon->buf_dump_work, buf_dump_handler);
@@ -1603,6 +1981,8 @@ int dpu_init_debug(struct decon_device *decon)
 		goto err_event_log;
 	}
 
+	debugfs_create_file("event_raw", 0444, crtc->debugfs_entry, decon, &dpu_event_raw_fops);
+
 	if (decon->hibernation)
 		debugfs_create_file("hibernation", 0664, crtc->debugfs_entry, decon,
 				&hibernation_fops);
@@ -1614,10 +1994,17 @@ int dpu_init_debug(struct decon_device *decon)
 	}
 
 	debugfs_create_file("force_te_on", 0664, crtc->debugfs_entry, decon, &force_te_fops);
+	debugfs_create_file("commit_latency", 0664, crtc->debugfs_entry, decon,
+			&commit_latency_fops);
+	debugfs_create_file("frame_pacing", 0664, crtc->debugfs_entry, decon,
+			&frame_pacing_fops);
 	debugfs_create_u32("underrun_cnt", 0664, crtc->debugfs_entry, &decon->d.underrun_cnt);
 	debugfs_create_u32("crc_cnt", 0444, crtc->debugfs_entry, &decon->d.crc_cnt);
 	debugfs_create_u32("ecc_cnt", 0444, crtc->debugfs_entry, &decon->d.ecc_cnt);
 	debugfs_create_u32("idma_err_cnt", 0444, crtc->debugfs_entry, &decon->d.idma_err_cnt);
+	debugfs_create_u32("bts_cache_hits", 0444, crtc->debugfs_entry, &decon->bts.cache.hits);
+	debugfs_create_u32("bts_cache_misses", 0444, crtc->debugfs_entry,
+			   &decon->bts.cache.misses);
 
 	urgent_dent = debugfs_create_dir("urgent", crtc->debugfs_entry);
 	if (!urgent_dent) {
@@ -1759,6 +2146,8 @@ int exynos_drm_debugfs_plane_add(struct exynos_drm_plane *exynos_plane)
 
 	exynos_plane->debugfs_entry = root;
 
+	debugfs_create_u32("sfr_write_cnt", 0444, root, &dpp->sfr_write_cnt);
+
 	if (test_bit(DPP_ATTR_HDR, &dpp->attr)) {
 		hdr_dent = debugfs_create_dir("hdr", root);
 		if (!hdr_dent)
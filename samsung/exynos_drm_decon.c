@@ -730,66 +730,238 @@ void decon_force_vblank_event(struct decon_device *decon)
 	spin_unlock_irqrestore(&decon->slock, flags);
 }
 
-static void decon_arm_event_locked(struct exynos_drm_crtc *exynos_crtc)
+/* takes the event out of the crtc state, holding a vblank reference for it */
+static struct drm_pending_vblank_event *decon_take_event(struct exynos_drm_crtc *exynos_crtc)
 {
 	struct drm_crtc *crtc = &exynos_crtc->base;
-	struct decon_device *decon = exynos_crtc->ctx;
 	struct drm_pending_vblank_event *event = crtc->state->event;
 
 	if (!event)
-		return;
+		return NULL;
 
 	crtc->state->event = NULL;
+	WARN_ON(drm_crtc_vblank_get(crtc) != 0);
+
+	return event;
+}
+
+static void decon_arm_event_locked(struct decon_device *decon,
+				   struct drm_pending_vblank_event *event)
+{
+	if (!event)
+		return;
 
 	/* in the rare case that event wasn't signaled before, signal it now */
 	if (WARN_ON(decon->event))
 		decon_send_vblank_event_locked(decon);
 
-	WARN_ON(drm_crtc_vblank_get(crtc) != 0);
 	decon->event = event;
 }
 
+static void decon_update_frame_lat_rate(struct decon_device *decon,
+		const struct drm_crtc_state *crtc_state,
+		const struct exynos_drm_connector_state *exynos_conn_state)
+{
+	enum decon_frame_lat_rate rate;
+	unsigned long flags;
+
+	if (exynos_conn_state && exynos_conn_state->exynos_mode.is_lp_mode) {
+		rate = DECON_FRAME_LAT_LP;
+	} else {
+		switch (drm_mode_vrefresh(&crtc_state->adjusted_mode)) {
+		case 60:
+			rate = DECON_FRAME_LAT_60HZ;
+			break;
+		case 90:
+			rate = DECON_FRAME_LAT_90HZ;
+			break;
+		case 120:
+			rate = DECON_FRAME_LAT_120HZ;
+			break;
+		default:
+			rate = DECON_FRAME_LAT_OTHER;
+			break;
+		}
+	}
+
+	spin_lock_irqsave(&decon->slock, flags);
+	decon->frame_lat.rate = rate;
+	spin_unlock_irqrestore(&decon->slock, flags);
+}
+
+/* returns the latency in us, or -1 if @start isn't set */
+static s64 decon_frame_lat_add_locked(struct decon_device *decon,
+		enum decon_frame_lat_type type, ktime_t start, ktime_t end)
+{
+	struct decon_frame_lat *lat = &decon->frame_lat;
+	struct decon_lat_stat *stat = &lat->stats[lat->rate][type];
+	s64 us;
+
+	if (!start || ktime_before(end, start))
+		return -1;
+
+	us = min_t(s64, ktime_us_delta(end, start), U32_MAX);
+	if (!stat->count || us < stat->min_us)
+		stat->min_us = us;
+	if (us > stat->max_us)
+		stat->max_us = us;
+	stat->total_us += us;
+	stat->count++;
+
+	return us;
+}
+
+static void decon_frame_lat_frame_start_locked(struct decon_device *decon)
+{
+	struct decon_frame_lat *lat = &decon->frame_lat;
+	const ktime_t now = ktime_get();
+	s64 us;
+
+	if (decon->config.mode.op_mode == DECON_COMMAND_MODE) {
+		us = decon_frame_lat_add_locked(decon, DECON_FRAME_LAT_TE_TO_FS,
+				READ_ONCE(lat->te_ts), now);
+		if (us >= 0)
+			DPU_ATRACE_INT_PID("te_to_fs_us", us, decon->thread->pid);
+	}
+
+	us = decon_frame_lat_add_locked(decon, DECON_FRAME_LAT_COMMIT_TO_FS,
+			lat->commit_ts, now);
+	if (us >= 0)
+		DPU_ATRACE_INT_PID("commit_to_fs_us", us, decon->thread->pid);
+	lat->commit_ts = 0;
+
+	lat->fs_ts = now;
+}
+
+static void decon_frame_lat_frame_done_locked(struct decon_device *decon)
+{
+	struct decon_frame_lat *lat = &decon->frame_lat;
+	s64 us;
+
+	us = decon_frame_lat_add_locked(decon, DECON_FRAME_LAT_FS_TO_FD,
+			lat->fs_ts, ktime_get());
+	if (us >= 0)
+		DPU_ATRACE_INT_PID("fs_to_fd_us", us, decon->thread->pid);
+	lat->fs_ts = 0;
+}
+
+static void decon_start_frame_locked(struct decon_device *decon,
+				     struct drm_pending_vblank_event *event)
+{
+	struct decon_frame_sched *sched = &decon->frame_sched;
+
+	decon->frame_lat.commit_ts = ktime_get();
+	decon_reg_start(decon->id, &decon->config);
+	atomic_inc(&decon->frames_pending);
+	decon_arm_event_locked(decon, event);
+
+	sched->check_present = sched->present_time != 0;
+}
+
+/*
+ * The bts vote and the panel commands of the connector commit have to follow
+ * the frame start, so the commit worker stays with the frame and sleeps on an
+ * hrtimer until it can be started. Returns the time slept in us.
+ */
+static u32 decon_wait_frame_process_time(ktime_t process_time)
+{
+	const ktime_t start = ktime_get();
+	ktime_t expires = process_time;
+
+	DPU_ATRACE_BEGIN("wait for earliest process time");
+	set_current_state(TASK_UNINTERRUPTIBLE);
+	schedule_hrtimeout(&expires, HRTIMER_MODE_ABS);
+	DPU_ATRACE_END("wait for earliest process time");
+
+	return min_t(s64, ktime_us_delta(ktime_get(), start), U32_MAX);
+}
+
+/* called on frame start, accounts frames shown a vsync or more past their present time */
+static void decon_frame_sched_check_locked(struct decon_device *decon)
+{
+	struct decon_frame_sched *sched = &decon->frame_sched;
+	s64 late_ns;
+	u32 late_us;
+
+	if (!sched->check_present)
+		return;
+
+	sched->check_present = false;
+	sched->checked_cnt++;
+
+	late_ns = ktime_to_ns(ktime_sub(ktime_get(), sched->present_time));
+	if (late_ns <= sched->vsync_period_ns / 2)
+		return;
+
+	late_us = min_t(s64, div_s64(late_ns, NSEC_PER_USEC), U32_MAX);
+	sched->missed_cnt++;
+	sched->missed_total_us += late_us;
+	sched->missed_max_us = max(sched->missed_max_us, late_us);
+}
+
 #define VSYNC_PERIOD_VARIANCE_NS		2000000
-static void decon_wait_earliest_process_time(
+#define FRAME_PACING_MAX_DELAY_FRAMES		10
+/* returns 0 if the frame can be processed right away */
+static ktime_t decon_get_earliest_process_time(
+		const struct exynos_drm_crtc_state *exynos_crtc_state, int32_t vrefresh)
+{
+	int32_t vsync_period_ns;
+
+	if (vrefresh == 0)
+		return 0;
+
+	vsync_period_ns = mult_frac(1000, 1000 * 1000, vrefresh);
+	if (ktime_compare(exynos_crtc_state->expected_present_time,
+				vsync_period_ns - VSYNC_PERIOD_VARIANCE_NS) <= 0) {
+		return 0;
+	}
+
+	return ktime_sub_ns(exynos_crtc_state->expected_present_time,
+			vsync_period_ns - VSYNC_PERIOD_VARIANCE_NS);
+}
+
+/*
+ * Returns the time the frame has to be started at, or 0 if it can be started
+ * right away. @vsync_period_ns is set to 0 if the frame has no expected present
+ * time.
+ */
+static ktime_t decon_get_frame_process_time(
 		const struct exynos_drm_crtc_state *old_exynos_crtc_state,
-		const struct exynos_drm_crtc_state *new_exynos_crtc_state)
+		const struct exynos_drm_crtc_state *new_exynos_crtc_state,
+		u32 *vsync_period_ns)
 {
 	const struct drm_crtc_state *old_crtc_state = &old_exynos_crtc_state->base;
 	const struct drm_crtc_state *new_crtc_state = &new_exynos_crtc_state->base;
-	int32_t vrefresh, vsync_period_ns;
+	int32_t vrefresh;
+	s64 max_delay_ns;
 	ktime_t earliest_process_time, now;
 
+	*vsync_period_ns = 0;
+
 	vrefresh = drm_mode_vrefresh(&old_crtc_state->mode);
 	if (vrefresh == 0) {
 		/* decon just be enabled */
 		vrefresh = drm_mode_vrefresh(&new_crtc_state->mode);
 	}
-	vsync_period_ns = mult_frac(1000, 1000 * 1000, vrefresh);
-	if (ktime_compare(new_exynos_crtc_state->expected_present_time,
-				vsync_period_ns - VSYNC_PERIOD_VARIANCE_NS) <= 0) {
-		return;
-	}
+	earliest_process_time = decon_get_earliest_process_time(new_exynos_crtc_state,
+					vrefresh);
+	if (!earliest_process_time)
+		return 0;
 
-	earliest_process_time = ktime_sub_ns(new_exynos_crtc_state->expected_present_time,
-					vsync_period_ns - VSYNC_PERIOD_VARIANCE_NS);
+	*vsync_period_ns = mult_frac(1000, 1000 * 1000, vrefresh);
 	now = ktime_get();
 
-	if (ktime_after(earliest_process_time, now)) {
-		int32_t max_delay_us = (10 * vsync_period_ns) / 1000;
-		int32_t delay_until_process;
-
-		DPU_ATRACE_BEGIN("wait for earliest present time");
-
-		delay_until_process = (int32_t)ktime_us_delta(earliest_process_time, now);
-		if (delay_until_process > max_delay_us) {
-			delay_until_process = max_delay_us;
-			pr_warn("expected present time seems incorrect(now %llu, earliest %llu)\n",
-					now, earliest_process_time);
-		}
-		usleep_range(delay_until_process, delay_until_process + 10);
+	if (!ktime_after(earliest_process_time, now))
+		return 0;
 
-		DPU_ATRACE_END("wait for earliest process time");
+	max_delay_ns = (s64)FRAME_PACING_MAX_DELAY_FRAMES * *vsync_period_ns;
+	if (ktime_to_ns(ktime_sub(earliest_process_time, now)) > max_delay_ns) {
+		pr_warn("expected present time seems incorrect(now %llu, earliest %llu)\n",
+				now, earliest_process_time);
+		earliest_process_time = ktime_add_ns(now, max_delay_ns);
 	}
+
+	return earliest_process_time;
 }
 
 static void decon_atomic_flush(struct exynos_drm_crtc *exynos_crtc,
@@ -803,7 +975,10 @@ static void decon_atomic_flush(struct exynos_drm_crtc *exynos_crtc,
 					to_exynos_crtc_state(old_crtc_state);
 	struct exynos_dqe *dqe = decon->dqe;
 	struct exynos_partial *partial = decon->partial;
-	u32 width, height;
+	struct decon_frame_sched *sched = &decon->frame_sched;
+	struct drm_pending_vblank_event *event = NULL;
+	ktime_t process_time;
+	u32 width, height, vsync_period_ns, wait_us = 0;
 	unsigned long flags;
 
 	decon_debug(decon, "%s +\n", __func__);
@@ -886,13 +1061,35 @@ static void decon_atomic_flush(struct exynos_drm_crtc *exynos_crtc,
 	if (new_exynos_crtc_state->seamless_mode_changed)
 		decon_seamless_mode_set(exynos_crtc, old_crtc_state);
 
-	decon_wait_earliest_process_time(old_exynos_crtc_state, new_exynos_crtc_state);
+	process_time = decon_get_frame_process_time(old_exynos_crtc_state,
+			new_exynos_crtc_state, &vsync_period_ns);
+
+	if (process_time) {
+		DPU_ATRACE_INT("frame_pacing_delay_us",
+				ktime_us_delta(process_time, ktime_get()));
+		wait_us = decon_wait_frame_process_time(process_time);
+	}
+
+	/*
+	 * the raise vote of a paced frame was issued one dvfs latency ahead of
+	 * its process time by the bts pre-vote timer, make sure it landed
+	 */
+	if (IS_ENABLED(CONFIG_EXYNOS_BTS))
+		decon->bts.ops->flush_bw(decon);
 
-	spin_lock_irqsave(&decon->slock, flags);
-	decon_reg_start(decon->id, &decon->config);
-	atomic_inc(&decon->frames_pending);
 	if (!new_crtc_state->no_vblank)
-		decon_arm_event_locked(exynos_crtc);
+		event = decon_take_event(exynos_crtc);
+
+	spin_lock_irqsave(&decon->slock, flags);
+	sched->present_time = vsync_period_ns ?
+			new_exynos_crtc_state->expected_present_time : 0;
+	sched->vsync_period_ns = vsync_period_ns;
+	if (process_time) {
+		sched->wait_cnt++;
+		sched->wait_total_us += wait_us;
+		sched->wait_max_us = max(sched->wait_max_us, wait_us);
+	}
+	decon_start_frame_locked(decon, event);
 	spin_unlock_irqrestore(&decon->slock, flags);
 
 	DPU_EVENT_LOG(DPU_EVT_ATOMIC_FLUSH, decon->id, NULL);
@@ -1057,6 +1254,7 @@ void decon_mode_bts_pre_update(struct decon_device *decon,
 				const struct drm_atomic_state *old_state)
 {
 	const struct exynos_drm_crtc_state *exynos_crtc_state = to_exynos_crtc_state(crtc_state);
+	ktime_t earliest_process_time;
 
 	if (exynos_crtc_state->seamless_mode_changed) {
 		unsigned int vblank_usec = decon_get_vblank_usec(crtc_state, old_state);
@@ -1071,7 +1269,13 @@ void decon_mode_bts_pre_update(struct decon_device *decon,
 	}
 
 	decon->bts.ops->calc_bw(decon);
-	decon->bts.ops->update_bw(decon, false);
+
+	earliest_process_time = decon_get_earliest_process_time(exynos_crtc_state,
+					drm_mode_vrefresh(&crtc_state->mode));
+	if (earliest_process_time)
+		decon->bts.ops->schedule_bw(decon, earliest_process_time);
+	else
+		decon->bts.ops->update_bw(decon, false);
 }
 #endif
 
@@ -1092,6 +1296,9 @@ static void decon_seamless_mode_set(struct exynos_drm_crtc *exynos_crtc,
 
 	decon_debug(decon, "seamless mode set to %s\n", mode->name);
 
+	decon_update_frame_lat_rate(decon, crtc_state,
+			crtc_get_exynos_connector_state(old_state, crtc_state));
+
 	for_each_new_connector_in_state(old_state, conn, conn_state, i) {
 		const struct drm_encoder_helper_funcs *funcs;
 		struct drm_encoder *encoder;
@@ -1241,6 +1448,7 @@ static void decon_enable(struct exynos_drm_crtc *exynos_crtc, struct drm_crtc_st
 			crtc_get_exynos_connector_state(state, crtc_state);
 
 		decon_update_config(&decon->config, crtc_state, exynos_conn_state);
+		decon_update_frame_lat_rate(decon, crtc_state, exynos_conn_state);
 
 		if (decon_is_te_enabled(decon))
 			decon_request_te_irq(exynos_crtc, exynos_conn_state);
@@ -1514,6 +1722,68 @@ static ssize_t early_wakeup_store(struct device *dev,
 }
 static DEVICE_ATTR_RW(early_wakeup);
 
+static const char * const frame_lat_rate_names[DECON_FRAME_LAT_RATE_MAX] = {
+	[DECON_FRAME_LAT_60HZ]	= "60hz",
+	[DECON_FRAME_LAT_90HZ]	= "90hz",
+	[DECON_FRAME_LAT_120HZ]	= "120hz",
+	[DECON_FRAME_LAT_LP]	= "lp",
+	[DECON_FRAME_LAT_OTHER]	= "other",
+};
+
+static const char * const frame_lat_type_names[DECON_FRAME_LAT_TYPE_MAX] = {
+	[DECON_FRAME_LAT_TE_TO_FS]	= "te_to_fs",
+	[DECON_FRAME_LAT_FS_TO_FD]	= "fs_to_fd",
+	[DECON_FRAME_LAT_COMMIT_TO_FS]	= "commit_to_fs",
+};
+
+static ssize_t frame_latency_show(struct device *dev,
+			struct device_attribute *attr, char *buf)
+{
+	struct decon_device *decon = dev_get_drvdata(dev);
+	struct decon_lat_stat stats[DECON_FRAME_LAT_RATE_MAX][DECON_FRAME_LAT_TYPE_MAX];
+	unsigned long flags;
+	ssize_t len;
+	int i, j;
+
+	spin_lock_irqsave(&decon->slock, flags);
+	memcpy(stats, decon->frame_lat.stats, sizeof(stats));
+	spin_unlock_irqrestore(&decon->slock, flags);
+
+	len = scnprintf(buf, PAGE_SIZE, "%-6s %-13s %8s %8s %8s %8s\n", "rate",
+			"latency", "count", "avg(us)", "min(us)", "max(us)");
+	for (i = 0; i < DECON_FRAME_LAT_RATE_MAX; i++) {
+		for (j = 0; j < DECON_FRAME_LAT_TYPE_MAX; j++) {
+			const struct decon_lat_stat *stat = &stats[i][j];
+
+			if (!stat->count)
+				continue;
+
+			len += scnprintf(buf + len, PAGE_SIZE - len,
+					"%-6s %-13s %8u %8llu %8u %8u\n",
+					frame_lat_rate_names[i], frame_lat_type_names[j],
+					stat->count, div_u64(stat->total_us, stat->count),
+					stat->min_us, stat->max_us);
+		}
+	}
+
+	return len;
+}
+
+/* any write clears the statistics */
+static ssize_t frame_latency_store(struct device *dev,
+			struct device_attribute *attr, const char *buf, size_t len)
+{
+	struct decon_device *decon = dev_get_drvdata(dev);
+	unsigned long flags;
+
+	spin_lock_irqsave(&decon->slock, flags);
+	memset(decon->frame_lat.stats, 0, sizeof(decon->frame_lat.stats));
+	spin_unlock_irqrestore(&decon->slock, flags);
+
+	return len;
+}
+static DEVICE_ATTR_RW(frame_latency);
+
 static int decon_bind(struct device *dev, struct device *master, void *data)
 {
 	struct decon_device *decon = dev_get_drvdata(dev);
@@ -1566,6 +1836,7 @@ static int decon_bind(struct device *dev, struct device *master, void *data)
 	}
 
 	device_create_file(dev, &dev_attr_early_wakeup);
+	device_create_file(dev, &dev_attr_frame_latency);
 	decon_debug(decon, "%s -\n", __func__);
 	return 0;
 }
@@ -1577,6 +1848,7 @@ static void decon_unbind(struct device *dev, struct device *master,
 
 	decon_debug(decon, "%s +\n", __func__);
 	device_remove_file(dev, &dev_attr_early_wakeup);
+	device_remove_file(dev, &dev_attr_frame_latency);
 	if (IS_ENABLED(CONFIG_EXYNOS_BTS))
 		decon->bts.ops->deinit(decon);
 
@@ -1592,9 +1864,15 @@ static const struct component_ops decon_component_ops = {
 static irqreturn_t decon_irq_handler(int irq, void *dev_data)
 {
 	struct decon_device *decon = dev_data;
-	u32 irq_sts_reg;
+	const ktime_t entry = ktime_get();
+	u32 irq_sts_reg = 0;
 	u32 ext_irq = 0;
 
+	/*
+	 * DPU_ATRACE slices would land on whatever task was interrupted, use
+	 * dedicated tracepoints for the handler latency instead.
+	 */
+	trace_dpu_decon_irq_entry(decon->id);
 	spin_lock(&decon->slock);
 	if (decon->state != DECON_STATE_ON)
 		goto irq_end;
@@ -1605,6 +1883,7 @@ static irqreturn_t decon_irq_handler(int irq, void *dev_data)
 
 	if (irq_sts_reg & DPU_FRAME_DONE_INT_PEND) {
 		DPU_EVENT_LOG(DPU_EVT_DECON_FRAMEDONE, decon->id, decon);
+		decon_frame_lat_frame_done_locked(decon);
 		exynos_dqe_save_lpd_data(decon->dqe);
 		if (decon->dqe)
 			handle_histogram_event(decon->dqe);
@@ -1642,6 +1921,8 @@ static irqreturn_t decon_irq_handler(int irq, void *dev_data)
 
 irq_end:
 	spin_unlock(&decon->slock);
+	trace_dpu_decon_irq_exit(decon->id, irq_sts_reg, ext_irq,
+			ktime_to_ns(ktime_sub(ktime_get(), entry)));
 	return IRQ_HANDLED;
 }
 
@@ -1656,6 +1937,8 @@ static bool decon_check_fs_pending_locked(struct decon_device *decon)
 
 	if (pending_irq & DPU_FRAME_START_INT_PEND) {
 		DPU_EVENT_LOG(DPU_EVT_DECON_FRAMESTART, decon->id, decon);
+		decon_frame_sched_check_locked(decon);
+		decon_frame_lat_frame_start_locked(decon);
 		decon_send_vblank_event_locked(decon);
 		if (decon->config.mode.op_mode == DECON_VIDEO_MODE)
 			drm_crtc_handle_vblank(&decon->crtc->base);
@@ -1758,88 +2041,97 @@ static int decon_parse_dt(struct decon_device *decon, struct device_node *np)
 		}
 	}
 
-	if (of_property_read_u32(np, "ppc", (u32 *)&decon->bts.ppc))
-		decon->bts.ppc = 2UL;
-	decon_info(decon, "PPC(%llu)\n", decon->bts.ppc);
+	if (of_property_read_u32(np, "ppc", (u32 *)&decon->bts.params.ppc))
+		decon->bts.params.ppc = 2UL;
+	decon_info(decon, "PPC(%llu)\n", decon->bts.params.ppc);
 
 	if (of_property_read_u32(np, "ppc_rotator",
-					(u32 *)&decon->bts.ppc_rotator)) {
-		decon->bts.ppc_rotator = 4U;
+					(u32 *)&decon->bts.params.ppc_rotator)) {
+		decon->bts.params.ppc_rotator = 4U;
 		decon_warn(decon, "WARN: rotator ppc is not defined in DT.\n");
 	}
-	decon_info(decon, "rotator ppc(%d)\n", decon->bts.ppc_rotator);
+	decon_info(decon, "rotator ppc(%d)\n", decon->bts.params.ppc_rotator);
 
 	if (of_property_read_u32(np, "ppc_scaler",
-					(u32 *)&decon->bts.ppc_scaler)) {
-		decon->bts.ppc_scaler = 2U;
+					(u32 *)&decon->bts.params.ppc_scaler)) {
+		decon->bts.params.ppc_scaler = 2U;
 		decon_warn(decon, "WARN: scaler ppc is not defined in DT.\n");
 	}
-	decon_info(decon, "scaler ppc(%d)\n", decon->bts.ppc_scaler);
+	decon_info(decon, "scaler ppc(%d)\n", decon->bts.params.ppc_scaler);
 
 	if (of_property_read_u32(np, "delay_comp",
-				(u32 *)&decon->bts.delay_comp)) {
-		decon->bts.delay_comp = 4UL;
+				(u32 *)&decon->bts.params.delay_comp)) {
+		decon->bts.params.delay_comp = 4UL;
 		decon_warn(decon, "WARN: comp line delay is not defined in DT.\n");
 	}
-	decon_info(decon, "line delay comp(%d)\n", decon->bts.delay_comp);
+	decon_info(decon, "line delay comp(%d)\n", decon->bts.params.delay_comp);
 
 	if (of_property_read_u32(np, "delay_scaler",
-				(u32 *)&decon->bts.delay_scaler)) {
-		decon->bts.delay_scaler = 2UL;
+				(u32 *)&decon->bts.params.delay_scaler)) {
+		decon->bts.params.delay_scaler = 2UL;
 		decon_warn(decon, "WARN: scaler line delay is not defined in DT.\n");
 	}
-	decon_info(decon, "line delay scaler(%d)\n", decon->bts.delay_scaler);
+	decon_info(decon, "line delay scaler(%d)\n", decon->bts.params.delay_scaler);
 
-	if (of_property_read_u32(np, "bus_width", &decon->bts.bus_width)) {
-		decon->bts.bus_width = 16;
+	if (of_property_read_u32(np, "bus_width", &decon->bts.params.bus_width)) {
+		decon->bts.params.bus_width = 16;
 		decon_warn(decon, "WARN: bus_width is not defined in DT.\n");
 	}
-	if (of_property_read_u32(np, "bus_util", &decon->bts.bus_util_pct)) {
-		decon->bts.bus_util_pct = 65;
+	if (of_property_read_u32(np, "bus_util", &decon->bts.params.bus_util_pct)) {
+		decon->bts.params.bus_util_pct = 65;
 		decon_debug(decon, "WARN: bus_util_pct is not defined in DT.\n");
 	}
-	if (of_property_read_u32(np, "rot_util", &decon->bts.rot_util_pct)) {
-		decon->bts.rot_util_pct = 60;
+	if (of_property_read_u32(np, "rot_util", &decon->bts.params.rot_util_pct)) {
+		decon->bts.params.rot_util_pct = 60;
 		decon_debug(decon, "WARN: rot_util_pct is not defined in DT.\n");
 	}
-	if (of_property_read_u32(np, "afbc_rgb_util_pct", &decon->bts.afbc_rgb_util_pct)) {
-		decon->bts.afbc_rgb_util_pct = 100;
+	if (of_property_read_u32(np, "afbc_rgb_util_pct", &decon->bts.params.afbc_rgb_util_pct)) {
+		decon->bts.params.afbc_rgb_util_pct = 100;
 		decon_debug(decon, "WARN: afbc_rgb_util_pct is not defined in DT.\n");
 	}
-	if (of_property_read_u32(np, "afbc_yuv_util_pct", &decon->bts.afbc_yuv_util_pct)) {
-		decon->bts.afbc_yuv_util_pct = 100;
+	if (of_property_read_u32(np, "afbc_yuv_util_pct", &decon->bts.params.afbc_yuv_util_pct)) {
+		decon->bts.params.afbc_yuv_util_pct = 100;
 		decon_debug(decon, "WARN: afbc_yuv_util_pct is not defined in DT.\n");
 	}
-	if (of_property_read_u32(np, "afbc_rgb_rt_util_pct", &decon->bts.afbc_rgb_rt_util_pct)) {
-		decon->bts.afbc_rgb_rt_util_pct = 100;
+	if (of_property_read_u32(np, "afbc_rgb_rt_util_pct", &decon->bts.params.afbc_rgb_rt_util_pct)) {
+		decon->bts.params.afbc_rgb_rt_util_pct = 100;
 		decon_debug(decon, "WARN: afbc_rgb_rt_util_pct is not defined in DT.\n");
 	}
-	if (of_property_read_u32(np, "afbc_yuv_rt_util_pct", &decon->bts.afbc_yuv_rt_util_pct)) {
-		decon->bts.afbc_yuv_rt_util_pct = 100;
+	if (of_property_read_u32(np, "afbc_yuv_rt_util_pct", &decon->bts.params.afbc_yuv_rt_util_pct)) {
+		decon->bts.params.afbc_yuv_rt_util_pct = 100;
 		decon_debug(decon, "WARN: afbc_yuv_rt_util_pct is not defined in DT.\n");
 	}
 
 	decon_debug(decon, "bus_width(%u) bus_util(%u) rot_util(%u)\n",
-			decon->bts.bus_width, decon->bts.bus_util_pct,
-			decon->bts.rot_util_pct);
+			decon->bts.params.bus_width, decon->bts.params.bus_util_pct,
+			decon->bts.params.rot_util_pct);
 
 	decon_debug(decon, "afbc: rgb_util(%u) yuv_util(%u) rgb_rt_util(%u) yuv_rt_util(%u)\n",
-			decon->bts.afbc_rgb_util_pct, decon->bts.afbc_yuv_util_pct,
-			decon->bts.afbc_rgb_rt_util_pct, decon->bts.afbc_yuv_rt_util_pct);
+			decon->bts.params.afbc_rgb_util_pct, decon->bts.params.afbc_yuv_util_pct,
+			decon->bts.params.afbc_rgb_rt_util_pct, decon->bts.params.afbc_yuv_rt_util_pct);
+
+	if (of_property_read_u32(np, "dvfs_latency_us", &decon->bts.dvfs_latency_us))
+		decon->bts.dvfs_latency_us = 1000;
+	if (of_property_read_u32(np, "bw_release_hysteresis_ms",
+				&decon->bts.release_hysteresis_ms))
+		decon->bts.release_hysteresis_ms = 20;
+
+	decon_debug(decon, "dvfs_latency(%uus) bw_release_hysteresis(%ums)\n",
+			decon->bts.dvfs_latency_us, decon->bts.release_hysteresis_ms);
 
 	if (of_property_read_u32(np, "dfs_lv_cnt", &dfs_lv_cnt)) {
 		err_flag = true;
 		dfs_lv_cnt = 1;
-		decon->bts.dfs_lv_khz[0] = 400000U; /* 400Mhz */
+		decon->bts.params.dfs_lv_khz[0] = 400000U; /* 400Mhz */
 		decon_warn(decon, "WARN: DPU DFS Info is not defined in DT.\n");
 	}
-	decon->bts.dfs_lv_cnt = dfs_lv_cnt;
+	decon->bts.params.dfs_lv_cnt = dfs_lv_cnt;
 
 	if (!err_flag) {
 		of_property_read_u32_array(np, "dfs_lv", dfs_lv_khz, dfs_lv_cnt);
 		decon_info(decon, "DPU DFS Level : ");
 		for (i = 0; i < dfs_lv_cnt; i++) {
-			decon->bts.dfs_lv_khz[i] = dfs_lv_khz[i];
+			decon->bts.params.dfs_lv_khz[i] = dfs_lv_khz[i];
 			decon_info(decon, "%6d ", dfs_lv_khz[i]);
 		}
 		decon_info(decon, "\n");
@@ -1949,6 +2241,7 @@ static irqreturn_t decon_te_irq_handler(int irq, void *dev_id)
 		goto end;
 
 	DPU_EVENT_LOG(DPU_EVT_TE_INTERRUPT, decon->id, NULL);
+	WRITE_ONCE(decon->frame_lat.te_ts, ktime_get());
 	DPU_ATRACE_INT_PID("TE", decon->d.te_cnt++ & 1, decon->thread->pid);
 
 	if (decon->config.dsc.delay_reg_init_us)
@@ -2118,6 +2411,7 @@ static int decon_probe(struct platform_device *pdev)
 	decon_drvdata[decon->id] = decon;
 
 	spin_lock_init(&decon->slock);
+	spin_lock_init(&decon->d.commit_hist_lock);
 	init_waitqueue_head(&decon->framedone_wait);
 	init_completion(&decon->te_rising);
 
@@ -2153,8 +2447,10 @@ static int decon_probe(struct platform_device *pdev)
 		pm_runtime_get_sync(decon->dev);
 
 	ret = component_add(dev, &decon_component_ops);
-	if (ret)
+	if (ret) {
+		exynos_dqe_unregister(decon->dqe);
 		goto err;
+	}
 
 	decon_info(decon, "successfully probed");
 
@@ -2166,6 +2462,8 @@ static int decon_remove(struct platform_device *pdev)
 {
 	struct decon_device *decon = platform_get_drvdata(pdev);
 
+	exynos_dqe_unregister(decon->dqe);
+
 	if (decon->thread)
 		kthread_stop(decon->thread);
 
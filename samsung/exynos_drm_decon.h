@@ -18,6 +18,7 @@
 #include <linux/of_gpio.h>
 #include <linux/clk.h>
 #include <linux/device.h>
+#include <linux/hrtimer.h>
 #include <linux/pm_runtime.h>
 #include <linux/spinlock.h>
 #if IS_ENABLED(CONFIG_EXYNOS_PM_QOS) || IS_ENABLED(CONFIG_EXYNOS_PM_QOS_MODULE)
@@ -33,6 +34,7 @@
 
 #include <decon_cal.h>
 
+#include "exynos_drm_bts_calc.h"
 #include "exynos_drm_dpp.h"
 #include "exynos_drm_dqe.h"
 #include "exynos_drm_drv.h"
@@ -52,12 +54,6 @@ enum decon_state {
 	DECON_STATE_HANDOVER,
 };
 
-enum dpu_win_state {
-	DPU_WIN_STATE_DISABLED = 0,
-	DPU_WIN_STATE_COLOR,
-	DPU_WIN_STATE_BUFFER,
-};
-
 struct decon_resources {
 	struct clk *aclk;
 	struct clk *aclk_disp;
@@ -68,63 +64,32 @@ struct dpu_bts_ops {
 	void (*release_bw)(struct decon_device *decon);
 	void (*calc_bw)(struct decon_device *decon);
 	void (*update_bw)(struct decon_device *decon, bool shadow_updated);
+	void (*schedule_bw)(struct decon_device *decon, ktime_t process_time);
+	void (*flush_bw)(struct decon_device *decon);
 	void (*deinit)(struct decon_device *decon);
 };
 
-struct dpu_bts_bw {
-	u32 val;
-	u32 ch_num;
-};
-
-struct dpu_bts_win_config {
-	enum dpu_win_state state;
-	u32 src_x;
-	u32 src_y;
-	u32 src_w;
-	u32 src_h;
-	int dst_x;
-	int dst_y;
-	u32 dst_w;
-	u32 dst_h;
-	bool is_rot;
-	bool is_comp;
-	bool is_secure;
-	int dpp_ch;
-	u32 format;
-	u64 comp_src;
-};
-
-struct bts_layer_position {
-	u32 x1;
-	u32 x2; /* x2 = x1 + width */
-	u32 y1;
-	u32 y2; /* y2 = y1 + height */
+/* inputs of the bandwidth calculation, other decons bandwidth included in the frame */
+struct dpu_bts_cache_key {
+	struct dpu_bts_disp_info disp;
+	struct dpu_bts_frame frame;
 };
 
-struct bts_dpp_info {
-	u32 bpp;
-	u32 src_h;
-	u32 src_w;
-	struct bts_layer_position dst;
-	u32 bw;
-	u32 rt_bw;
-	bool rotation;
-	bool is_afbc;
-	bool is_yuv;
+struct dpu_bts_cache_entry {
+	bool valid;
+	u32 hash;
+	struct dpu_bts_cache_key key;
+	struct dpu_bts_result res;
 };
 
-struct bts_decon_info {
-	struct bts_dpp_info rdma[MAX_WIN_PER_DECON];
-	struct bts_dpp_info odma;
-	struct bts_dpp_info rcddma;
-	u32 vclk; /* Khz */
-	u32 lcd_w;
-	u32 lcd_h;
-};
+#define BTS_CACHE_SIZE	4
 
-struct decon_win_config {
-	struct dpu_bts_win_config win;
-	dma_addr_t dma_addr;
+struct dpu_bts_cache {
+	struct dpu_bts_cache_entry entries[BTS_CACHE_SIZE];
+	/* next entry to be replaced */
+	u32 next;
+	u32 hits;
+	u32 misses;
 };
 
 struct dpu_bts {
@@ -141,29 +106,13 @@ struct dpu_bts {
 	u32 max_disp_freq;
 	u32 prev_max_disp_freq;
 	u32 dvfs_max_disp_freq;
-	u64 ppc;
-	u32 ppc_rotator;
-	u32 ppc_scaler;
-	u32 delay_comp;
-	u32 delay_scaler;
-	u32 bus_width;
-	u32 bus_util_pct;
-	u32 rot_util_pct;
-	u32 afbc_rgb_util_pct;
-	u32 afbc_yuv_util_pct;
-	u32 afbc_rgb_rt_util_pct;
-	u32 afbc_yuv_rt_util_pct;
-	u32 dfs_lv_cnt;
-	u32 dfs_lv_khz[BTS_DFS_MAX];
+	struct dpu_bts_params params;
 	u32 vbp;
 	u32 vfp;
 	u32 vsa;
 	u32 fps;
 	u32 pending_vblank_usec;
 	u32 vblank_usec;
-	/* includes writeback dpp */
-	struct dpu_bts_bw rt_bw[MAX_DPP_CNT];
-
 	u32 ch_bw[MAX_AXI_PORT];
 	int bw_idx;
 	struct dpu_bts_ops *ops;
@@ -177,6 +126,24 @@ struct dpu_bts {
 	struct dpu_bts_win_config wb_config;
 	struct decon_win_config rcd_win_config;
 	atomic_t delayed_update;
+
+	struct dpu_bts_cache cache;
+
+	/* serializes bandwidth/clock votes against the scheduled ones below */
+	struct mutex vote_lock;
+	/* raise vote issued dvfs_latency_us ahead of the frame process time */
+	u32 dvfs_latency_us;
+	struct hrtimer pre_vote_timer;
+	struct work_struct pre_vote_work;
+	/* bandwidth/clock of the frame the raise vote is scheduled for */
+	struct bts_bw pre_vote_bw;
+	u32 pre_vote_disp_freq;
+	/* lower vote applied once it has been pending for the hysteresis */
+	u32 release_hysteresis_ms;
+	bool release_pending;
+	struct bts_bw release_bw;
+	u32 release_disp_freq;
+	struct delayed_work release_work;
 };
 
 /**
@@ -378,9 +345,18 @@ struct dpu_log_plane_info {
 	u32 format;
 };
 
+/*
+ * Event log record, records are variable in length and only hold the header along with the
+ * data member used by their type.
+ */
 struct dpu_log {
+	/* sequence number of the record + 1, 0 while record is being written */
+	u32 seq;
+	/* size of the record in bytes including header */
+	u16 size;
+	/* enum dpu_event_type */
+	u16 type;
 	ktime_t time;
-	enum dpu_event_type type;
 
 	union {
 		struct dpu_log_dpp dpp;
@@ -404,10 +380,105 @@ struct dpu_log {
 #define DPU_EVENT_LOG_RETRY	3
 #define DPU_EVENT_KEEP_CNT	3
 
+#define DPU_EVENT_LOG_ALIGN	8
+
+/*
+ * Frame pacing: a frame whose expected present time is more than a vsync away
+ * is programmed by atomic_flush right away, then the commit worker sleeps until
+ * its earliest process time before starting it. Frame start checks it against
+ * its present time.
+ */
+struct decon_frame_sched {
+	/* protected by decon->slock */
+	ktime_t present_time;
+	u32 vsync_period_ns;
+	/* frame start of the last started frame has yet to be checked */
+	bool check_present;
+
+	/* frames the commit worker slept for, and how long */
+	u32 wait_cnt;
+	u32 wait_max_us;
+	u64 wait_total_us;
+	u32 checked_cnt;
+	u32 missed_cnt;
+	u32 missed_max_us;
+	u64 missed_total_us;
+};
+
+enum decon_frame_lat_rate {
+	DECON_FRAME_LAT_60HZ,
+	DECON_FRAME_LAT_90HZ,
+	DECON_FRAME_LAT_120HZ,
+	DECON_FRAME_LAT_LP,
+	DECON_FRAME_LAT_OTHER,
+	DECON_FRAME_LAT_RATE_MAX,
+};
+
+enum decon_frame_lat_type {
+	DECON_FRAME_LAT_TE_TO_FS,
+	DECON_FRAME_LAT_FS_TO_FD,
+	DECON_FRAME_LAT_COMMIT_TO_FS,
+	DECON_FRAME_LAT_TYPE_MAX,
+};
+
+struct decon_lat_stat {
+	u32 count;
+	u32 min_us;
+	u32 max_us;
+	u64 total_us;
+};
+
+/*
+ * Per frame latencies of the display pipeline, accounted to the refresh rate
+ * the frame ran at. A timestamp is cleared once the latency it starts has
+ * been accounted, te_ts is only written by the TE irq.
+ */
+struct decon_frame_lat {
+	/* below are protected by decon->slock */
+	enum decon_frame_lat_rate rate;
+	ktime_t commit_ts;
+	ktime_t fs_ts;
+	struct decon_lat_stat stats[DECON_FRAME_LAT_RATE_MAX][DECON_FRAME_LAT_TYPE_MAX];
+
+	ktime_t te_ts;
+};
+
+/* stages of the atomic commit tail timed into per-crtc latency histograms */
+enum dpu_commit_stage {
+	DPU_COMMIT_WAIT_FENCES,
+	DPU_COMMIT_MODESET,
+	DPU_COMMIT_CONNECTOR_PRE_COMMIT,
+	DPU_COMMIT_PLANES,
+	DPU_COMMIT_CONNECTOR_COMMIT,
+	DPU_COMMIT_WAIT_CRTC_FLIP,
+	DPU_COMMIT_WAIT_FLIP_DONE,
+	DPU_COMMIT_BTS_POST_UPDATE,
+	DPU_COMMIT_TAIL,
+	DPU_COMMIT_STAGE_MAX,
+};
+
+/*
+ * log2 latency histogram, bucket 0 counts durations below 1us, bucket n those
+ * in [2^(n-1), 2^n) us and the last bucket everything above.
+ */
+#define DPU_COMMIT_HIST_BUCKETS	24
+
+struct dpu_commit_hist {
+	u32 buckets[DPU_COMMIT_HIST_BUCKETS];
+	u32 count;
+	u32 max_us;
+};
+
 struct decon_debug {
-	/* ring buffer of event log */
-	struct dpu_log *event_log;
-	/* count of log buffers in each event log */
+	/* ring buffer of variable length event log records */
+	void *event_log;
+	/* size of event log ring buffer in bytes, power of two */
+	u32 event_log_size;
+	/* byte offset of next record to be written in event log */
+	atomic_t event_log_head;
+	/* byte offsets of event log records indexed by sequence number */
+	u32 *event_log_pos;
+	/* count of record offsets in event log index */
 	u32 event_log_cnt;
 	/* count of underrun interrupt */
 	u32 underrun_cnt;
@@ -417,15 +488,20 @@ struct decon_debug {
 	u32 ecc_cnt;
 	/* count of idma error interrupt */
 	u32 idma_err_cnt;
-	/* array index of log buffer in event log */
+	/* sequence number of latest entry in event log */
 	atomic_t event_log_idx;
-	/* lock for saving log to event log buffer */
-	spinlock_t event_lock;
+	/* type of latest entry in event log and how many times it was repeated */
+	enum dpu_event_type last_event_type;
+	u32 last_event_repeat_cnt;
 
 	u32 auto_refresh_frames;
 
 	u32 te_cnt;
 	bool force_te_on;
+
+	/* protects commit_hist */
+	spinlock_t commit_hist_lock;
+	struct dpu_commit_hist commit_hist[DPU_COMMIT_STAGE_MAX];
 };
 
 struct decon_device {
@@ -473,6 +549,8 @@ struct decon_device {
 
 	atomic_t frames_pending;
 	wait_queue_head_t framedone_wait;
+	struct decon_frame_sched frame_sched;
+	struct decon_frame_lat frame_lat;
 
 	bool keep_unmask;
 	struct exynos_partial *partial;
@@ -500,6 +578,10 @@ int dpu_init_debug(struct decon_device *decon);
 void DPU_EVENT_LOG(enum dpu_event_type type, int index, void *priv);
 void DPU_EVENT_LOG_ATOMIC_COMMIT(int index);
 void DPU_EVENT_LOG_CMD(struct dsim_device *dsim, u8 type, u8 d0, u16 len);
+void dpu_commit_stage_done(struct decon_device *decon,
+		enum dpu_commit_stage stage, ktime_t start);
+void dpu_atomic_commit_stage_done(struct drm_atomic_state *state, u32 crtc_mask,
+		enum dpu_commit_stage stage, ktime_t start);
 void decon_force_vblank_event(struct decon_device *decon);
 
 #if IS_ENABLED(CONFIG_EXYNOS_BTS)
@@ -405,9 +405,7 @@ static void dpp_convert_plane_state_to_config(struct dpp_params_info *config,
 		config->addr[3] = config->addr[1] +
 			NV12N_10B_CBCR_8B_SIZE(fb->width, fb->height);
 	} else if (has_all_bits(DRM_FORMAT_MOD_SAMSUNG_SBWC(0), fb->modifier)) {
-		const struct dpu_fmt *fmt_info =
-			dpu_find_fmt_info(config->format);
-		bool is_10bpc = IS_10BPC(fmt_info);
+		bool is_10bpc = IS_10BPC(state->fmt_info);
 		/* Luminance header */
 		config->addr[0] += Y_PL_SIZE_SBWC(config->src.f_w,
 				config->src.f_h, is_10bpc);
@@ -666,16 +664,14 @@ static int dpp_check_scale(struct dpp_device *dpp,
 }
 
 static int dpp_check_size(struct dpp_device *dpp,
-			struct dpp_params_info *config)
+			struct dpp_params_info *config,
+			const struct dpu_fmt *fmt_info)
 {
 	struct decon_frame *src, *dst;
-	const struct dpu_fmt *fmt_info;
 	struct dpp_restriction *res;
 	u32 mul = 1; /* factor to multiply alignment */
 	u32 src_h_max;
 
-	fmt_info = dpu_find_fmt_info(config->format);
-
 	if (IS_YUV(fmt_info))
 		mul = 2;
 
@@ -760,7 +756,7 @@ static int dpp_check(struct dpp_device *dpp,
 		const struct exynos_drm_plane_state *state)
 {
 	struct dpp_params_info config;
-	const struct dpu_fmt *fmt_info;
+	const struct dpu_fmt *fmt_info = state->fmt_info;
 	const struct drm_plane_state *plane_state = &state->base;
 	const struct drm_crtc_state *crtc_state =
 			drm_atomic_get_new_crtc_state(plane_state->state,
@@ -784,10 +780,9 @@ static int dpp_check(struct dpp_device *dpp,
 	if (dpp_check_scale(dpp, &config))
 		goto err;
 
-	if (dpp_check_size(dpp, &config))
+	if (dpp_check_size(dpp, &config, fmt_info))
 		goto err;
 
-	fmt_info = dpu_find_fmt_info(config.format);
 	if ((config.rot & DPP_ROT) && (!IS_YUV420(fmt_info))) {
 		dpp_err(dpp, "support rotation only for YUV420 format\n");
 		goto err;
@@ -932,6 +927,7 @@ static int dpp_update(struct dpp_device *dpp,
 	const struct drm_display_mode *mode = &crtc_state->adjusted_mode;
 	const struct exynos_drm_crtc_state *exynos_crtc_state =
 					to_exynos_crtc_state(crtc_state);
+	u32 write_cnt;
 
 	dpp_debug(dpp, "+\n");
 
@@ -948,7 +944,9 @@ static int dpp_update(struct dpp_device *dpp,
 
 	set_protection(dpp, plane_state->fb->modifier);
 
+	write_cnt = dpp_reg_get_write_cnt(dpp->id);
 	dpp_reg_configure_params(dpp->id, config, dpp->attr);
+	dpp->sfr_write_cnt = dpp_reg_get_write_cnt(dpp->id) - write_cnt;
 
 	dpp_debug(dpp, "-\n");
 
@@ -105,6 +105,7 @@ struct dpp_device {
 	 */
 	u64 comp_src;
 	u32 recovery_cnt;
+	u32 sfr_write_cnt;	/* SFR writes of the last update */
 
 	struct dpp_restriction restriction;
 
@@ -13,9 +13,19 @@
 
 #include <linux/of_address.h>
 #include <linux/device.h>
+#include <linux/fs.h>
+#include <linux/jhash.h>
+#include <linux/mm.h>
+#include <linux/poll.h>
+#include <linux/pm_runtime.h>
+#include <linux/slab.h>
+#include <linux/uaccess.h>
+#include <linux/vmalloc.h>
+#include <uapi/linux/sched/types.h>
 #include <drm/drm_drv.h>
 #include <drm/drm_modeset_lock.h>
 #include <drm/drm_atomic_helper.h>
+#include <trace/dpu_trace.h>
 
 #include <dqe_cal.h>
 #include <decon_cal.h>
@@ -182,28 +192,434 @@ int histogram_cancel_ioctl(struct drm_device *dev, void *data,
 	return 0;
 }
 
-void handle_histogram_event(struct exynos_dqe *dqe)
+/*
+ * The histogram stream keeps the histogram running for as long as the misc
+ * device is open and appends every frame to the ring, so any number of
+ * readers can follow it either through mmap() or read().
+ */
+struct histogram_reader {
+	struct histogram_stream *stream;
+	u64 next_seq;
+	u32 dropped;
+	struct histogram_ring_entry entry;
+};
+
+static inline bool histogram_stream_has_users(const struct exynos_dqe *dqe)
 {
-	/* This function runs in interrupt context */
+	return dqe->hist_stream && atomic_read(&dqe->hist_stream->users);
+}
+
+/* called with histogram_slock held */
+static void __exynos_histogram_set_state(struct exynos_dqe *dqe)
+{
+	enum histogram_state hist_state;
+
+	if (!dqe->state.event && !histogram_stream_has_users(dqe))
+		hist_state = HISTOGRAM_OFF;
+	else if (dqe->state.roi)
+		hist_state = HISTOGRAM_ROI;
+	else
+		hist_state = HISTOGRAM_FULL;
+
+	dqe_reg_set_histogram(dqe->decon->id, hist_state);
+}
+
+/*
+ * Readers come and go outside of atomic commits, so apply the new histogram
+ * enable state right away while decon is running. Otherwise the next dqe
+ * update picks it up.
+ */
+static void exynos_histogram_refresh(struct exynos_dqe *dqe)
+{
+	struct decon_device *decon = dqe->decon;
+	unsigned long flags;
+
+	if (pm_runtime_get_if_in_use(decon->dev) <= 0)
+		return;
+
+	spin_lock_irqsave(&dqe->state.histogram_slock, flags);
+	if (dqe->initialized && dqe->state.enabled) {
+		__exynos_histogram_set_state(dqe);
+		decon_reg_update_req_dqe(decon->id);
+	}
+	spin_unlock_irqrestore(&dqe->state.histogram_slock, flags);
+
+	pm_runtime_put(decon->dev);
+}
+
+static inline u64 histogram_stream_head(const struct histogram_stream *stream)
+{
+	return smp_load_acquire(&stream->hdr->head);
+}
+
+/* called with histogram_slock held */
+static void histogram_stream_write(struct exynos_dqe *dqe,
+		const struct histogram_bins *bins, u64 timestamp_ns)
+{
+	struct histogram_stream *stream = dqe->hist_stream;
+	struct histogram_ring_entry *e;
+	u64 seq;
+
+	if (!histogram_stream_has_users(dqe))
+		return;
+
+	seq = stream->hdr->head;
+	e = &stream->entries[seq % HISTOGRAM_RING_ENTRY_CNT];
+
+	WRITE_ONCE(e->seq, HISTOGRAM_SEQ_INVALID);
+	smp_wmb();
+	e->timestamp_ns = timestamp_ns;
+	memcpy(&e->bins, bins, sizeof(e->bins));
+	smp_wmb();
+	WRITE_ONCE(e->seq, seq);
+
+	smp_store_release(&stream->hdr->head, seq + 1);
+	wake_up_interruptible(&stream->wait);
+}
+
+static void histogram_stream_free(struct kref *ref)
+{
+	struct histogram_stream *stream = container_of(ref,
+			struct histogram_stream, ref);
+
+	vfree(stream->buf);
+	kfree(stream);
+}
+
+static void histogram_stream_refresh(struct histogram_stream *stream)
+{
+	mutex_lock(&stream->lock);
+	if (stream->dqe)
+		exynos_histogram_refresh(stream->dqe);
+	mutex_unlock(&stream->lock);
+}
+
+static int histogram_stream_open(struct inode *inode, struct file *file)
+{
+	struct histogram_stream *stream = container_of(file->private_data,
+			struct histogram_stream, misc);
+	struct histogram_reader *reader;
+
+	reader = kzalloc(sizeof(*reader), GFP_KERNEL);
+	if (!reader)
+		return -ENOMEM;
+
+	kref_get(&stream->ref);
+	reader->stream = stream;
+	reader->next_seq = histogram_stream_head(stream);
+	file->private_data = reader;
+
+	if (atomic_inc_return(&stream->users) == 1)
+		histogram_stream_refresh(stream);
+
+	return 0;
+}
+
+static int histogram_stream_release(struct inode *inode, struct file *file)
+{
+	struct histogram_reader *reader = file->private_data;
+	struct histogram_stream *stream = reader->stream;
+
+	if (atomic_dec_and_test(&stream->users))
+		histogram_stream_refresh(stream);
+
+	kfree(reader);
+	kref_put(&stream->ref, histogram_stream_free);
+
+	return 0;
+}
+
+static ssize_t histogram_stream_read(struct file *file, char __user *buf,
+		size_t count, loff_t *ppos)
+{
+	struct histogram_reader *reader = file->private_data;
+	struct histogram_stream *stream = reader->stream;
+	struct histogram_ring_entry *e = &reader->entry;
+	const struct histogram_ring_entry *src;
+	u64 head;
+	int ret;
+
+	if (count < sizeof(*e))
+		return -EINVAL;
+
+	for (;;) {
+		head = histogram_stream_head(stream);
+		if (head == reader->next_seq) {
+			if (file->f_flags & O_NONBLOCK)
+				return -EAGAIN;
+
+			ret = wait_event_interruptible(stream->wait,
+				histogram_stream_head(stream) != reader->next_seq);
+			if (ret)
+				return ret;
+			continue;
+		}
+
+		if (head - reader->next_seq > HISTOGRAM_RING_ENTRY_CNT) {
+			reader->dropped += head - HISTOGRAM_RING_ENTRY_CNT -
+				reader->next_seq;
+			reader->next_seq = head - HISTOGRAM_RING_ENTRY_CNT;
+		}
+
+		src = &stream->entries[reader->next_seq %
+			HISTOGRAM_RING_ENTRY_CNT];
+		if (READ_ONCE(src->seq) == reader->next_seq) {
+			smp_rmb();
+			memcpy(e, src, sizeof(*e));
+			smp_rmb();
+			if (READ_ONCE(src->seq) == reader->next_seq)
+				break;
+		}
+
+		/* overwritten while copying */
+		reader->dropped++;
+		reader->next_seq++;
+	}
+
+	e->seq = reader->next_seq;
+	e->dropped = reader->dropped;
+	e->reserved = 0;
+
+	if (copy_to_user(buf, e, sizeof(*e)))
+		return -EFAULT;
+
+	reader->next_seq++;
+	reader->dropped = 0;
+
+	return sizeof(*e);
+}
+
+static __poll_t histogram_stream_poll(struct file *file, poll_table *wait)
+{
+	struct histogram_reader *reader = file->private_data;
+	struct histogram_stream *stream = reader->stream;
+
+	poll_wait(file, &stream->wait, wait);
+
+	if (histogram_stream_head(stream) != reader->next_seq)
+		return EPOLLIN | EPOLLRDNORM;
+
+	return 0;
+}
+
+static int histogram_stream_mmap(struct file *file, struct vm_area_struct *vma)
+{
+	struct histogram_reader *reader = file->private_data;
+
+	if (vma->vm_flags & VM_WRITE)
+		return -EPERM;
+
+	vma->vm_flags &= ~VM_MAYWRITE;
+
+	return remap_vmalloc_range(vma, reader->stream->buf, vma->vm_pgoff);
+}
+
+static const struct file_operations histogram_stream_fops = {
+	.owner		= THIS_MODULE,
+	.open		= histogram_stream_open,
+	.release	= histogram_stream_release,
+	.read		= histogram_stream_read,
+	.poll		= histogram_stream_poll,
+	.mmap		= histogram_stream_mmap,
+	.llseek		= noop_llseek,
+};
+
+static int histogram_stream_init(struct exynos_dqe *dqe)
+{
+	struct histogram_stream *stream;
+	unsigned long flags;
+	int ret;
+
+	stream = kzalloc(sizeof(*stream), GFP_KERNEL);
+	if (!stream)
+		return -ENOMEM;
+
+	stream->size = PAGE_ALIGN(sizeof(*stream->hdr) +
+			HISTOGRAM_RING_ENTRY_CNT * sizeof(*stream->entries));
+	stream->buf = vmalloc_user(stream->size);
+	if (!stream->buf) {
+		kfree(stream);
+		return -ENOMEM;
+	}
+
+	stream->hdr = stream->buf;
+	stream->hdr->entry_cnt = HISTOGRAM_RING_ENTRY_CNT;
+	stream->hdr->entry_size = sizeof(*stream->entries);
+	stream->hdr->head = 0;
+	stream->entries = stream->buf + sizeof(*stream->hdr);
+
+	init_waitqueue_head(&stream->wait);
+	atomic_set(&stream->users, 0);
+	kref_init(&stream->ref);
+	mutex_init(&stream->lock);
+	stream->dqe = dqe;
+
+	scnprintf(stream->name, sizeof(stream->name), "dqe%u_histogram",
+			dqe->decon->id);
+	stream->misc.minor = MISC_DYNAMIC_MINOR;
+	stream->misc.name = stream->name;
+	stream->misc.fops = &histogram_stream_fops;
+	stream->misc.parent = dqe->decon->dev;
+
+	ret = misc_register(&stream->misc);
+	if (ret) {
+		vfree(stream->buf);
+		kfree(stream);
+		return ret;
+	}
+
+	spin_lock_irqsave(&dqe->state.histogram_slock, flags);
+	dqe->hist_stream = stream;
+	spin_unlock_irqrestore(&dqe->state.histogram_slock, flags);
+
+	return 0;
+}
+
+static void histogram_stream_destroy(struct exynos_dqe *dqe)
+{
+	struct histogram_stream *stream = dqe->hist_stream;
+	unsigned long flags;
+
+	if (!stream)
+		return;
+
+	/* no new readers after this, open files only keep the ring alive */
+	misc_deregister(&stream->misc);
+
+	mutex_lock(&stream->lock);
+	stream->dqe = NULL;
+	mutex_unlock(&stream->lock);
+
+	spin_lock_irqsave(&dqe->state.histogram_slock, flags);
+	dqe->hist_stream = NULL;
+	spin_unlock_irqrestore(&dqe->state.histogram_slock, flags);
+
+	kref_put(&stream->ref, histogram_stream_free);
+}
+
+static void histogram_work(struct kthread_work *work)
+{
+	struct exynos_dqe *dqe = container_of(work, struct exynos_dqe, hist_work);
+	struct decon_device *decon = dqe->decon;
+	struct drm_device *dev = decon->drm_dev;
 	struct exynos_drm_pending_histogram_event *e;
-	struct drm_device *dev = dqe->decon->drm_dev;
-	uint32_t id, crtc_id;
+	struct histogram_bins *bins;
+	unsigned long flags;
+	u64 seq, ts;
+	bool dropped;
+
+	DPU_ATRACE_BEGIN(__func__);
+
+	/* decon may have been turned off since the frame done was latched */
+	if (pm_runtime_get_if_in_use(decon->dev) <= 0)
+		goto out;
+
+	spin_lock_irqsave(&dqe->state.histogram_slock, flags);
+	seq = dqe->hist_latch_seq;
+	ts = dqe->hist_latch_ts;
+	spin_unlock_irqrestore(&dqe->state.histogram_slock, flags);
+
+	bins = &dqe->hist_bins;
+	dqe_reg_get_histogram_bins(decon->id, bins);
+
+	pm_runtime_put(decon->dev);
+
+	spin_lock_irqsave(&dqe->state.histogram_slock, flags);
+	dropped = seq != dqe->hist_latch_seq;
+	trace_dpu_histogram_readout(decon->id, seq, ktime_get_ns() - ts, dropped);
+	/*
+	 * The bins of the next frame may have landed in the middle of the
+	 * readout. Drop this sample, the work is already queued again for the
+	 * next frame.
+	 */
+	if (dropped) {
+		dqe->hist_dropped_cnt++;
+		spin_unlock_irqrestore(&dqe->state.histogram_slock, flags);
+		goto out;
+	}
 
-	spin_lock(&dqe->state.histogram_slock);
-	crtc_id = dqe->decon->crtc->base.base.id;
-	id = dqe->decon->id;
 	e = dqe->state.event;
 	if (e) {
-		pr_debug("Histogram event(0x%pK) will be handled\n", dqe->state.event);
-		dqe_reg_get_histogram_bins(id, &e->event.bins);
-		e->event.crtc_id = crtc_id;
+		pr_debug("Histogram event(0x%pK) will be handled\n", e);
+		memcpy(&e->event.bins, bins, sizeof(e->event.bins));
+		e->event.crtc_id = decon->crtc->base.base.id;
 		drm_send_event(dev, &e->base);
-		pr_debug("histogram event of decon%u signalled\n", dqe->decon->id);
+		pr_debug("histogram event of decon%u signalled\n", decon->id);
 		dqe->state.event = NULL;
 	}
+	histogram_stream_write(dqe, bins, ts);
+	spin_unlock_irqrestore(&dqe->state.histogram_slock, flags);
+out:
+	DPU_ATRACE_END(__func__);
+}
+
+void handle_histogram_event(struct exynos_dqe *dqe)
+{
+	/* This function runs in interrupt context */
+	spin_lock(&dqe->state.histogram_slock);
+	if (dqe->state.event || histogram_stream_has_users(dqe)) {
+		dqe->hist_latch_seq++;
+		dqe->hist_latch_ts = ktime_get_ns();
+		/* the pending readout now picks up this frame instead */
+		if (!kthread_queue_work(dqe->hist_worker, &dqe->hist_work))
+			dqe->hist_dropped_cnt++;
+	}
 	spin_unlock(&dqe->state.histogram_slock);
 }
 
+/*
+ * Color blobs with identical contents are sent on most brightness or ambient
+ * changes, so compare the table contents instead of blob pointers to avoid
+ * rewriting the same values to hw. Blobs are immutable, so a table still
+ * coming from the last applied blob is skipped without hashing it. The last
+ * applied table belongs to the old crtc state, which is alive during the
+ * update.
+ */
+static bool exynos_dqe_table_changed(struct exynos_dqe *dqe, struct dqe_table_hash *h,
+				     const void *table, size_t size, bool force)
+{
+	const void *last = h->table;
+	u32 hash = 0;
+
+	if (!force && h->valid && table == last)
+		goto skip;
+
+	if (table)
+		hash = jhash(table, size, 0);
+
+	if (!force && h->valid && table && last && h->hash == hash &&
+	    !memcmp(table, last, size))
+		goto skip;
+
+	h->valid = true;
+	h->hash = hash;
+	h->table = table;
+	dqe->table_applied_cnt++;
+
+	return true;
+
+skip:
+	/* the old blob goes away with the old state */
+	h->table = table;
+	dqe->table_skipped_cnt++;
+
+	return false;
+}
+
+static void exynos_dqe_invalidate_tables(struct exynos_dqe *dqe)
+{
+	dqe->degamma_hash.valid = false;
+	dqe->degamma_hash.table = NULL;
+	dqe->regamma_hash.valid = false;
+	dqe->regamma_hash.table = NULL;
+	dqe->cgc_hash.valid = false;
+	dqe->cgc_hash.table = NULL;
+	dqe->gamma_hash.valid = false;
+	dqe->gamma_hash.table = NULL;
+	dqe->linear_hash.valid = false;
+	dqe->linear_hash.table = NULL;
+}
+
 static void
 exynos_degamma_update(struct exynos_dqe *dqe, struct exynos_dqe_state *state)
 {
@@ -218,11 +634,12 @@ exynos_degamma_update(struct exynos_dqe *dqe, struct exynos_dqe_state *state)
 	if (info->force_en)
 		state->degamma_lut = degamma->force_lut;
 
-	if (dqe->state.degamma_lut != state->degamma_lut || info->dirty) {
+	if (exynos_dqe_table_changed(dqe, &dqe->degamma_hash, state->degamma_lut,
+				sizeof(*state->degamma_lut) * DEGAMMA_LUT_SIZE, info->dirty)) {
 		dqe_reg_set_degamma_lut(id, state->degamma_lut);
-		dqe->state.degamma_lut = state->degamma_lut;
 		info->dirty = false;
 	}
+	dqe->state.degamma_lut = state->degamma_lut;
 
 	if (info->verbose)
 		dqe_reg_print_degamma_lut(id, &p);
@@ -245,9 +662,12 @@ exynos_cgc_update(struct exynos_dqe *dqe, struct exynos_dqe_state *state)
 	if (info->force_en)
 		state->cgc_lut = &cgc->force_lut;
 
-	if (dqe->state.cgc_lut != state->cgc_lut || info->dirty) {
+	/* blob of the previous state may be gone, keep pointing to the current one */
+	dqe->state.cgc_lut = state->cgc_lut;
+
+	if (exynos_dqe_table_changed(dqe, &dqe->cgc_hash, state->cgc_lut,
+				sizeof(*state->cgc_lut), info->dirty)) {
 		dqe_reg_set_cgc_lut(id, state->cgc_lut);
-		dqe->state.cgc_lut = state->cgc_lut;
 		cgc->first_write = true;
 		info->dirty = false;
 		updated = true;
@@ -278,11 +698,12 @@ exynos_regamma_update(struct exynos_dqe *dqe, struct exynos_dqe_state *state)
 	if (info->force_en)
 		state->regamma_lut = regamma->force_lut;
 
-	if (dqe->state.regamma_lut != state->regamma_lut || info->dirty) {
+	if (exynos_dqe_table_changed(dqe, &dqe->regamma_hash, state->regamma_lut,
+				sizeof(*state->regamma_lut) * REGAMMA_LUT_SIZE, info->dirty)) {
 		dqe_reg_set_regamma_lut(id, state->regamma_lut);
-		dqe->state.regamma_lut = state->regamma_lut;
 		info->dirty = false;
 	}
+	dqe->state.regamma_lut = state->regamma_lut;
 
 	if (info->verbose)
 		dqe_reg_print_regamma_lut(id, &p);
@@ -302,11 +723,12 @@ static void exynos_gamma_matrix_update(struct exynos_dqe *dqe,
 	if (info->force_en)
 		state->gamma_matrix = &gamma->force_matrix;
 
-	if (dqe->state.gamma_matrix != state->gamma_matrix || info->dirty) {
+	if (exynos_dqe_table_changed(dqe, &dqe->gamma_hash, state->gamma_matrix,
+				sizeof(*state->gamma_matrix), info->dirty)) {
 		dqe_reg_set_gamma_matrix(id, state->gamma_matrix);
-		dqe->state.gamma_matrix = state->gamma_matrix;
 		info->dirty = false;
 	}
+	dqe->state.gamma_matrix = state->gamma_matrix;
 
 	if (info->verbose)
 		dqe_reg_print_gamma_matrix(id, &p);
@@ -326,11 +748,12 @@ static void exynos_linear_matrix_update(struct exynos_dqe *dqe,
 	if (info->force_en)
 		state->linear_matrix = &linear->force_matrix;
 
-	if (dqe->state.linear_matrix != state->linear_matrix || info->dirty) {
+	if (exynos_dqe_table_changed(dqe, &dqe->linear_hash, state->linear_matrix,
+				sizeof(*state->linear_matrix), info->dirty)) {
 		dqe_reg_set_linear_matrix(id, state->linear_matrix);
-		dqe->state.linear_matrix = state->linear_matrix;
 		info->dirty = false;
 	}
+	dqe->state.linear_matrix = state->linear_matrix;
 
 	if (info->verbose)
 		dqe_reg_print_linear_matrix(id, &p);
@@ -386,10 +809,10 @@ exynos_dither_update(struct exynos_dqe *dqe, struct exynos_dqe_state *state)
 static void
 exynos_histogram_update(struct exynos_dqe *dqe, struct exynos_dqe_state *state)
 {
-	enum histogram_state hist_state;
 	struct decon_device *decon = dqe->decon;
 	struct drm_printer p = drm_info_printer(decon->dev);
 	u32 id = decon->id;
+	unsigned long flags;
 
 	if (dqe->state.roi != state->roi) {
 		dqe_reg_set_histogram_roi(id, state->roi);
@@ -411,14 +834,9 @@ exynos_histogram_update(struct exynos_dqe *dqe, struct exynos_dqe_state *state)
 		dqe->state.histogram_pos = state->histogram_pos;
 	}
 
-	if (dqe->state.event && state->roi)
-		hist_state = HISTOGRAM_ROI;
-	else if (dqe->state.event && !state->roi)
-		hist_state = HISTOGRAM_FULL;
-	else
-		hist_state = HISTOGRAM_OFF;
-
-	dqe_reg_set_histogram(id, hist_state);
+	spin_lock_irqsave(&dqe->state.histogram_slock, flags);
+	__exynos_histogram_set_state(dqe);
+	spin_unlock_irqrestore(&dqe->state.histogram_slock, flags);
 
 	if (dqe->verbose_hist)
 		dqe_reg_print_hist(id, &p);
@@ -497,8 +915,11 @@ static void __exynos_dqe_update(struct exynos_dqe *dqe,
 	dqe->state.enabled = state->enabled && !dqe->force_disabled;
 
 	decon_reg_set_dqe_enable(id, dqe->state.enabled);
-	if (!dqe->state.enabled)
+	if (!dqe->state.enabled) {
+		/* tables aren't tracked while disabled, the blobs may be freed */
+		exynos_dqe_invalidate_tables(dqe);
 		return;
+	}
 
 	if (!dqe->initialized) {
 		dqe_reg_init(id, width, height);
@@ -550,6 +971,8 @@ void exynos_dqe_reset(struct exynos_dqe *dqe)
 	dqe->state.weights = NULL;
 	dqe->state.rcd_enabled = false;
 	dqe->state.cgc_gem = NULL;
+	exynos_dqe_invalidate_tables(dqe);
+	dqe_reg_invalidate_lut_shadow(dqe->decon->id);
 }
 
 void exynos_dqe_save_lpd_data(struct exynos_dqe *dqe)
@@ -799,6 +1222,9 @@ struct exynos_dqe *exynos_dqe_register(struct decon_device *decon)
 	enum dqe_version dqe_version;
 	int i;
 	char dqe_name[MAX_DQE_NAME_SIZE] = "dqe";
+	struct sched_param param = {
+		.sched_priority = 16
+	};
 
 	i = of_property_match_string(np, "reg-names", "dqe");
 	if (i < 0) {
@@ -827,6 +1253,7 @@ struct exynos_dqe *exynos_dqe_register(struct decon_device *decon)
 	dqe->initialized = false;
 	dqe->decon = decon;
 	spin_lock_init(&dqe->state.histogram_slock);
+	kthread_init_work(&dqe->hist_work, histogram_work);
 
 	scnprintf(dqe_name, MAX_DQE_NAME_SIZE, "dqe%u", decon->id);
 	dqe->dqe_class = class_create(THIS_MODULE, dqe_name);
@@ -839,13 +1266,47 @@ struct exynos_dqe *exynos_dqe_register(struct decon_device *decon)
 	dqe->dev = device_create(dqe->dqe_class, dev, 0, dqe, "atc");
 	if (IS_ERR(dqe->dev)) {
 		pr_err("failed to create to atc sysfs device\n");
-		return NULL;
+		goto err_class;
+	}
+
+	/*
+	 * Keep the readout off the decon kthread so that it never delays
+	 * commit_tail, but below its priority.
+	 */
+	dqe->hist_worker = kthread_create_worker(0, "dqe%u_hist", decon->id);
+	if (IS_ERR(dqe->hist_worker)) {
+		pr_err("failed to create histogram worker\n");
+		goto err_dev;
 	}
+	sched_setscheduler_nocheck(dqe->hist_worker->task, SCHED_FIFO, &param);
 
 	set_default_atc_config(&dqe->force_atc_config);
 
+	if (histogram_stream_init(dqe))
+		pr_warn("failed to register histogram stream of decon%u\n",
+				decon->id);
+
 	pr_info("display quality enhancer is supported(DQE_V%d)\n",
 			dqe_version + 1);
 
 	return dqe;
+
+err_dev:
+	device_unregister(dqe->dev);
+err_class:
+	class_destroy(dqe->dqe_class);
+	return NULL;
+}
+
+void exynos_dqe_unregister(struct exynos_dqe *dqe)
+{
+	if (!dqe)
+		return;
+
+	histogram_stream_destroy(dqe);
+	kthread_destroy_worker(dqe->hist_worker);
+
+	device_unregister(dqe->dev);
+	class_destroy(dqe->dqe_class);
+	iounmap(dqe->regs);
 }
@@ -13,7 +13,13 @@
 #ifndef __EXYNOS_DRM_DQE_H__
 #define __EXYNOS_DRM_DQE_H__
 
+#include <linux/kref.h>
+#include <linux/kthread.h>
+#include <linux/miscdevice.h>
+#include <linux/mutex.h>
+#include <linux/wait.h>
 #include <drm/samsung_drm.h>
+#include <uapi/drm/exynos_histogram_stream.h>
 #include <dqe_cal.h>
 #include <cal_config.h>
 
@@ -91,6 +97,32 @@ struct matrix_debug_override {
 	struct exynos_matrix force_matrix;
 };
 
+/* table last written to hw, NULL if it was disabled */
+struct dqe_table_hash {
+	bool valid;
+	u32 hash;
+	const void *table;
+};
+
+/*
+ * The stream outlives the dqe while a reader keeps the device open or mapped,
+ * @dqe is cleared under @lock on unregister and the ring is freed with the
+ * last reference.
+ */
+struct histogram_stream {
+	struct miscdevice misc;
+	char name[MAX_NAME_SIZE];
+	struct kref ref;
+	struct mutex lock;
+	struct exynos_dqe *dqe;
+	void *buf;
+	size_t size;
+	struct histogram_ring_header *hdr;
+	struct histogram_ring_entry *entries;
+	wait_queue_head_t wait;
+	atomic_t users;
+};
+
 enum dump_type {
 	DUMP_TYPE_CGC_DIHTER	= 0,
 	DUMP_TYPE_DISP_DITHER,
@@ -133,6 +165,26 @@ struct exynos_dqe {
 	struct matrix_debug_override gamma;
 	struct matrix_debug_override linear;
 
+	struct dqe_table_hash degamma_hash;
+	struct dqe_table_hash regamma_hash;
+	struct dqe_table_hash cgc_hash;
+	struct dqe_table_hash gamma_hash;
+	struct dqe_table_hash linear_hash;
+	u32 table_applied_cnt;
+	u32 table_skipped_cnt;
+
+	struct histogram_stream *hist_stream;
+	/*
+	 * Frame done only latches hist_latch_seq/ts, the bins are read by
+	 * hist_work on hist_worker into hist_bins. A readout that a newer
+	 * frame done overlapped is dropped rather than delivered torn.
+	 */
+	struct kthread_worker *hist_worker;
+	struct kthread_work hist_work;
+	u64 hist_latch_seq;
+	u64 hist_latch_ts;
+	struct histogram_bins hist_bins;
+	u32 hist_dropped_cnt;
 	bool verbose_hist;
 
 	bool force_disabled;
@@ -152,6 +204,7 @@ void exynos_dqe_update(struct exynos_dqe *dqe, struct exynos_dqe_state *state,
 			u32 width, u32 height);
 void exynos_dqe_reset(struct exynos_dqe *dqe);
 struct exynos_dqe *exynos_dqe_register(struct decon_device *decon);
+void exynos_dqe_unregister(struct exynos_dqe *dqe);
 void exynos_dqe_save_lpd_data(struct exynos_dqe *dqe);
 void exynos_dqe_restore_lpd_data(struct exynos_dqe *dqe);
 
@@ -13,6 +13,8 @@
  */
 
 #include <linux/component.h>
+#include <linux/dma-fence.h>
+#include <linux/ktime.h>
 #include <linux/platform_device.h>
 #include <linux/pm_runtime.h>
 
@@ -33,6 +35,7 @@
 #include "exynos_drm_drv.h"
 #include "exynos_drm_dsim.h"
 #include "exynos_drm_fb.h"
+#include "exynos_drm_format.h"
 #include "exynos_drm_gem.h"
 #include "exynos_drm_plane.h"
 #include "exynos_drm_writeback.h"
@@ -58,8 +61,8 @@ static struct exynos_drm_priv_state *exynos_drm_get_priv_state(struct drm_atomic
 	struct drm_private_state *priv_state;
 
 	priv_state = drm_atomic_get_private_obj_state(state, &priv->obj);
-	if (IS_ERR(priv))
-		return ERR_CAST(priv);
+	if (IS_ERR(priv_state))
+		return ERR_CAST(priv_state);
 
 	return to_exynos_priv_state(priv_state);
 }
@@ -96,6 +99,67 @@ static unsigned int exynos_drm_crtc_get_win_cnt(struct drm_crtc_state *crtc_stat
 	return num_planes ? : 1;
 }
 
+/*
+ * Pick @count windows out of @available_win_mask. Windows released by commits still in flight
+ * (@pending_win_mask, per crtc) are only taken when there aren't enough idle ones, and the crtcs
+ * releasing them are returned in @wait_crtc_mask.
+ */
+static unsigned int exynos_select_windows(unsigned int available_win_mask,
+		const unsigned int *pending_win_mask, size_t count, unsigned int *wait_crtc_mask)
+{
+	unsigned int pending_mask = 0;
+	unsigned int free_mask;
+	unsigned int win_mask;
+	size_t free_cnt;
+	int i;
+
+	for (i = 0; i < MAX_CRTC; i++)
+		pending_mask |= pending_win_mask[i];
+
+	free_mask = available_win_mask & ~pending_mask;
+	win_mask = find_set_bits_mask(free_mask, count);
+	if (win_mask)
+		return win_mask;
+
+	/* take every idle window first and only wait for the remainder */
+	free_cnt = hweight32(free_mask);
+	win_mask = find_set_bits_mask(available_win_mask & pending_mask, count - free_cnt);
+	if (!win_mask)
+		return 0;
+	win_mask |= free_mask;
+
+	for (i = 0; i < MAX_CRTC; i++) {
+		if (pending_win_mask[i] & win_mask)
+			*wait_crtc_mask |= BIT(i);
+	}
+
+	pr_debug("%s: win_mask=0x%x pending=0x%x wait crtc_mask=0x%x\n", __func__, win_mask,
+		 pending_mask, *wait_crtc_mask);
+
+	return win_mask;
+}
+
+/*
+ * Find @count windows available for reservation. Windows which were released by commits still
+ * in flight are avoided when possible, otherwise the state is made to wait for the crtcs
+ * releasing them to be done in hw before it can be committed.
+ */
+static unsigned int exynos_atomic_find_windows(struct drm_atomic_state *state,
+		const struct exynos_drm_priv_state *exynos_priv_state, size_t count)
+{
+	struct exynos_drm_private *private = drm_to_exynos_dev(state->dev);
+	struct exynos_drm_atomic_state *exynos_state = to_exynos_atomic_state(state);
+	unsigned int pending_win_mask[MAX_CRTC];
+	unsigned long flags;
+
+	spin_lock_irqsave(&private->lock, flags);
+	memcpy(pending_win_mask, private->pending_win_mask, sizeof(pending_win_mask));
+	spin_unlock_irqrestore(&private->lock, flags);
+
+	return exynos_select_windows(exynos_priv_state->available_win_mask, pending_win_mask,
+				     count, &exynos_state->win_wait_crtc_mask);
+}
+
 static int exynos_atomic_check_windows(struct drm_device *dev, struct drm_atomic_state *state)
 {
 	struct drm_crtc *crtc;
@@ -105,6 +169,8 @@ static int exynos_atomic_check_windows(struct drm_device *dev, struct drm_atomic
 	unsigned int win_mask;
 	int i;
 
+	to_exynos_atomic_state(state)->win_wait_crtc_mask = 0;
+
 	for_each_oldnew_crtc_in_state(state, crtc, old_crtc_state, new_crtc_state, i) {
 		struct exynos_drm_crtc_state *new_exynos_crtc_state;
 		unsigned int old_win_cnt, new_win_cnt;
@@ -138,19 +204,19 @@ static int exynos_atomic_check_windows(struct drm_device *dev, struct drm_atomic
 			     crtc->name, curr_win_mask, old_win_cnt, new_win_cnt);
 
 			/*
-			 * we don't want to immediately put the windows back into available_win_mask
-			 * for next crtc to use since the windows will get freed only after commit
-			 * to hw is done for this commit
+			 * the windows will get freed only after commit to hw is done for this
+			 * commit, keep track of them so that next crtc to use them can wait for it
 			 */
 			freed_win_mask |= win_mask;
+			new_exynos_crtc_state->freed_win_mask |= win_mask;
 			new_exynos_crtc_state->reserved_win_mask &= ~win_mask;
 		} else {
 			exynos_priv_state = exynos_drm_get_priv_state(state);
 			if (IS_ERR(exynos_priv_state))
 				return PTR_ERR(exynos_priv_state);
 
-			win_mask = find_set_bits_mask(exynos_priv_state->available_win_mask,
-						      new_win_cnt - old_win_cnt);
+			win_mask = exynos_atomic_find_windows(state, exynos_priv_state,
+							      new_win_cnt - old_win_cnt);
 			if (!win_mask) {
 				DRM_WARN("%s: No windows available for req win cnt=%d->%d (0x%x)\n",
 					 crtc->name, old_win_cnt, new_win_cnt,
@@ -205,9 +271,8 @@ static int exynos_atomic_check_windows(struct drm_device *dev, struct drm_atomic
 			 exynos_priv_state->available_win_mask, freed_win_mask);
 
 		/*
-		 * FIXME: these windows will be made available for next atomic commit as soon as
-		 * atomic state is swapped. This can lead to a (very rare) race condition if commit
-		 * to hw hasn't finished before an atomic commit comes in for a different crtc.
+		 * these windows are pending release until commit to hw is done, any commit that
+		 * reserves them before then waits for it (see exynos_atomic_find_windows)
 		 */
 		exynos_priv_state->available_win_mask |= freed_win_mask;
 	}
@@ -386,6 +451,36 @@ static const struct drm_private_state_funcs exynos_priv_state_funcs = {
 	.atomic_destroy_state = exynos_atomic_destroy_priv_state,
 };
 
+struct drm_atomic_state *exynos_atomic_state_alloc(struct drm_device *dev)
+{
+	struct exynos_drm_atomic_state *exynos_state;
+
+	exynos_state = kzalloc(sizeof(*exynos_state), GFP_KERNEL);
+	if (!exynos_state)
+		return NULL;
+
+	if (drm_atomic_state_init(dev, &exynos_state->base) < 0) {
+		kfree(exynos_state);
+		return NULL;
+	}
+
+	return &exynos_state->base;
+}
+
+void exynos_atomic_state_free(struct drm_atomic_state *state)
+{
+	struct exynos_drm_atomic_state *exynos_state = to_exynos_atomic_state(state);
+	int i;
+
+	for (i = 0; i < MAX_CRTC; i++) {
+		if (exynos_state->win_commits[i])
+			drm_crtc_commit_put(exynos_state->win_commits[i]);
+	}
+
+	drm_atomic_state_default_release(state);
+	kfree(exynos_state);
+}
+
 static void print_drm_plane_state_info(struct drm_printer *p,
 	struct drm_plane_state *state)
 {
@@ -397,25 +492,146 @@ static void print_drm_plane_state_info(struct drm_printer *p,
 	drm_printf(p, "plane: fb allocated by = %s\n", state->fb->comm);
 }
 
+struct exynos_fence_waiter {
+	atomic_t pending;
+	struct completion done;
+};
+
+struct exynos_fence_cb {
+	struct dma_fence_cb base;
+	struct exynos_fence_waiter *waiter;
+	struct dma_fence *fence;
+	ktime_t signal_time;
+};
+
+static void exynos_fence_cb_func(struct dma_fence *fence, struct dma_fence_cb *cb)
+{
+	struct exynos_fence_cb *fence_cb = container_of(cb, struct exynos_fence_cb, base);
+
+	fence_cb->signal_time = ktime_get();
+	if (atomic_dec_and_test(&fence_cb->waiter->pending))
+		complete(&fence_cb->waiter->done);
+}
+
+static void exynos_atomic_report_fence_timeout(struct drm_plane_state *new_plane_state,
+					       struct drm_printer *p)
+{
+	struct dma_fence *fence = new_plane_state->fence;
+
+	print_drm_plane_state_info(p, new_plane_state);
+
+	spin_lock_irq(fence->lock);
+	drm_printf(p, "fence: %s-%s %llu-%llu status:%s\n",
+		fence->ops ? fence->ops->get_driver_name(fence) : "none",
+		fence->ops ? fence->ops->get_timeline_name(fence) : "none",
+		fence->context, fence->seqno,
+		dma_fence_get_status_locked(fence) < 0 ? "error" : "active");
+	if (test_bit(DMA_FENCE_FLAG_TIMESTAMP_BIT, &fence->flags)) {
+		struct timespec64 ts64 = ktime_to_timespec64(fence->timestamp);
+		drm_printf(p, "fence: timestamp:%lld.%09ld\n",
+			(s64)ts64.tv_sec, ts64.tv_nsec);
+	}
+	if (fence->error)
+		drm_printf(p, "fence: err=%d\n", fence->error);
+	spin_unlock_irq(fence->lock);
+}
+
+/*
+ * Wait for all plane fences together so that a late fence doesn't eat up the timeout of the
+ * fences of other planes, time spent waiting for each plane is traced.
+ */
 static int exynos_atomic_helper_wait_for_fences(struct drm_device *dev,
 				      struct drm_atomic_state *state,
-				      bool pre_swap)
+				      bool pre_swap, u32 crtc_mask)
 {
 	struct drm_plane *plane;
 	struct drm_plane_state *new_plane_state;
-	int i, ret, err = 0;
+	int i, err = 0;
+	long ret;
 	struct drm_printer p = drm_info_printer(dev->dev);
-	long tmo = msecs_to_jiffies(EXYNOS_DRM_WAIT_FENCE_TIMEOUT_MS);
+	const long tmo = msecs_to_jiffies(EXYNOS_DRM_WAIT_FENCE_TIMEOUT_MS);
+	struct exynos_fence_cb fence_cbs[MAX_DPP_CNT] = { 0 };
+	struct exynos_fence_waiter waiter;
+	ktime_t start;
+
+	atomic_set(&waiter.pending, 1);
+	init_completion(&waiter.done);
+	start = ktime_get();
 
 	for_each_new_plane_in_state(state, plane, new_plane_state, i) {
 		struct dma_fence *fence = new_plane_state->fence;
+		struct exynos_fence_cb *fence_cb;
 
 		if (!fence)
 			continue;
 
+		if (new_plane_state->crtc &&
+		    !(drm_crtc_mask(new_plane_state->crtc) & crtc_mask))
+			continue;
+
+		if (WARN_ON(i >= MAX_DPP_CNT))
+			continue;
+
 		WARN_ON(!new_plane_state->fb);
-		ret = dma_fence_wait_timeout(fence, pre_swap, tmo);
-		if (ret == 0) {
+
+		fence_cb = &fence_cbs[i];
+		fence_cb->waiter = &waiter;
+		fence_cb->fence = fence;
+
+		atomic_inc(&waiter.pending);
+		if (dma_fence_add_callback(fence, &fence_cb->base, exynos_fence_cb_func)) {
+			/* already signaled */
+			atomic_dec(&waiter.pending);
+			fence_cb->signal_time = start;
+		}
+	}
+
+	if (atomic_dec_and_test(&waiter.pending))
+		complete(&waiter.done);
+
+	if (pre_swap)
+		ret = wait_for_completion_interruptible_timeout(&waiter.done, tmo);
+	else
+		ret = wait_for_completion_timeout(&waiter.done, tmo);
+
+	/* no callbacks are running or can be called after this */
+	for (i = 0; i < MAX_DPP_CNT; i++) {
+		if (fence_cbs[i].fence)
+			dma_fence_remove_callback(fence_cbs[i].fence, &fence_cbs[i].base);
+	}
+
+	for_each_new_plane_in_state(state, plane, new_plane_state, i) {
+		struct dma_fence *fence = new_plane_state->fence;
+		const struct exynos_fence_cb *fence_cb;
+
+		if (i >= MAX_DPP_CNT || !fence || fence_cbs[i].fence != fence)
+			continue;
+
+		fence_cb = &fence_cbs[i];
+		if (!fence_cb->signal_time && ret < 0) {
+			pr_warn("%s: error of waiting for dma fence, ret=%ld\n", __func__, ret);
+			print_drm_plane_state_info(&p, new_plane_state);
+			return ret;
+		}
+	}
+
+	for_each_new_plane_in_state(state, plane, new_plane_state, i) {
+		struct dma_fence *fence = new_plane_state->fence;
+		const struct exynos_fence_cb *fence_cb;
+		char name[32];
+		s64 wait_us;
+
+		if (i >= MAX_DPP_CNT || !fence || fence_cbs[i].fence != fence)
+			continue;
+
+		fence_cb = &fence_cbs[i];
+		wait_us = ktime_us_delta(fence_cb->signal_time ? : ktime_get(), start);
+		scnprintf(name, sizeof(name), "%s_fence_wait_us", plane->name ? : "plane");
+		DPU_ATRACE_INT(name, (int)wait_us);
+		pr_debug("%s: %s waited %lldus for fence\n", __func__, plane->name ? : "NA",
+			 wait_us);
+
+		if (!fence_cb->signal_time) {
 			struct drm_crtc *crtc = new_plane_state->crtc;
 
 			pr_err("%s: timeout of waiting for fence, name:%s idx:%d\n",
@@ -438,29 +654,9 @@ static int exynos_atomic_helper_wait_for_fences(struct drm_device *dev,
 									__func__, crtc->name);
 				}
 			}
-			print_drm_plane_state_info(&p, new_plane_state);
-
-			spin_lock_irq(fence->lock);
-			drm_printf(&p, "fence: %s-%s %llu-%llu status:%s\n",
-				fence->ops ? fence->ops->get_driver_name(fence) : "none",
-				fence->ops ? fence->ops->get_timeline_name(fence) : "none",
-				fence->context, fence->seqno,
-				dma_fence_get_status_locked(fence) < 0 ? "error" : "active");
-			if (test_bit(DMA_FENCE_FLAG_TIMESTAMP_BIT, &fence->flags)) {
-				struct timespec64 ts64 = ktime_to_timespec64(fence->timestamp);
-				drm_printf(&p, "fence: timestamp:%lld.%09ld\n",
-					(s64)ts64.tv_sec, ts64.tv_nsec);
-			}
-			if (fence->error)
-				drm_printf(&p, "fence: err=%d\n", fence->error);
-			spin_unlock_irq(fence->lock);
+			exynos_atomic_report_fence_timeout(new_plane_state, &p);
 
-			tmo = 0;
 			err = -ETIMEDOUT;
-		} else if (ret < 0) {
-			pr_warn("%s: error of waiting for dma fence, ret=%d\n", __func__, ret);
-			print_drm_plane_state_info(&p, new_plane_state);
-			return ret;
 		}
 		dma_fence_put(fence);
 		new_plane_state->fence = NULL;
@@ -469,6 +665,91 @@ static int exynos_atomic_helper_wait_for_fences(struct drm_device *dev,
 	return err;
 }
 
+/*
+ * Mark windows released by the new crtc states as pending, they can't be used by other crtcs
+ * until commit to hw is done. Also grab the commits in flight which are still releasing
+ * windows reserved by this state.
+ */
+static void exynos_atomic_setup_windows(struct drm_atomic_state *state)
+{
+	struct exynos_drm_private *private = drm_to_exynos_dev(state->dev);
+	struct exynos_drm_atomic_state *exynos_state = to_exynos_atomic_state(state);
+	const unsigned long win_wait_crtc_mask = exynos_state->win_wait_crtc_mask;
+	struct drm_crtc *crtc;
+	struct drm_crtc_state *new_crtc_state;
+	unsigned long flags;
+	int i;
+
+	for_each_set_bit(i, &win_wait_crtc_mask, MAX_CRTC) {
+		const struct drm_crtc_state *old_crtc_state;
+		struct drm_crtc_commit *commit;
+
+		crtc = drm_crtc_from_index(state->dev, i);
+		if (!crtc)
+			continue;
+
+		/* commit list already has this commit for crtcs within the state, use previous */
+		old_crtc_state = drm_atomic_get_old_crtc_state(state, crtc);
+		if (old_crtc_state) {
+			commit = old_crtc_state->commit;
+			if (commit)
+				drm_crtc_commit_get(commit);
+		} else {
+			spin_lock(&crtc->commit_lock);
+			commit = list_first_entry_or_null(&crtc->commit_list,
+							  struct drm_crtc_commit, commit_entry);
+			if (commit)
+				drm_crtc_commit_get(commit);
+			spin_unlock(&crtc->commit_lock);
+		}
+
+		exynos_state->win_commits[i] = commit;
+	}
+
+	spin_lock_irqsave(&private->lock, flags);
+	for_each_new_crtc_in_state(state, crtc, new_crtc_state, i) {
+		const struct exynos_drm_crtc_state *new_exynos_crtc_state =
+			to_exynos_crtc_state(new_crtc_state);
+
+		private->pending_win_mask[drm_crtc_index(crtc)] |=
+			new_exynos_crtc_state->freed_win_mask;
+	}
+	spin_unlock_irqrestore(&private->lock, flags);
+}
+
+void exynos_atomic_release_windows(struct drm_crtc *crtc,
+				   const struct drm_crtc_state *new_crtc_state)
+{
+	struct exynos_drm_private *private = drm_to_exynos_dev(crtc->dev);
+	const struct exynos_drm_crtc_state *new_exynos_crtc_state =
+		to_exynos_crtc_state(new_crtc_state);
+	unsigned long flags;
+
+	if (!new_exynos_crtc_state->freed_win_mask)
+		return;
+
+	spin_lock_irqsave(&private->lock, flags);
+	private->pending_win_mask[drm_crtc_index(crtc)] &= ~new_exynos_crtc_state->freed_win_mask;
+	spin_unlock_irqrestore(&private->lock, flags);
+}
+
+static void exynos_atomic_wait_for_windows(struct drm_atomic_state *old_state)
+{
+	const struct exynos_drm_atomic_state *exynos_state = to_exynos_atomic_state(old_state);
+	int i;
+
+	for (i = 0; i < MAX_CRTC; i++) {
+		struct drm_crtc_commit *commit = exynos_state->win_commits[i];
+
+		if (!commit)
+			continue;
+
+		if (!wait_for_completion_timeout(&commit->hw_done, 10 * HZ))
+			DRM_ERROR("[CRTC:%d:%s] hw_done timed out releasing windows\n",
+				  commit->crtc->base.id, commit->crtc->name);
+	}
+}
+
 static void commit_tail(struct drm_atomic_state *old_state)
 {
 	int i;
@@ -478,6 +759,8 @@ static void commit_tail(struct drm_atomic_state *old_state)
 	struct drm_crtc_state *old_crtc_state, *new_crtc_state;
 	struct drm_device *dev = old_state->dev;
 	unsigned int hibernation_crtc_mask = 0;
+	const ktime_t tail_start = ktime_get();
+	ktime_t start;
 
 	funcs = dev->mode_config.helper_private;
 
@@ -491,17 +774,23 @@ static void commit_tail(struct drm_atomic_state *old_state)
 		}
 	}
 
+	start = ktime_get();
 	DPU_ATRACE_BEGIN("wait_for_fences");
-	exynos_atomic_helper_wait_for_fences(dev, old_state, false);
+	exynos_atomic_helper_wait_for_fences(dev, old_state, false, ~0U);
 	DPU_ATRACE_END("wait_for_fences");
+	dpu_atomic_commit_stage_done(old_state, ~0U, DPU_COMMIT_WAIT_FENCES, start);
 
 	drm_atomic_helper_wait_for_dependencies(old_state);
 
+	exynos_atomic_wait_for_windows(old_state);
+
 	if (funcs && funcs->atomic_commit_tail)
 		funcs->atomic_commit_tail(old_state);
 	else
 		drm_atomic_helper_commit_tail(old_state);
 
+	dpu_atomic_commit_stage_done(old_state, ~0U, DPU_COMMIT_TAIL, tail_start);
+
 	for_each_new_crtc_in_state(old_state, crtc, new_crtc_state, i) {
 		decon = crtc_to_decon(crtc);
 		if (hibernation_crtc_mask & drm_crtc_mask(crtc))
@@ -513,13 +802,86 @@ static void commit_tail(struct drm_atomic_state *old_state)
 	drm_atomic_state_put(old_state);
 }
 
+static void exynos_atomic_wait_for_crtc_dependencies(struct drm_crtc *crtc,
+						     const struct drm_crtc_state *old_crtc_state)
+{
+	struct drm_crtc_commit *commit = old_crtc_state->commit;
+
+	if (!commit)
+		return;
+
+	if (!wait_for_completion_timeout(&commit->hw_done, 10 * HZ))
+		DRM_ERROR("[CRTC:%d:%s] hw_done timed out\n", crtc->base.id, crtc->name);
+
+	/* no support for overwriting flips, stall for previous one to execute completely */
+	if (!wait_for_completion_timeout(&commit->flip_done, 10 * HZ))
+		DRM_ERROR("[CRTC:%d:%s] flip_done timed out\n", crtc->base.id, crtc->name);
+}
+
+/* returns true if @crtc_commit was the last per crtc work of its state to finish */
+static bool exynos_atomic_crtc_commit_done(struct exynos_drm_crtc_commit *crtc_commit)
+{
+	return atomic_dec_and_test(&crtc_commit->state->pending_crtc_commits);
+}
+
+static void commit_tail_crtc(struct exynos_drm_crtc_commit *crtc_commit)
+{
+	struct exynos_drm_atomic_state *exynos_state = crtc_commit->state;
+	struct drm_atomic_state *old_state = &exynos_state->base;
+	struct drm_device *dev = old_state->dev;
+	struct drm_crtc *crtc = crtc_commit->crtc;
+	const struct drm_crtc_state *old_crtc_state = drm_atomic_get_old_crtc_state(old_state, crtc);
+	const struct drm_crtc_state *new_crtc_state = drm_atomic_get_new_crtc_state(old_state, crtc);
+	struct decon_device *decon = crtc_to_decon(crtc);
+	const bool block_hibernation = new_crtc_state->active || old_crtc_state->active;
+	const ktime_t tail_start = ktime_get();
+	ktime_t start;
+
+	if (block_hibernation)
+		hibernation_block(decon->hibernation);
+
+	start = ktime_get();
+	DPU_ATRACE_BEGIN("wait_for_fences");
+	exynos_atomic_helper_wait_for_fences(dev, old_state, false, drm_crtc_mask(crtc));
+	DPU_ATRACE_END("wait_for_fences");
+	dpu_commit_stage_done(decon, DPU_COMMIT_WAIT_FENCES, start);
+
+	exynos_atomic_wait_for_crtc_dependencies(crtc, old_crtc_state);
+
+	exynos_atomic_wait_for_windows(old_state);
+
+	exynos_atomic_commit_tail_crtc(old_state, crtc);
+
+	dpu_commit_stage_done(decon, DPU_COMMIT_TAIL, tail_start);
+
+	if (block_hibernation)
+		hibernation_unblock_enter(decon->hibernation);
+
+	/* last crtc to finish takes care of the state wide cleanup */
+	if (!exynos_atomic_crtc_commit_done(crtc_commit))
+		return;
+
+	drm_atomic_helper_cleanup_planes(dev, old_state);
+
+	drm_atomic_helper_commit_cleanup_done(old_state);
+
+	drm_atomic_state_put(old_state);
+}
+
 static void commit_kthread_work(struct kthread_work *work)
 {
-	struct exynos_drm_priv_state *exynos_priv_state =
-		container_of(work, struct exynos_drm_priv_state, commit_work);
-	struct drm_atomic_state *old_state = exynos_priv_state->old_state;
+	struct exynos_drm_atomic_state *exynos_state =
+		container_of(work, struct exynos_drm_atomic_state, commit_work);
 
-	commit_tail(old_state);
+	commit_tail(&exynos_state->base);
+}
+
+static void commit_crtc_kthread_work(struct kthread_work *work)
+{
+	struct exynos_drm_crtc_commit *crtc_commit =
+		container_of(work, struct exynos_drm_crtc_commit, work);
+
+	commit_tail_crtc(crtc_commit);
 }
 
 static void commit_work(struct work_struct *work)
@@ -530,25 +892,94 @@ static void commit_work(struct work_struct *work)
 	commit_tail(old_state);
 }
 
-static void exynos_atomic_queue_work(struct drm_atomic_state *old_state, bool nonblock,
-				     struct kthread_work *work)
+/*
+ * Returns mask of crtcs that can be committed in parallel on their own decon workers, or 0 if
+ * the commit has to be done as a whole. Only commits touching more than one crtc, without any
+ * modeset and without planes moving between crtcs are split.
+ */
+static u32 exynos_atomic_get_split_crtc_mask(struct drm_atomic_state *old_state)
+{
+	struct drm_crtc *crtc;
+	struct drm_crtc_state *new_crtc_state;
+	struct drm_plane *plane;
+	struct drm_plane_state *old_plane_state, *new_plane_state;
+	u32 crtc_mask = 0;
+	int i;
+
+	if (old_state->fake_commit)
+		return 0;
+
+	for_each_new_crtc_in_state(old_state, crtc, new_crtc_state, i) {
+		if (drm_atomic_crtc_needs_modeset(new_crtc_state))
+			return 0;
+
+		crtc_mask |= drm_crtc_mask(crtc);
+	}
+
+	if (hweight32(crtc_mask) < 2)
+		return 0;
+
+	for_each_oldnew_plane_in_state(old_state, plane, old_plane_state, new_plane_state, i) {
+		if (old_plane_state->crtc && new_plane_state->crtc &&
+		    old_plane_state->crtc != new_plane_state->crtc)
+			return 0;
+	}
+
+	return crtc_mask;
+}
+
+/* queue the per crtc works of @crtc_mask, each one on the worker of its own crtc */
+static void exynos_atomic_queue_crtc_commits(struct exynos_drm_atomic_state *exynos_state,
+		unsigned long crtc_mask, struct kthread_worker * const *workers,
+		kthread_work_func_t func)
 {
+	int i;
+
+	for_each_set_bit(i, &crtc_mask, MAX_CRTC)
+		kthread_init_work(&exynos_state->crtc_commit[i].work, func);
+	atomic_set(&exynos_state->pending_crtc_commits, hweight32(crtc_mask));
+
+	/* state may be released as soon as last crtc work is done, don't touch it after */
+	for_each_set_bit(i, &crtc_mask, MAX_CRTC)
+		kthread_queue_work(workers[i], &exynos_state->crtc_commit[i].work);
+}
+
+static void exynos_atomic_queue_work(struct drm_atomic_state *old_state)
+{
+	struct exynos_drm_atomic_state *exynos_state = to_exynos_atomic_state(old_state);
 	struct drm_crtc *crtc;
 	struct drm_crtc_state *old_crtc_state;
+	struct kthread_worker *workers[MAX_CRTC];
+	unsigned long crtc_mask;
 	int i;
 
+	crtc_mask = exynos_atomic_get_split_crtc_mask(old_state);
+	exynos_state->split_crtc_mask = crtc_mask;
+	if (crtc_mask) {
+		for_each_old_crtc_in_state(old_state, crtc, old_crtc_state, i) {
+			const unsigned int index = drm_crtc_index(crtc);
+			struct exynos_drm_crtc_commit *crtc_commit = &exynos_state->crtc_commit[index];
+			struct decon_device *decon = crtc_to_decon(crtc);
+
+			crtc_commit->crtc = crtc;
+			crtc_commit->state = exynos_state;
+			workers[index] = &decon->worker;
+		}
+		exynos_atomic_queue_crtc_commits(exynos_state, crtc_mask, workers,
+						 commit_crtc_kthread_work);
+
+		return;
+	}
+
 	/*
-	 * queuing to first decon worker in atomic commit even if there are
-	 * multiple displays updated within same commit
-	 *
-	 * TODO: can work be split per display?
+	 * queuing to first decon worker in atomic commit if the commit can't be split
+	 * between the displays that are updated within same commit
 	 */
 	for_each_old_crtc_in_state(old_state, crtc, old_crtc_state, i) {
-		struct exynos_drm_crtc *exynos_crtc =
-			container_of(crtc, struct exynos_drm_crtc, base);
-		struct decon_device *decon = exynos_crtc->ctx;
+		struct decon_device *decon = crtc_to_decon(crtc);
 
-		kthread_queue_work(&decon->worker, work);
+		kthread_init_work(&exynos_state->commit_work, commit_kthread_work);
+		kthread_queue_work(&decon->worker, &exynos_state->commit_work);
 
 		return;
 	}
@@ -560,7 +991,6 @@ static void exynos_atomic_queue_work(struct drm_atomic_state *old_state, bool no
 
 int exynos_atomic_commit(struct drm_device *dev, struct drm_atomic_state *state, bool nonblock)
 {
-	struct exynos_drm_priv_state *exynos_priv_state;
 	struct drm_crtc *crtc;
 	struct drm_crtc_state *old_crtc_state;
 	int i, ret;
@@ -590,15 +1020,6 @@ int exynos_atomic_commit(struct drm_device *dev, struct drm_atomic_state *state,
 	if (ret)
 		goto err;
 
-	exynos_priv_state = exynos_drm_get_priv_state(state);
-	if (IS_ERR(exynos_priv_state)) {
-		ret = PTR_ERR(exynos_priv_state);
-		goto err;
-	}
-
-	kthread_init_work(&exynos_priv_state->commit_work, commit_kthread_work);
-	exynos_priv_state->old_state = state;
-
 	ret = drm_atomic_helper_prepare_planes(dev, state);
 	if (ret)
 		goto err;
@@ -615,6 +1036,8 @@ int exynos_atomic_commit(struct drm_device *dev, struct drm_atomic_state *state,
 		goto err;
 	}
 
+	exynos_atomic_setup_windows(state);
+
 	/*
 	 * Everything below can be run asynchronously without the need to grab
 	 * any modeset locks at all under one condition: It must be guaranteed
@@ -639,7 +1062,7 @@ int exynos_atomic_commit(struct drm_device *dev, struct drm_atomic_state *state,
 	if (!nonblock)
 		commit_tail(state);
 	else
-		exynos_atomic_queue_work(state, nonblock, &exynos_priv_state->commit_work);
+		exynos_atomic_queue_work(state);
 
 err:
 	DPU_ATRACE_END("exynos_atomic_commit");
@@ -1227,6 +1650,8 @@ static int exynos_drm_init(void)
 {
 	int ret;
 
+	dpu_init_fmt_info();
+
 	ret = exynos_drm_register_devices();
 	if (ret)
 		return ret;
@@ -1249,6 +1674,10 @@ static void exynos_drm_exit(void)
 	exynos_drm_unregister_devices();
 }
 
+#if IS_ENABLED(CONFIG_DRM_SAMSUNG_KUNIT_TEST)
+#include "tests/exynos_drm_drv_test.c"
+#endif
+
 module_init(exynos_drm_init);
 module_exit(exynos_drm_exit);
 
@@ -121,6 +121,7 @@ struct exynos_drm_plane_state {
 	struct drm_property_blob *gm;
 	struct drm_property_blob *tm;
 	struct drm_property_blob *block;
+	const struct dpu_fmt *fmt_info;	/* format of fb, set in atomic check */
 };
 
 static inline struct exynos_drm_plane_state *
@@ -275,6 +276,11 @@ struct exynos_drm_crtc_state {
 
 	unsigned int reserved_win_mask;
 	unsigned int visible_win_mask;
+	/**
+	 * @freed_win_mask: windows released by this state, they're only given back for use by
+	 *		    other crtcs once commit to hw is done
+	 */
+	unsigned int freed_win_mask;
 	struct drm_rect partial_region;
 	struct drm_property_blob *partial;
 	bool needs_reconfigure;
@@ -335,9 +341,6 @@ struct exynos_drm_pending_histogram_event {
 struct exynos_drm_priv_state {
 	struct drm_private_state base;
 
-	struct drm_atomic_state *old_state;
-	struct kthread_work commit_work;
-
 	unsigned int available_win_mask;
 };
 
@@ -347,6 +350,50 @@ to_exynos_priv_state(const struct drm_private_state *state)
 	return container_of(state, struct exynos_drm_priv_state, base);
 }
 
+struct exynos_drm_atomic_state;
+
+/*
+ * Exynos per crtc commit work.
+ *
+ * @work: kthread work queued on the decon worker owning @crtc
+ * @crtc: crtc whose part of the atomic state is committed by this work
+ * @state: atomic state this work belongs to
+ */
+struct exynos_drm_crtc_commit {
+	struct kthread_work work;
+	struct drm_crtc *crtc;
+	struct exynos_drm_atomic_state *state;
+};
+
+/*
+ * Exynos drm atomic state structure.
+ *
+ * @base: atomic state object
+ * @commit_work: work used when the whole state is committed on a single worker
+ * @crtc_commit: per crtc works used when commit is split between crtcs
+ * @split_crtc_mask: crtcs committed in parallel, 0 if commit is not split
+ * @pending_crtc_commits: number of per crtc works yet to finish
+ * @win_wait_crtc_mask: crtcs still releasing windows that are reserved by this state
+ * @win_commits: in flight commits releasing windows reserved by this state, their hw_done
+ *		 needs to be signaled before this state can be committed
+ */
+struct exynos_drm_atomic_state {
+	struct drm_atomic_state base;
+
+	struct kthread_work commit_work;
+	struct exynos_drm_crtc_commit crtc_commit[MAX_CRTC];
+	u32 split_crtc_mask;
+	atomic_t pending_crtc_commits;
+	u32 win_wait_crtc_mask;
+	struct drm_crtc_commit *win_commits[MAX_CRTC];
+};
+
+static inline struct exynos_drm_atomic_state *
+to_exynos_atomic_state(const struct drm_atomic_state *state)
+{
+	return container_of(state, struct exynos_drm_atomic_state, base);
+}
+
 /*
  * Exynos drm private structure.
  *
@@ -356,8 +403,9 @@ to_exynos_priv_state(const struct drm_private_state *state)
  * @da_space_size: size of device address space.
  *	if 0 then default value is used for it.
  * @pending: the crtcs that have pending updates to finish
- * @lock: protect access to @pending
+ * @lock: protect access to @pending and @pending_win_mask
  * @wait: wait an atomic commit to finish
+ * @pending_win_mask: windows released per crtc by commits which are not done in hw yet
  */
 struct exynos_drm_private {
 	struct drm_device drm;
@@ -371,6 +419,7 @@ struct exynos_drm_private {
 	u32			pending;
 	spinlock_t		lock;
 	wait_queue_head_t	wait;
+	unsigned int		pending_win_mask[MAX_CRTC];
 
 	struct exynos_drm_connector_properties connector_props;
 	struct drm_private_obj	obj;
@@ -399,6 +448,11 @@ static inline int exynos_dpi_bind(struct drm_device *dev,
 int exynos_atomic_commit(struct drm_device *dev, struct drm_atomic_state *state,
 			 bool nonblock);
 int exynos_atomic_check(struct drm_device *dev, struct drm_atomic_state *state);
+struct drm_atomic_state *exynos_atomic_state_alloc(struct drm_device *dev);
+void exynos_atomic_state_free(struct drm_atomic_state *state);
+void exynos_atomic_commit_tail_crtc(struct drm_atomic_state *old_state, struct drm_crtc *crtc);
+void exynos_atomic_release_windows(struct drm_crtc *crtc,
+				   const struct drm_crtc_state *new_crtc_state);
 int exynos_atomic_enter_tui(void);
 int exynos_atomic_exit_tui(void);
 
@@ -394,11 +394,22 @@ static void _dsim_enter_ulps_locked(struct dsim_device *dsim)
 	DPU_ATRACE_END(__func__);
 }
 
+/* lets asynchronous requests already queued go out first */
+static void dsim_async_drain(struct dsim_device *dsim)
+{
+	if (current == dsim->async_thread)
+		return;
+
+	wait_event(dsim->async_wait, list_empty_careful(&dsim->async_list));
+}
+
 static void _dsim_disable(struct dsim_device *dsim)
 {
 	const struct decon_device *decon = dsim_get_decon(dsim);
 	struct dsim_device *sec_dsi;
 
+	dsim_async_drain(dsim);
+
 	if (dsim->dual_dsi == DSIM_DUAL_DSI_MAIN) {
 		sec_dsi = exynos_get_dual_dsi(DSIM_DUAL_DSI_SEC);
 		if (sec_dsi)
@@ -1865,29 +1876,9 @@ static int dsim_wait_for_cmd_fifo_empty(struct dsim_device *dsim, bool is_long)
 static void
 dsim_write_payload(struct dsim_device *dsim, const u8* buf, size_t len)
 {
-	const u8 *p = buf;
-	const u8 *end = buf + len;
-	u32 payload;
-
 	dsim_debug(dsim, "payload length(%lu)\n", len);
 
-	while (p < end) {
-		size_t pkt_size = min_t(size_t, 4, end - p);
-
-		if (pkt_size >= 4)
-			payload = p[0] | p[1] << 8 | p[2] << 16 | p[3] << 24;
-		else if (pkt_size == 3)
-			payload = p[0] | p[1] << 8 | p[2] << 16;
-		else if (pkt_size == 2)
-			payload = p[0] | p[1] << 8;
-		else if (pkt_size == 1)
-			payload = p[0];
-
-		dsim_reg_wr_tx_payload(dsim->id, payload);
-		dsim_debug(dsim, "payload: 0x%x\n", payload);
-
-		p += pkt_size;
-	}
+	dsim_reg_wr_tx_payloads(dsim->id, buf, len);
 }
 
 static void __dsim_write_data(struct dsim_device *dsim,
@@ -1981,21 +1972,186 @@ static void need_wait_vblank(struct dsim_device *dsim)
 	drm_crtc_vblank_put(crtc);
 }
 
-#define PL_FIFO_THRESHOLD	mult_frac(MAX_PL_FIFO, 75, 100) /* 75% */
 #define IS_LAST(flags)		(((flags) & MIPI_DSI_MSG_LASTCOMMAND) != 0)
+
+/* sends out the commands held in the fifos with packet go */
+static int dsim_flush_pending_locked(struct dsim_device *dsim, u16 flags, bool is_long)
+{
+	int ret;
+
+	if (!(flags & EXYNOS_DSI_MSG_IGNORE_VBLANK))
+		need_wait_vblank(dsim);
+
+	dsim_reg_ready_packetgo(dsim->id, true);
+	dsim_debug(dsim, "packet go ready\n");
+
+	ret = dsim_wait_for_cmd_fifo_empty(dsim, is_long);
+	if (ret)
+		dsim_err(dsim, "packet go burst not completed. pend ph/pl(%u,%u)\n",
+				dsim->total_pend_ph, dsim->total_pend_pl);
+
+	/* the pm reference is dropped either way, start the next batch clean */
+	dsim_reg_enable_packetgo(dsim->id, false);
+	dsim->total_pend_ph = 0;
+	dsim->total_pend_pl = 0;
+
+	pm_runtime_put_sync(dsim->dev);
+
+	return ret;
+}
+
+/*
+ * Sends out the commands pending so far as their own packet go burst, so that
+ * a batch larger than the fifos is split into bursts in order. Each burst
+ * waits for the command allow window on its own.
+ */
+static int dsim_split_batch_locked(struct dsim_device *dsim, u16 flags)
+{
+	const bool is_long = dsim->total_pend_pl != 0;
+	int ret;
+
+	dsim_debug(dsim, "split batch. pend ph/pl(%u,%u)\n",
+			dsim->total_pend_ph, dsim->total_pend_pl);
+
+	reinit_completion(is_long ? &dsim->pl_wr_comp : &dsim->ph_wr_comp);
+	DPU_ATRACE_BEGIN("dsim_split_batch");
+	ret = dsim_flush_pending_locked(dsim, flags, is_long);
+	DPU_ATRACE_END("dsim_split_batch");
+
+	return ret;
+}
+
+/*
+ * Queues @ph packets with @pl payload bytes in the current batch, taking the
+ * steps dsim_plan_cmd_batch() asks for before they can be written. Returns the
+ * planned steps, the caller writes the packets and flushes the batch if asked.
+ */
+static int dsim_queue_batch_locked(struct dsim_device *dsim, u16 flags,
+				   u32 ph, u32 pl, bool last, bool image)
+{
+	int steps, ret;
+
+	steps = dsim_plan_cmd_batch(dsim->total_pend_ph, dsim->total_pend_pl,
+				    ph, pl, last, image);
+	if (steps < 0) {
+		dsim_err(dsim, "command too large for fifo. ph(%u) pl(%u) max(%d/%d)\n",
+				ph, pl, MAX_PH_FIFO, MAX_PL_FIFO);
+		return steps;
+	}
+
+	if (steps & DSIM_BATCH_SPLIT) {
+		ret = dsim_split_batch_locked(dsim, flags);
+		if (ret)
+			return ret;
+	}
+
+	if (steps & DSIM_BATCH_SINGLE)
+		return steps;
+
+	if (steps & DSIM_BATCH_START) {
+		pm_runtime_get_sync(dsim->dev);
+		dsim_reg_enable_packetgo(dsim->id, true);
+	}
+	dsim->total_pend_ph += ph;
+	dsim->total_pend_pl += pl;
+
+	return steps;
+}
+
+static void dsim_write_cmd_image_locked(struct dsim_device *dsim,
+					const struct exynos_dsi_cmd_image *img)
+{
+	const u32 *w = img->words;
+	const u32 *end = w + img->num_words;
+
+	while (w < end) {
+		const u32 hdr = *w++;
+		const u8 type = hdr & 0xff;
+		const u8 d0 = (hdr >> 8) & 0xff;
+		const u8 d1 = (hdr >> 16) & 0xff;
+
+		if (mipi_dsi_packet_format_is_long(type)) {
+			const u16 wc = d0 | d1 << 8;
+
+			trace_dsi_tx(type, (const u8 *)w, wc, false);
+			dsim_reg_wr_tx_payloads(dsim->id, (const u8 *)w, wc);
+			w += DIV_ROUND_UP(wc, 4);
+		} else {
+			const u8 buf[] = { d0, d1 };
+
+			trace_dsi_tx(type, buf, type == MIPI_DSI_DCS_SHORT_WRITE ? 1 : 2, false);
+		}
+
+		dsim_reg_wr_tx_header(dsim->id, type, d0, d1, false);
+	}
+
+	dsim_debug(dsim, "cmd image: %u packets, %u payload bytes\n",
+			img->num_pkts, img->pl_len);
+}
+
+/*
+ * Pushes a precompiled command image. In command mode the image is batched
+ * with packet go, appended to any commands already pending.
+ */
+static int
+dsim_write_cmd_image(struct dsim_device *dsim, const struct mipi_dsi_msg *msg)
+{
+	const struct exynos_dsi_cmd_image *img = msg->tx_buf;
+	const u16 flags = msg->flags;
+	int steps, ret = 0;
+
+	if (WARN_ON(!img || msg->tx_len != sizeof(*img) || !img->num_pkts))
+		return -EINVAL;
+
+	if (dsim->config.mode == DSIM_VIDEO_MODE) {
+		const bool is_long = img->pl_len != 0;
+
+		dsim_reg_clear_int(dsim->id, DSIM_INTSRC_SFR_PH_FIFO_EMPTY);
+		reinit_completion(is_long ? &dsim->pl_wr_comp : &dsim->ph_wr_comp);
+		dsim_write_cmd_image_locked(dsim, img);
+
+		return dsim_wait_for_cmd_fifo_empty(dsim, is_long);
+	}
+
+	steps = dsim_queue_batch_locked(dsim, flags, img->num_pkts, img->pl_len,
+					IS_LAST(flags) && !dsim->force_batching, true);
+	if (steps < 0)
+		return steps;
+
+	if (steps & DSIM_BATCH_FLUSH) {
+		const bool is_long = dsim->total_pend_pl != 0;
+
+		reinit_completion(is_long ? &dsim->pl_wr_comp : &dsim->ph_wr_comp);
+		dsim_write_cmd_image_locked(dsim, img);
+		ret = dsim_flush_pending_locked(dsim, flags, is_long);
+	} else {
+		dsim_write_cmd_image_locked(dsim, img);
+	}
+
+	trace_dsi_cmd_fifo_status(dsim->total_pend_ph, dsim->total_pend_pl);
+
+	return ret;
+}
+
 static int
 dsim_write_data(struct dsim_device *dsim, const struct mipi_dsi_msg *msg)
 {
-	int ret = 0;
+	int steps, ret = 0;
 	u16 flags = msg->flags;
 	bool is_long;
 	bool is_empty_msg;
 	bool is_last;
+	u32 pl_len;
+
+	if (flags & EXYNOS_DSI_MSG_CMD_IMAGE)
+		return dsim_write_cmd_image(dsim, msg);
 
 	DPU_ATRACE_BEGIN(__func__);
 
 	is_empty_msg = !msg->tx_buf || msg->tx_len == 0;
 	is_long = mipi_dsi_packet_format_is_long(msg->type);
+	/* only long packets take room in the payload fifo */
+	pl_len = is_long ? ALIGN(msg->tx_len, 4) : 0;
 	if (dsim->config.mode == DSIM_VIDEO_MODE) {
 		if (flags & (EXYNOS_DSI_MSG_FORCE_BATCH | EXYNOS_DSI_MSG_FORCE_FLUSH))
 			dsim_warn(dsim, "force batching is attempted in video mode\n");
@@ -2010,16 +2166,6 @@ dsim_write_data(struct dsim_device *dsim, const struct mipi_dsi_msg *msg)
 		goto err;
 	}
 
-	if (((dsim->total_pend_pl + msg->tx_len) > MAX_PL_FIFO) ||
-			(dsim->total_pend_ph == MAX_PH_FIFO)) {
-		dsim_err(dsim, "fifo would be full. ph(%u) pl(%lu) max(%d/%d)\n",
-				dsim->total_pend_ph,
-				dsim->total_pend_pl + msg->tx_len,
-				MAX_PH_FIFO, MAX_PL_FIFO);
-		ret = -EINVAL;
-		goto err;
-	}
-
 	is_last = (IS_LAST(flags) && !dsim->force_batching) || (flags & EXYNOS_DSI_MSG_FORCE_FLUSH);
 
 	if (flags & EXYNOS_DSI_MSG_FORCE_FLUSH) {
@@ -2027,49 +2173,35 @@ dsim_write_data(struct dsim_device *dsim, const struct mipi_dsi_msg *msg)
 		WARN_ON(!is_empty_msg);
 	}
 
-	if (!is_last && !is_empty_msg &&
-		(((dsim->total_pend_ph + 1) == MAX_PH_FIFO) ||
-		((dsim->total_pend_pl + msg->tx_len) > PL_FIFO_THRESHOLD))) {
+	if (is_empty_msg) {
+		if (is_last && dsim->total_pend_ph) {
+			reinit_completion(is_long ? &dsim->pl_wr_comp : &dsim->ph_wr_comp);
+			ret = dsim_flush_pending_locked(dsim, flags, is_long);
+		}
+		goto err;
+	}
+
+	steps = dsim_queue_batch_locked(dsim, flags, 1, pl_len, is_last, false);
+	if (steps < 0) {
+		ret = steps;
+		goto err;
+	}
+
+	if ((steps & DSIM_BATCH_FLUSH) && !is_last)
 		dsim_warn(dsim, "warning. changed last command. pend pl/pl(%u,%u)\n",
 				dsim->total_pend_ph, dsim->total_pend_pl);
-		is_last = true;
-	}
+	is_last = steps & (DSIM_BATCH_SINGLE | DSIM_BATCH_FLUSH);
 
 	trace_dsi_tx(msg->type, msg->tx_buf, msg->tx_len, is_last);
 	dsim_debug(dsim, "%s last command\n", is_last ? "" : "Not");
 
-	if (is_last) {
-		if (dsim->total_pend_ph) {
-			reinit_completion(is_long ?
-					&dsim->pl_wr_comp : &dsim->ph_wr_comp);
-
-			if (!is_empty_msg)
-				__dsim_write_data(dsim, msg, is_long);
-
-			if (!(flags & EXYNOS_DSI_MSG_IGNORE_VBLANK))
-				need_wait_vblank(dsim);
-
-			dsim_reg_ready_packetgo(dsim->id, true);
-			dsim_debug(dsim, "packet go ready\n");
-
-			ret = dsim_wait_for_cmd_fifo_empty(dsim, is_long);
-			if (!ret) {
-				dsim_reg_enable_packetgo(dsim->id, false);
-				dsim->total_pend_ph = 0;
-				dsim->total_pend_pl = 0;
-			}
-
-			pm_runtime_put_sync(dsim->dev);
-		} else if (!is_empty_msg) {
-			ret = dsim_write_single_cmd_locked(dsim, msg, is_long);
-		}
-	} else if (!is_empty_msg) {
-		if (!dsim->total_pend_ph) {
-			pm_runtime_get_sync(dsim->dev);
-			dsim_reg_enable_packetgo(dsim->id, true);
-		}
-		dsim->total_pend_ph++;
-		dsim->total_pend_pl += ALIGN(msg->tx_len, 4);
+	if (steps & DSIM_BATCH_SINGLE) {
+		ret = dsim_write_single_cmd_locked(dsim, msg, is_long);
+	} else if (steps & DSIM_BATCH_FLUSH) {
+		reinit_completion(is_long ? &dsim->pl_wr_comp : &dsim->ph_wr_comp);
+		__dsim_write_data(dsim, msg, is_long);
+		ret = dsim_flush_pending_locked(dsim, flags, is_long);
+	} else {
 		__dsim_write_data(dsim, msg, is_long);
 		dsim_debug(dsim, "total pending packet header(%u) payload(%u)\n",
 				dsim->total_pend_ph, dsim->total_pend_pl);
@@ -2082,32 +2214,36 @@ err:
 }
 
 static int
-dsim_req_read_command(struct dsim_device *dsim, const struct mipi_dsi_msg *msg)
+dsim_req_read_command(struct dsim_device *dsim, const struct mipi_dsi_msg *msg,
+		      u16 *max_ret)
 {
 	struct mipi_dsi_packet packet;
 	const u8 rx_len = msg->rx_len & 0xff;
 
 	dsim_reg_clear_int(dsim->id, DSIM_INTSRC_SFR_PH_FIFO_EMPTY);
 	reinit_completion(&dsim->ph_wr_comp);
-	trace_dsi_tx(MIPI_DSI_SET_MAXIMUM_RETURN_PACKET_SIZE, &rx_len, 1, true);
-	/* set the maximum packet size returned */
-	dsim_reg_wr_tx_header(dsim->id, MIPI_DSI_SET_MAXIMUM_RETURN_PACKET_SIZE,
-			msg->rx_len, 0, false);
 
-	/* read request */
+	/* maximum return packet size if needed, then the read request */
 	mipi_dsi_create_packet(&packet, msg);
+	if (dsim_reg_wr_rx_request(dsim->id, packet.header[0], packet.header[1],
+				   packet.header[2], msg->rx_len, max_ret))
+		trace_dsi_tx(MIPI_DSI_SET_MAXIMUM_RETURN_PACKET_SIZE, &rx_len, 1, true);
 	trace_dsi_tx(msg->type, msg->tx_buf, msg->tx_len, true);
-	dsim_reg_wr_tx_header(dsim->id, packet.header[0], packet.header[1],
-						packet.header[2], true);
 
 	return dsim_wait_for_cmd_fifo_empty(dsim, false);
 }
 
+/*
+ * A single read, @max_ret tracks the maximum return packet size across the
+ * reads of a batch and is NULL otherwise, see dsim_reg_wr_rx_request().
+ */
 static int
-dsim_read_data(struct dsim_device *dsim, const struct mipi_dsi_msg *msg)
+dsim_read_data(struct dsim_device *dsim, const struct mipi_dsi_msg *msg,
+	       u16 *max_ret)
 {
-	u32 rx_fifo, rx_size = 0;
-	int i = 0, ret = 0;
+	u32 rx_fifo;
+	ssize_t rx_size;
+	int ret = 0;
 	u8 *rx_buf = msg->rx_buf;
 	const u8 *tx_buf = msg->tx_buf;
 
@@ -2122,7 +2258,7 @@ dsim_read_data(struct dsim_device *dsim, const struct mipi_dsi_msg *msg)
 
 	reinit_completion(&dsim->rd_comp);
 
-	ret = dsim_req_read_command(dsim, msg);
+	ret = dsim_req_read_command(dsim, msg, max_ret);
 	if (ret) {
 		dsim_err(dsim, "failed to request dsi read command\n");
 		return ret;
@@ -2133,58 +2269,16 @@ dsim_read_data(struct dsim_device *dsim, const struct mipi_dsi_msg *msg)
 		return -ETIMEDOUT;
 	}
 
-	rx_fifo = dsim_reg_get_rx_fifo(dsim->id);
-	dsim_debug(dsim, "rx fifo:0x%8x, response:0x%x, rx_len:%lu\n", rx_fifo,
-		 rx_fifo & 0xff, msg->rx_len);
-
-	/* Parse the RX packet data types */
-	switch (rx_fifo & 0xff) {
-	case MIPI_DSI_RX_ACKNOWLEDGE_AND_ERROR_REPORT:
-		ret = dsim_reg_rx_err_handler(dsim->id, rx_fifo);
-		if (ret < 0) {
-			dsim_dump(dsim);
-			return ret;
-		}
-		break;
-	case MIPI_DSI_RX_END_OF_TRANSMISSION:
-		dsim_debug(dsim, "EoTp was received\n");
-		break;
-	case MIPI_DSI_RX_DCS_SHORT_READ_RESPONSE_2BYTE:
-	case MIPI_DSI_RX_GENERIC_SHORT_READ_RESPONSE_2BYTE:
-		WARN_ON(msg->rx_len > 2);
-		rx_buf[1] = (rx_fifo >> 16) & 0xff;
-	case MIPI_DSI_RX_DCS_SHORT_READ_RESPONSE_1BYTE:
-	case MIPI_DSI_RX_GENERIC_SHORT_READ_RESPONSE_1BYTE:
-		rx_buf[0] = (rx_fifo >> 8) & 0xff;
-		dsim_debug(dsim, "short packet was received\n");
-		rx_size = msg->rx_len;
-		break;
-	case MIPI_DSI_RX_DCS_LONG_READ_RESPONSE:
-	case MIPI_DSI_RX_GENERIC_LONG_READ_RESPONSE:
-		dsim_debug(dsim, "long packet was received\n");
-		rx_size = (rx_fifo & 0x00ffff00) >> 8;
-
-		while (i < rx_size) {
-			const u32 rx_max =
-				min_t(u32, rx_size, i + sizeof(rx_fifo));
-
-			rx_fifo = dsim_reg_get_rx_fifo(dsim->id);
-			dsim_debug(dsim, "payload: 0x%x i=%d max=%d\n", rx_fifo,
-					i, rx_max);
-			for (; i < rx_max; i++, rx_fifo >>= 8)
-				rx_buf[i] = rx_fifo & 0xff;
-		}
-		break;
-	default:
-		dsim_err(dsim, "packet format is invalid.\n");
+	rx_size = dsim_reg_rd_rx_packet(dsim->id, rx_buf, msg->rx_len);
+	if (rx_size < 0) {
 		dsim_dump(dsim);
-		return -EBUSY;
+		return rx_size;
 	}
 
 	if (!dsim_reg_rx_fifo_is_empty(dsim->id)) {
 		u32 retry_cnt = RETRY_READ_FIFO_MAX;
 
-		dsim_warn(dsim, "RX FIFO is not empty: rx_size:%u, rx_len:%lu\n",
+		dsim_warn(dsim, "RX FIFO is not empty: rx_size:%zd, rx_len:%lu\n",
 			rx_size, msg->rx_len);
 		dsim_dump(dsim);
 		do {
@@ -2198,6 +2292,54 @@ dsim_read_data(struct dsim_device *dsim, const struct mipi_dsi_msg *msg)
 	return rx_size;
 }
 
+/*
+ * Runs the reads of an exynos_dsi_read_batch back to back within one transfer.
+ * The maximum return packet size is only sent again when the read length
+ * changes. Reads stop at the first failure, the ones not attempted get
+ * -ECANCELED. Returns the number of successful reads or the first error.
+ */
+static int
+dsim_read_batch(struct dsim_device *dsim, const struct mipi_dsi_msg *msg)
+{
+	const struct exynos_dsi_read_batch *batch = msg->tx_buf;
+	u16 max_ret = 0;
+	int ret = 0;
+	u32 i;
+
+	if (WARN_ON(!batch || msg->tx_len != sizeof(*batch)))
+		return -EINVAL;
+
+	DPU_ATRACE_BEGIN(__func__);
+	for (i = 0; i < batch->num_reads; i++) {
+		struct exynos_dsi_read *r = &batch->reads[i];
+		const struct mipi_dsi_msg rmsg = {
+			.channel = msg->channel,
+			.type = r->type,
+			.flags = msg->flags & ~EXYNOS_DSI_MSG_READ_BATCH,
+			.tx_buf = r->tx_buf,
+			.tx_len = r->tx_len,
+			.rx_buf = r->rx_buf,
+			.rx_len = r->rx_len,
+		};
+
+		if (ret < 0) {
+			r->ret = -ECANCELED;
+			continue;
+		}
+
+		r->ret = dsim_read_data(dsim, &rmsg, &max_ret);
+		if (r->ret < 0) {
+			ret = r->ret;
+			continue;
+		}
+
+		ret++;
+	}
+	DPU_ATRACE_END(__func__);
+
+	return ret;
+}
+
 static int
 dsim_write_data_dual(struct dsim_device *dsim, const struct mipi_dsi_msg *msg)
 {
@@ -2220,15 +2362,11 @@ dsim_write_data_dual(struct dsim_device *dsim, const struct mipi_dsi_msg *msg)
 
 	return ret;
 }
-static ssize_t dsim_host_transfer(struct mipi_dsi_host *host,
-			    const struct mipi_dsi_msg *msg)
+static int dsim_transfer(struct dsim_device *dsim, const struct mipi_dsi_msg *msg)
 {
-	struct dsim_device *dsim = host_to_dsi(host);
 	struct dsim_device *sec_dsi;
 	int ret;
 
-	DPU_ATRACE_BEGIN(__func__);
-
 	ret = pm_runtime_resume_and_get(dsim->dev);
 	if (ret) {
 		dsim_err(dsim, "runtime resume failed (%d). unable to transfer cmd\n", ret);
@@ -2246,7 +2384,10 @@ static ssize_t dsim_host_transfer(struct mipi_dsi_host *host,
 	case MIPI_DSI_GENERIC_READ_REQUEST_0_PARAM:
 	case MIPI_DSI_GENERIC_READ_REQUEST_1_PARAM:
 	case MIPI_DSI_GENERIC_READ_REQUEST_2_PARAM:
-		ret = dsim_read_data(dsim, msg);
+		if (msg->flags & EXYNOS_DSI_MSG_READ_BATCH)
+			ret = dsim_read_batch(dsim, msg);
+		else
+			ret = dsim_read_data(dsim, msg, NULL);
 		break;
 	default:
 		ret = dsim_write_data(dsim, msg);
@@ -2266,6 +2407,174 @@ abort:
 	pm_runtime_mark_last_busy(dsim->dev);
 	pm_runtime_put_sync_autosuspend(dsim->dev);
 
+	return ret;
+}
+
+/*
+ * Asynchronous requests are copied on submission and sent one after the other
+ * by async_thread. A command delay arms async_timer instead of sleeping, and
+ * the worker picks up the request again when it expires.
+ */
+struct dsim_async_req {
+	struct list_head list;
+	u8 channel;
+	u32 num_cmds;
+	u32 pos;
+	int ret;
+	void (*complete)(void *data, int ret);
+	void *data;
+	struct exynos_dsi_async_cmd cmds[];
+};
+
+static struct dsim_async_req *dsim_async_peek(struct dsim_device *dsim)
+{
+	struct dsim_async_req *req;
+	unsigned long flags;
+
+	spin_lock_irqsave(&dsim->async_lock, flags);
+	req = list_first_entry_or_null(&dsim->async_list, struct dsim_async_req, list);
+	spin_unlock_irqrestore(&dsim->async_lock, flags);
+
+	return req;
+}
+
+static void dsim_async_done(struct dsim_device *dsim, struct dsim_async_req *req)
+{
+	unsigned long flags;
+
+	if (req->ret)
+		dsim_err(dsim, "async request failed (%d) at cmd %u/%u\n",
+				req->ret, req->pos, req->num_cmds);
+
+	if (req->complete)
+		req->complete(req->data, req->ret);
+
+	spin_lock_irqsave(&dsim->async_lock, flags);
+	list_del(&req->list);
+	spin_unlock_irqrestore(&dsim->async_lock, flags);
+
+	kfree(req);
+	wake_up_all(&dsim->async_wait);
+}
+
+static void dsim_async_work(struct kthread_work *work)
+{
+	struct dsim_device *dsim = container_of(work, struct dsim_device, async_work);
+	struct dsim_async_req *req;
+
+	/* still inside the delay of the last command sent */
+	if (hrtimer_is_queued(&dsim->async_timer))
+		return;
+
+	DPU_ATRACE_BEGIN(__func__);
+	while ((req = dsim_async_peek(dsim))) {
+		while (req->pos < req->num_cmds) {
+			const struct exynos_dsi_async_cmd *cmd = &req->cmds[req->pos++];
+			const struct mipi_dsi_msg msg = {
+				.channel = req->channel,
+				.type = cmd->type,
+				.flags = cmd->flags,
+				.tx_buf = cmd->tx_buf,
+				.tx_len = cmd->tx_len,
+			};
+			int ret;
+
+			ret = dsim_transfer(dsim, &msg);
+			if (ret < 0) {
+				req->ret = ret;
+				break;
+			}
+
+			if (cmd->delay_us) {
+				/* also after the last one, it completes once expired */
+				hrtimer_start(&dsim->async_timer, us_to_ktime(cmd->delay_us),
+					      HRTIMER_MODE_REL);
+				goto out;
+			}
+		}
+
+		dsim_async_done(dsim, req);
+	}
+out:
+	DPU_ATRACE_END(__func__);
+}
+
+static enum hrtimer_restart dsim_async_timer(struct hrtimer *timer)
+{
+	struct dsim_device *dsim = container_of(timer, struct dsim_device, async_timer);
+
+	kthread_queue_work(&dsim->async_worker, &dsim->async_work);
+
+	return HRTIMER_NORESTART;
+}
+
+static int dsim_queue_async(struct dsim_device *dsim, const struct mipi_dsi_msg *msg)
+{
+	const struct exynos_dsi_async_req *areq = msg->tx_buf;
+	struct dsim_async_req *req;
+	unsigned long flags;
+	size_t pl_len = 0;
+	u8 *p;
+	u32 i;
+
+	if (WARN_ON(!areq || msg->tx_len != sizeof(*areq) || !areq->num_cmds))
+		return -EINVAL;
+
+	for (i = 0; i < areq->num_cmds; i++) {
+		const struct exynos_dsi_async_cmd *cmd = &areq->cmds[i];
+
+		/* only plain writes, their data is copied below */
+		if (cmd->flags & (EXYNOS_DSI_MSG_ASYNC | EXYNOS_DSI_MSG_CMD_IMAGE))
+			return -EINVAL;
+		pl_len += cmd->tx_len;
+	}
+
+	req = kmalloc(struct_size(req, cmds, areq->num_cmds) + pl_len, GFP_KERNEL);
+	if (!req)
+		return -ENOMEM;
+
+	req->channel = msg->channel;
+	req->num_cmds = areq->num_cmds;
+	req->pos = 0;
+	req->ret = 0;
+	req->complete = areq->complete;
+	req->data = areq->data;
+	memcpy(req->cmds, areq->cmds, areq->num_cmds * sizeof(*areq->cmds));
+
+	p = (u8 *)&req->cmds[req->num_cmds];
+	for (i = 0; i < req->num_cmds; i++) {
+		struct exynos_dsi_async_cmd *cmd = &req->cmds[i];
+
+		if (!cmd->tx_len)
+			continue;
+		memcpy(p, cmd->tx_buf, cmd->tx_len);
+		cmd->tx_buf = p;
+		p += cmd->tx_len;
+	}
+
+	spin_lock_irqsave(&dsim->async_lock, flags);
+	list_add_tail(&req->list, &dsim->async_list);
+	spin_unlock_irqrestore(&dsim->async_lock, flags);
+
+	kthread_queue_work(&dsim->async_worker, &dsim->async_work);
+
+	return 0;
+}
+
+static ssize_t dsim_host_transfer(struct mipi_dsi_host *host,
+			    const struct mipi_dsi_msg *msg)
+{
+	struct dsim_device *dsim = host_to_dsi(host);
+	int ret;
+
+	if (msg->flags & EXYNOS_DSI_MSG_ASYNC)
+		return dsim_queue_async(dsim, msg);
+
+	DPU_ATRACE_BEGIN(__func__);
+
+	dsim_async_drain(dsim);
+	ret = dsim_transfer(dsim, msg);
+
 	DPU_ATRACE_END(__func__);
 
 	return ret;
@@ -2598,6 +2907,14 @@ static int dsim_probe(struct platform_device *pdev)
 	init_completion(&dsim->pl_wr_comp);
 	init_completion(&dsim->rd_comp);
 
+	spin_lock_init(&dsim->async_lock);
+	INIT_LIST_HEAD(&dsim->async_list);
+	init_waitqueue_head(&dsim->async_wait);
+	hrtimer_init(&dsim->async_timer, CLOCK_MONOTONIC, HRTIMER_MODE_REL);
+	dsim->async_timer.function = dsim_async_timer;
+	kthread_init_worker(&dsim->async_worker);
+	kthread_init_work(&dsim->async_work, dsim_async_work);
+
 	ret = dsim_init_resources(dsim);
 	if (ret)
 		goto err;
@@ -2640,8 +2957,25 @@ static int dsim_probe(struct platform_device *pdev)
 			phy_init(dsim->res.phy_ex);
 	}
 
+	/* started last, nothing can queue async commands before bind */
+	dsim->async_thread = kthread_run(kthread_worker_fn, &dsim->async_worker,
+					 "dsim%d_cmd", dsim->id);
+	if (IS_ERR(dsim->async_thread)) {
+		dsim_err(dsim, "failed to run async cmd thread\n");
+		ret = PTR_ERR(dsim->async_thread);
+		dsim->async_thread = NULL;
+		goto err;
+	}
+
+	ret = component_add(dsim->dev, &dsim_component_ops);
+	if (ret) {
+		kthread_stop(dsim->async_thread);
+		dsim->async_thread = NULL;
+		goto err;
+	}
+
 	dsim_info(dsim, "driver has been probed.\n");
-	return component_add(dsim->dev, &dsim_component_ops);
+	return 0;
 
 err:
 	dsim_err(dsim, "failed to probe exynos dsim driver\n");
@@ -2656,6 +2990,11 @@ static int dsim_remove(struct platform_device *pdev)
 	device_remove_file(dsim->dev, &dev_attr_hs_clock);
 	pm_runtime_disable(&pdev->dev);
 
+	if (dsim->async_thread) {
+		dsim_async_drain(dsim);
+		kthread_stop(dsim->async_thread);
+	}
+
 	component_del(&pdev->dev, &dsim_component_ops);
 
 	iounmap(dsim->res.ss_reg_base);
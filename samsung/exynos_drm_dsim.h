@@ -16,6 +16,9 @@
 #define __EXYNOS_DRM_DSI_H__
 
 /* Add header */
+#include <linux/hrtimer.h>
+#include <linux/kthread.h>
+#include <linux/wait.h>
 #include <drm/drm_encoder.h>
 #include <drm/drm_mipi_dsi.h>
 #include <drm/drm_property.h>
@@ -119,6 +122,16 @@ struct dsim_device {
 	/* override message flag MIPI_DSI_MSG_LASTCOMMAND */
 	bool force_batching;
 
+	/* requests submitted with EXYNOS_DSI_MSG_ASYNC, sent by async_thread */
+	struct kthread_worker async_worker;
+	struct task_struct *async_thread;
+	struct kthread_work async_work;
+	/* per command delay, async_work is queued again when it expires */
+	struct hrtimer async_timer;
+	spinlock_t async_lock;
+	struct list_head async_list;
+	wait_queue_head_t async_wait;
+
 	enum dsim_dual_dsi dual_dsi;
 };
 
@@ -228,6 +228,14 @@ void *exynos_drm_fb_to_vaddr(const struct drm_framebuffer *fb)
 	return exynos_drm_gem_get_vaddr(exynos_gem);
 }
 
+static void fmt_info_to_win_config(struct dpu_bts_win_config *win_config,
+				   const struct dpu_fmt *fmt_info)
+{
+	win_config->format = fmt_info->fmt;
+	win_config->bpp = fmt_info->bpp + fmt_info->padding;
+	win_config->is_yuv = IS_YUV(fmt_info);
+}
+
 static void plane_state_to_win_config(struct dpu_bts_win_config *win_config,
 				      const struct drm_plane_state *plane_state)
 {
@@ -256,7 +264,7 @@ static void plane_state_to_win_config(struct dpu_bts_win_config *win_config,
 	else
 		win_config->state = DPU_WIN_STATE_BUFFER;
 
-	win_config->format = fb->format->format;
+	fmt_info_to_win_config(win_config, to_exynos_plane_state(plane_state)->fmt_info);
 	win_config->dpp_ch = plane_state->plane->index;
 
 	win_config->comp_src = 0;
@@ -293,6 +301,13 @@ static void conn_state_to_win_config(struct dpu_bts_win_config *win_config,
 {
 	const struct writeback_device *wb = conn_to_wb_dev(conn_state->connector);
 	const struct drm_framebuffer *fb = conn_state->writeback_job->fb;
+	const struct dpu_fmt *fmt_info = dpu_find_fmt_info(fb->format->format);
+
+	if (!fmt_info) {
+		DRM_ERROR("unsupported writeback format(%#x)\n", fb->format->format);
+		win_config->state = DPU_WIN_STATE_DISABLED;
+		return;
+	}
 
 	win_config->src_x = 0;
 	win_config->src_y = 0;
@@ -305,7 +320,7 @@ static void conn_state_to_win_config(struct dpu_bts_win_config *win_config,
 
 	win_config->is_comp = false;
 	win_config->state = DPU_WIN_STATE_BUFFER;
-	win_config->format = fb->format->format;
+	fmt_info_to_win_config(win_config, fmt_info);
 	win_config->dpp_ch = wb->id;
 	win_config->comp_src = 0;
 	win_config->is_rot = false;
@@ -323,7 +338,7 @@ static void conn_state_to_win_config(struct dpu_bts_win_config *win_config,
 }
 
 static void exynos_atomic_bts_pre_update(struct drm_device *dev,
-					 struct drm_atomic_state *old_state)
+					 struct drm_atomic_state *old_state, u32 crtc_mask)
 {
 	struct decon_device *decon;
 	struct drm_crtc *crtc;
@@ -342,6 +357,10 @@ static void exynos_atomic_bts_pre_update(struct drm_device *dev,
 
 	for_each_oldnew_plane_in_state(old_state, plane, old_plane_state,
 				       new_plane_state, i) {
+		crtc = new_plane_state->crtc ? : old_plane_state->crtc;
+		if (!crtc || !(drm_crtc_mask(crtc) & crtc_mask))
+			continue;
+
 		dpp = plane_to_dpp(to_exynos_plane(plane));
 		if (test_bit(DPP_ATTR_RCD, &dpp->attr)) {
 			if (new_plane_state->crtc) {
@@ -381,6 +400,10 @@ static void exynos_atomic_bts_pre_update(struct drm_device *dev,
 		if (conn->connector_type != DRM_MODE_CONNECTOR_WRITEBACK)
 			continue;
 
+		crtc = new_conn_state->crtc ? : old_conn_state->crtc;
+		if (!crtc || !(drm_crtc_mask(crtc) & crtc_mask))
+			continue;
+
 		conn_to_wb_dev(conn);
 
 		old_job = wb_check_job(old_conn_state);
@@ -401,7 +424,7 @@ static void exynos_atomic_bts_pre_update(struct drm_device *dev,
 		decon = crtc_to_decon(crtc);
 		exynos_crtc = to_exynos_crtc(crtc);
 
-		if (!new_crtc_state->active)
+		if (!new_crtc_state->active || !(drm_crtc_mask(crtc) & crtc_mask))
 			continue;
 
 		if (new_crtc_state->planes_changed) {
@@ -427,7 +450,7 @@ static void exynos_atomic_bts_pre_update(struct drm_device *dev,
 }
 
 static void exynos_atomic_bts_post_update(struct drm_device *dev,
-					  struct drm_atomic_state *old_state)
+					  struct drm_atomic_state *old_state, u32 crtc_mask)
 {
 	struct decon_device *decon;
 	struct drm_crtc *crtc;
@@ -440,6 +463,9 @@ static void exynos_atomic_bts_post_update(struct drm_device *dev,
 		return;
 
 	for_each_new_crtc_in_state(old_state, crtc, new_crtc_state, i) {
+		if (!(drm_crtc_mask(crtc) & crtc_mask))
+			continue;
+
 		decon = crtc_to_decon(crtc);
 
 		if (new_crtc_state->active) {
@@ -544,6 +570,67 @@ static void exynos_rmem_free(struct decon_device *decon)
 }
 
 
+static void exynos_atomic_connectors_pre_commit(struct drm_atomic_state *old_state,
+						u32 crtc_mask)
+{
+	struct drm_connector *connector;
+	struct drm_connector_state *old_conn_state, *new_conn_state;
+	const struct drm_crtc_state *new_crtc_state;
+	int i;
+
+	for_each_oldnew_connector_in_state(old_state, connector,
+				 old_conn_state, new_conn_state, i) {
+		if (!new_conn_state->crtc || !(drm_crtc_mask(new_conn_state->crtc) & crtc_mask))
+			continue;
+
+		new_crtc_state = drm_atomic_get_new_crtc_state(old_state, new_conn_state->crtc);
+		if (!new_crtc_state->active)
+			continue;
+
+		if (is_exynos_drm_connector(connector)) {
+			struct exynos_drm_connector *exynos_connector =
+				to_exynos_connector(connector);
+			const struct exynos_drm_connector_helper_funcs *funcs =
+				exynos_connector->helper_private;
+			if (!funcs->atomic_pre_commit)
+				continue;
+
+			funcs->atomic_pre_commit(exynos_connector,
+					to_exynos_connector_state(old_conn_state),
+					to_exynos_connector_state(new_conn_state));
+		}
+	}
+}
+
+static void exynos_atomic_connectors_commit(struct drm_atomic_state *old_state, u32 crtc_mask)
+{
+	struct drm_connector *connector;
+	struct drm_connector_state *old_conn_state, *new_conn_state;
+	const struct drm_crtc_state *new_crtc_state;
+	int i;
+
+	for_each_oldnew_connector_in_state(old_state, connector,
+				 old_conn_state, new_conn_state, i) {
+		if (!new_conn_state->crtc || !(drm_crtc_mask(new_conn_state->crtc) & crtc_mask))
+			continue;
+
+		new_crtc_state = drm_atomic_get_new_crtc_state(old_state, new_conn_state->crtc);
+		if (!new_crtc_state->active)
+			continue;
+
+		if (is_exynos_drm_connector(connector)) {
+			struct exynos_drm_connector *exynos_connector =
+				to_exynos_connector(connector);
+			const struct exynos_drm_connector_helper_funcs *funcs =
+				exynos_connector->helper_private;
+
+			funcs->atomic_commit(exynos_connector,
+					to_exynos_connector_state(old_conn_state),
+					to_exynos_connector_state(new_conn_state));
+		}
+	}
+}
+
 static void exynos_atomic_commit_tail(struct drm_atomic_state *old_state)
 {
 	int i;
@@ -551,10 +638,8 @@ static void exynos_atomic_commit_tail(struct drm_atomic_state *old_state)
 	struct decon_device *decon;
 	struct drm_crtc *crtc;
 	struct drm_crtc_state *old_crtc_state, *new_crtc_state;
-	struct drm_connector *connector;
-	struct drm_connector_state *old_conn_state;
-	struct drm_connector_state *new_conn_state;
 	unsigned int disabling_crtc_mask = 0;
+	ktime_t start;
 
 	DPU_ATRACE_BEGIN("exynos_atomic_commit_tail");
 
@@ -609,43 +694,28 @@ static void exynos_atomic_commit_tail(struct drm_atomic_state *old_state)
 			old_crtc_state->active = true;
 	}
 
+	start = ktime_get();
 	DPU_ATRACE_BEGIN("modeset");
 	drm_atomic_helper_commit_modeset_disables(dev, old_state);
 
-	exynos_atomic_bts_pre_update(dev, old_state);
+	exynos_atomic_bts_pre_update(dev, old_state, ~0U);
 
 	drm_atomic_helper_commit_modeset_enables(dev, old_state);
 	DPU_ATRACE_END("modeset");
+	dpu_atomic_commit_stage_done(old_state, ~0U, DPU_COMMIT_MODESET, start);
 
+	start = ktime_get();
 	DPU_ATRACE_BEGIN("connector_pre_commit");
-	for_each_oldnew_connector_in_state(old_state, connector,
-				 old_conn_state, new_conn_state, i) {
-		if (!new_conn_state->crtc)
-			continue;
-
-		new_crtc_state = drm_atomic_get_new_crtc_state(old_state, new_conn_state->crtc);
-		if (!new_crtc_state->active)
-			continue;
-
-		if (is_exynos_drm_connector(connector)) {
-			struct exynos_drm_connector *exynos_connector =
-				to_exynos_connector(connector);
-			const struct exynos_drm_connector_helper_funcs *funcs =
-				exynos_connector->helper_private;
-			if (!funcs->atomic_pre_commit)
-				continue;
-
-			funcs->atomic_pre_commit(exynos_connector,
-					to_exynos_connector_state(old_conn_state),
-					to_exynos_connector_state(new_conn_state));
-		}
-	}
+	exynos_atomic_connectors_pre_commit(old_state, ~0U);
 	DPU_ATRACE_END("connector_pre_commit");
+	dpu_atomic_commit_stage_done(old_state, ~0U, DPU_COMMIT_CONNECTOR_PRE_COMMIT, start);
 
+	start = ktime_get();
 	DPU_ATRACE_BEGIN("commit_planes");
 	drm_atomic_helper_commit_planes(dev, old_state,
 					DRM_PLANE_COMMIT_ACTIVE_ONLY);
 	DPU_ATRACE_END("commit_planes");
+	dpu_atomic_commit_stage_done(old_state, ~0U, DPU_COMMIT_PLANES, start);
 
 	/*
 	 * hw is flushed at this point, signal flip done for fake commit to
@@ -656,37 +726,26 @@ static void exynos_atomic_commit_tail(struct drm_atomic_state *old_state)
 
 	drm_atomic_helper_fake_vblank(old_state);
 
+	start = ktime_get();
 	DPU_ATRACE_BEGIN("connector_commit");
-	for_each_oldnew_connector_in_state(old_state, connector,
-				 old_conn_state, new_conn_state, i) {
-		if (!new_conn_state->crtc)
-			continue;
-
-		new_crtc_state = drm_atomic_get_new_crtc_state(old_state, new_conn_state->crtc);
-		if (!new_crtc_state->active)
-			continue;
-
-		if (is_exynos_drm_connector(connector)) {
-			struct exynos_drm_connector *exynos_connector =
-				to_exynos_connector(connector);
-			const struct exynos_drm_connector_helper_funcs *funcs =
-				exynos_connector->helper_private;
-
-			funcs->atomic_commit(exynos_connector,
-					to_exynos_connector_state(old_conn_state),
-					to_exynos_connector_state(new_conn_state));
-		}
-	}
+	exynos_atomic_connectors_commit(old_state, ~0U);
 	DPU_ATRACE_END("connector_commit");
+	dpu_atomic_commit_stage_done(old_state, ~0U, DPU_COMMIT_CONNECTOR_COMMIT, start);
+	start = ktime_get();
 	DPU_ATRACE_BEGIN("wait_for_crtc_flip");
 	exynos_crtc_wait_for_flip_done(old_state);
 	DPU_ATRACE_END("wait_for_crtc_flip");
+	dpu_atomic_commit_stage_done(old_state, ~0U, DPU_COMMIT_WAIT_CRTC_FLIP, start);
 
+	start = ktime_get();
 	DPU_ATRACE_BEGIN("wait_for_flip_done");
 	drm_atomic_helper_wait_for_flip_done(dev, old_state);
 	DPU_ATRACE_END("wait_for_flip_done");
+	dpu_atomic_commit_stage_done(old_state, ~0U, DPU_COMMIT_WAIT_FLIP_DONE, start);
 
-	exynos_atomic_bts_post_update(dev, old_state);
+	start = ktime_get();
+	exynos_atomic_bts_post_update(dev, old_state, ~0U);
+	dpu_atomic_commit_stage_done(old_state, ~0U, DPU_COMMIT_BTS_POST_UPDATE, start);
 
 	for_each_new_crtc_in_state(old_state, crtc, new_crtc_state, i) {
 		decon = crtc_to_decon(crtc);
@@ -699,6 +758,8 @@ static void exynos_atomic_commit_tail(struct drm_atomic_state *old_state)
 			if (!exynos_crtc_state->skip_update)
 				exynos_rmem_free(decon);
 		}
+
+		exynos_atomic_release_windows(crtc, new_crtc_state);
 	}
 
 	drm_atomic_helper_commit_hw_done(old_state);
@@ -708,6 +769,123 @@ static void exynos_atomic_commit_tail(struct drm_atomic_state *old_state)
 	DPU_ATRACE_END("exynos_atomic_commit_tail");
 }
 
+/* same as drm_atomic_helper_fake_vblank() but limited to a single crtc */
+static void exynos_atomic_fake_vblank_crtc(struct drm_crtc *crtc,
+					   struct drm_crtc_state *new_crtc_state)
+{
+	unsigned long flags;
+
+	if (!new_crtc_state->no_vblank || !new_crtc_state->event)
+		return;
+
+	spin_lock_irqsave(&crtc->dev->event_lock, flags);
+	drm_crtc_send_vblank_event(crtc, new_crtc_state->event);
+	spin_unlock_irqrestore(&crtc->dev->event_lock, flags);
+
+	new_crtc_state->event = NULL;
+}
+
+/* same as drm_atomic_helper_commit_hw_done() but limited to a single crtc */
+static void exynos_atomic_commit_hw_done_crtc(struct drm_crtc_state *old_crtc_state,
+					      struct drm_crtc_state *new_crtc_state)
+{
+	struct drm_crtc_commit *commit = new_crtc_state->commit;
+
+	exynos_atomic_release_windows(new_crtc_state->crtc, new_crtc_state);
+
+	if (!commit)
+		return;
+
+	/* it's unsafe to touch new_crtc_state after hw_done, keep commit in old state instead */
+	if (old_crtc_state->commit)
+		drm_crtc_commit_put(old_crtc_state->commit);
+
+	old_crtc_state->commit = drm_crtc_commit_get(commit);
+
+	/* backend must have consumed any event by now */
+	WARN_ON(new_crtc_state->event);
+	complete_all(&commit->hw_done);
+}
+
+/*
+ * Commit tail for a single crtc within an atomic state without any modeset. This allows
+ * updates to different displays within the same atomic state to run in parallel, state
+ * wide cleanup is left to the caller once all crtcs have been committed.
+ */
+void exynos_atomic_commit_tail_crtc(struct drm_atomic_state *old_state, struct drm_crtc *crtc)
+{
+	struct drm_device *dev = old_state->dev;
+	struct exynos_drm_crtc *exynos_crtc = to_exynos_crtc(crtc);
+	struct decon_device *decon = crtc_to_decon(crtc);
+	struct drm_crtc_state *old_crtc_state = drm_atomic_get_old_crtc_state(old_state, crtc);
+	struct drm_crtc_state *new_crtc_state = drm_atomic_get_new_crtc_state(old_state, crtc);
+	const u32 crtc_mask = drm_crtc_mask(crtc);
+	struct drm_crtc_commit *commit;
+	ktime_t start;
+
+	DPU_ATRACE_BEGIN("exynos_atomic_commit_tail_crtc");
+
+	DPU_EVENT_LOG(DPU_EVT_REQ_CRTC_INFO_OLD, decon->id, old_crtc_state);
+	DPU_EVENT_LOG(DPU_EVT_REQ_CRTC_INFO_NEW, decon->id, new_crtc_state);
+
+	exynos_atomic_bts_pre_update(dev, old_state, crtc_mask);
+
+	if (new_crtc_state->active) {
+		start = ktime_get();
+		DPU_ATRACE_BEGIN("connector_pre_commit");
+		exynos_atomic_connectors_pre_commit(old_state, crtc_mask);
+		DPU_ATRACE_END("connector_pre_commit");
+		dpu_commit_stage_done(decon, DPU_COMMIT_CONNECTOR_PRE_COMMIT, start);
+
+		start = ktime_get();
+		DPU_ATRACE_BEGIN("commit_planes");
+		drm_atomic_helper_commit_planes_on_crtc(old_crtc_state);
+		DPU_ATRACE_END("commit_planes");
+		dpu_commit_stage_done(decon, DPU_COMMIT_PLANES, start);
+	}
+
+	exynos_atomic_fake_vblank_crtc(crtc, new_crtc_state);
+
+	if (new_crtc_state->active) {
+		start = ktime_get();
+		DPU_ATRACE_BEGIN("connector_commit");
+		exynos_atomic_connectors_commit(old_state, crtc_mask);
+		DPU_ATRACE_END("connector_commit");
+		dpu_commit_stage_done(decon, DPU_COMMIT_CONNECTOR_COMMIT, start);
+	}
+
+	start = ktime_get();
+	DPU_ATRACE_BEGIN("wait_for_crtc_flip");
+	if (exynos_crtc->ops->wait_for_flip_done)
+		exynos_crtc->ops->wait_for_flip_done(exynos_crtc, old_crtc_state, new_crtc_state);
+	DPU_ATRACE_END("wait_for_crtc_flip");
+	dpu_commit_stage_done(decon, DPU_COMMIT_WAIT_CRTC_FLIP, start);
+
+	start = ktime_get();
+	DPU_ATRACE_BEGIN("wait_for_flip_done");
+	commit = new_crtc_state->commit;
+	if (commit && !wait_for_completion_timeout(&commit->flip_done, HZ))
+		DRM_ERROR("[CRTC:%d:%s] flip_done timed out\n", crtc->base.id, crtc->name);
+	DPU_ATRACE_END("wait_for_flip_done");
+	dpu_commit_stage_done(decon, DPU_COMMIT_WAIT_FLIP_DONE, start);
+
+	start = ktime_get();
+	exynos_atomic_bts_post_update(dev, old_state, crtc_mask);
+	dpu_commit_stage_done(decon, DPU_COMMIT_BTS_POST_UPDATE, start);
+
+	if (decon->fb_handover.rmem) {
+		const struct exynos_drm_crtc_state *exynos_crtc_state =
+			to_exynos_crtc_state(new_crtc_state);
+
+		if (!exynos_crtc_state->skip_update)
+			exynos_rmem_free(decon);
+	}
+
+	exynos_atomic_commit_hw_done_crtc(old_crtc_state, new_crtc_state);
+
+	DPU_ATRACE_END("exynos_atomic_commit_tail_crtc");
+}
+
 static struct drm_mode_config_helper_funcs exynos_drm_mode_config_helpers = {
 	.atomic_commit_tail = exynos_atomic_commit_tail,
 };
@@ -717,6 +895,8 @@ static const struct drm_mode_config_funcs exynos_drm_mode_config_funcs = {
 	.get_format_info = exynos_get_format_info,
 	.atomic_check = exynos_atomic_check,
 	.atomic_commit = exynos_atomic_commit,
+	.atomic_state_alloc = exynos_atomic_state_alloc,
+	.atomic_state_free = exynos_atomic_state_free,
 };
 
 void exynos_drm_mode_config_init(struct drm_device *dev)
@@ -10,6 +10,7 @@
  * published by the Free Software Foundation.
  */
 
+#include <linux/hash.h>
 #include <drm/drm_print.h>
 #include <uapi/drm/drm_fourcc.h>
 
@@ -249,16 +250,51 @@ static const struct dpu_fmt dpu_formats_list[] = {
         },
 };
 
-const struct dpu_fmt *dpu_find_fmt_info(u32 fmt)
+/*
+ * Open addressed hash of dpu_formats_list keyed by fourcc, filled once by
+ * dpu_init_fmt_info(). Each slot holds the list index + 1, 0 for an empty
+ * slot. At this size no supported fourcc is more than one slot away from its
+ * hash.
+ */
+#define DPU_FMT_HASH_BITS	7
+#define DPU_FMT_HASH_SIZE	(1 << DPU_FMT_HASH_BITS)
+#define DPU_FMT_HASH_MASK	(DPU_FMT_HASH_SIZE - 1)
+
+static u8 dpu_fmt_hash[DPU_FMT_HASH_SIZE];
+
+void dpu_init_fmt_info(void)
 {
+	u32 slot;
 	int i;
 
-	for (i = 0; i < ARRAY_SIZE(dpu_formats_list); i++)
-		if (dpu_formats_list[i].fmt == fmt)
-			return &dpu_formats_list[i];
+	BUILD_BUG_ON(ARRAY_SIZE(dpu_formats_list) >= DPU_FMT_HASH_SIZE / 2);
+
+	for (i = 0; i < ARRAY_SIZE(dpu_formats_list); i++) {
+		slot = hash_32(dpu_formats_list[i].fmt, DPU_FMT_HASH_BITS);
+		while (dpu_fmt_hash[slot])
+			slot = (slot + 1) & DPU_FMT_HASH_MASK;
+		dpu_fmt_hash[slot] = i + 1;
+	}
+}
+
+const struct dpu_fmt *dpu_find_fmt_info(u32 fmt)
+{
+	u32 slot = hash_32(fmt, DPU_FMT_HASH_BITS);
+	const struct dpu_fmt *fmt_info;
+
+	while (dpu_fmt_hash[slot]) {
+		fmt_info = &dpu_formats_list[dpu_fmt_hash[slot] - 1];
+		if (fmt_info->fmt == fmt)
+			return fmt_info;
+		slot = (slot + 1) & DPU_FMT_HASH_MASK;
+	}
 
-	DRM_INFO("%s: can't find format(%d) in supported format list\n",
+	DRM_DEBUG("%s: can't find format(%d) in supported format list\n",
 			__func__, fmt);
 
 	return NULL;
 }
+
+#if IS_ENABLED(CONFIG_DRM_SAMSUNG_KUNIT_TEST)
+#include "tests/exynos_drm_format_test.c"
+#endif
@@ -76,6 +76,7 @@ struct dpu_fmt {
 #define PL_STRIDE_SIZE_SBWC(w, bpc)	((bpc) ? SBWC_10B_STRIDE(w) :	\
 						SBWC_8B_STRIDE(w))
 
+void dpu_init_fmt_info(void);
 const struct dpu_fmt *dpu_find_fmt_info(u32 fmt);
 
 static inline const char *dpu_get_fmt_name(const struct dpu_fmt *fmt)
@@ -326,6 +326,10 @@ static int exynos_plane_atomic_check(struct drm_plane *plane,
 	if (!state->crtc || !state->fb)
 		return 0;
 
+	exynos_state->fmt_info = dpu_find_fmt_info(state->fb->format->format);
+	if (!exynos_state->fmt_info)
+		return -EINVAL;
+
 	decon = to_exynos_crtc(state->crtc)->ctx;
 	new_crtc_state = drm_atomic_get_new_crtc_state(state->state,
 							state->crtc);
@@ -13,9 +13,11 @@
 #ifndef __EXYNOS_DRM_PLANE_H__
 #define __EXYNOS_DRM_PLANE_H__
 
+#ifdef __KERNEL__
 #include <drm/drm_device.h>
 
 #include "exynos_drm_drv.h"
+#endif
 
 #define EXYNOS_PLANE_ALPHA_MAX          0xff
 
@@ -53,11 +55,13 @@ enum {
 	EXYNOS_RANGE_EXTENDED,
 };
 
+#ifdef __KERNEL__
 #define plane_to_dpp(p)		container_of(p, struct dpp_device, plane)
 
 int exynos_plane_init(struct drm_device *dev,
 		      struct exynos_drm_plane *exynos_plane, unsigned int index,
 		      const struct exynos_drm_plane_config *config);
 int exynos_drm_debugfs_plane_add(struct exynos_drm_plane *exynos_plane);
+#endif
 
 #endif /* __EXYNOS_DRM_PLANE_H__ */
@@ -1854,6 +1854,14 @@ const struct brightness_capability nt37290_brightness_capability = {
 	},
 };
 
+static const struct exynos_dsi_cmd_set * const nt37290_image_cmd_sets[] = {
+	&nt37290_init_cmd_set,
+	&nt37290_dsc_init_cmd_set,
+	&nt37290_lhbm_on_setting_cmd_set,
+	&nt37290_dsc_fhd_cmd_set,
+	&nt37290_dsc_wqhd_cmd_set,
+};
+
 const struct exynos_panel_desc boe_nt37290 = {
 	.panel_id_reg = 0xAC,
 	.data_lane_cnt = 4,
@@ -1876,6 +1884,8 @@ const struct exynos_panel_desc boe_nt37290 = {
 	.lp_cmd_set = &nt37290_lp_cmd_set,
 	.binned_lp = nt37290_binned_lp,
 	.num_binned_lp = ARRAY_SIZE(nt37290_binned_lp),
+	.image_cmd_sets = nt37290_image_cmd_sets,
+	.num_image_cmd_sets = ARRAY_SIZE(nt37290_image_cmd_sets),
 	.is_panel_idle_supported = true,
 	/*
 	 * After waiting for TE, wait for extra time to make sure the frame start
@@ -371,6 +371,236 @@ void exynos_panel_get_panel_rev(struct exynos_panel *ctx, u8 rev)
 }
 EXPORT_SYMBOL(exynos_panel_get_panel_rev);
 
+/* same limits dsim uses to cut a batch of commands */
+#define CMD_IMAGE_MAX_PH	(MAX_PH_FIFO - 1)
+#define CMD_IMAGE_MAX_PL	mult_frac(MAX_PL_FIFO, 75, 100)
+
+static const struct exynos_dsi_cmd *
+exynos_panel_get_last_cmd(const struct exynos_panel *ctx, const struct exynos_dsi_cmd_set *cmd_set)
+{
+	const struct exynos_dsi_cmd *c = &cmd_set->cmds[cmd_set->num_cmd - 1];
+
+	if (!c->panel_rev)
+		return c;
+
+	for (; c >= cmd_set->cmds; c--) {
+		if (c->panel_rev & ctx->panel_rev)
+			return c;
+	}
+
+	return NULL;
+}
+
+struct cmd_image_builder {
+	/* image and words are NULL while sizing the image */
+	struct exynos_dsi_cmd_set_image *image;
+	u32 *words;
+	u32 num_segs;
+	u32 num_words;
+	struct exynos_dsi_cmd_image seg;
+	u32 seg_start;
+	bool seg_open;
+};
+
+static void cmd_image_close_seg(struct cmd_image_builder *b, u32 delay_ms)
+{
+	if (!b->seg_open)
+		return;
+
+	if (b->image) {
+		b->image->segs[b->num_segs] = b->seg;
+		b->image->delays_ms[b->num_segs] = delay_ms;
+	}
+	b->num_segs++;
+	b->seg_open = false;
+}
+
+static void cmd_image_add_packet(struct cmd_image_builder *b,
+				 const struct mipi_dsi_packet *packet)
+{
+	const u32 pl_len = ALIGN(packet->payload_length, 4);
+	const u8 *p = packet->payload;
+	size_t i;
+
+	if (b->seg_open && (b->seg.num_pkts == CMD_IMAGE_MAX_PH ||
+			    b->seg.pl_len + pl_len > CMD_IMAGE_MAX_PL))
+		cmd_image_close_seg(b, 0);
+
+	if (!b->seg_open) {
+		memset(&b->seg, 0, sizeof(b->seg));
+		if (b->words)
+			b->seg.words = b->words + b->num_words;
+		b->seg_start = b->num_words;
+		b->seg_open = true;
+	}
+
+	if (b->words)
+		b->words[b->num_words] = packet->header[0] | packet->header[1] << 8 |
+					 packet->header[2] << 16;
+	b->num_words++;
+
+	for (i = 0; i < packet->payload_length; i += 4) {
+		if (b->words) {
+			u32 word = 0;
+			size_t j;
+
+			for (j = 0; j < 4 && i + j < packet->payload_length; j++)
+				word |= p[i + j] << (j * 8);
+			b->words[b->num_words] = word;
+		}
+		b->num_words++;
+	}
+
+	b->seg.num_pkts++;
+	b->seg.pl_len += pl_len;
+	b->seg.num_words = b->num_words - b->seg_start;
+}
+
+/*
+ * Lays out the commands of @cmd_set sent for the panel revision as they are
+ * pushed to the cmd fifos, or only sizes the image if @b has no buffers.
+ */
+static int exynos_panel_build_cmd_set_image(const struct exynos_panel *ctx,
+					    const struct exynos_dsi_cmd_set *cmd_set,
+					    struct cmd_image_builder *b)
+{
+	const struct mipi_dsi_device *dsi = to_mipi_dsi_device(ctx->dev);
+	const struct exynos_dsi_cmd *c, *last_cmd;
+
+	if (!cmd_set->num_cmd)
+		return -ENODATA;
+
+	last_cmd = exynos_panel_get_last_cmd(ctx, cmd_set);
+	if (!last_cmd)
+		return -ENODATA;
+
+	for (c = cmd_set->cmds; c <= last_cmd; c++) {
+		struct mipi_dsi_packet packet;
+		struct mipi_dsi_msg msg = {
+			.channel = dsi->channel,
+			.tx_buf = c->cmd,
+			.tx_len = c->cmd_len,
+		};
+
+		if (ctx->panel_rev && !(c->panel_rev & ctx->panel_rev))
+			continue;
+
+		/* same packet types as exynos_dsi_dcs_write_buffer() */
+		if (c->cmd_len == 1)
+			msg.type = MIPI_DSI_DCS_SHORT_WRITE;
+		else if (c->cmd_len == 2)
+			msg.type = MIPI_DSI_DCS_SHORT_WRITE_PARAM;
+		else
+			msg.type = MIPI_DSI_DCS_LONG_WRITE;
+
+		if (!c->cmd_len || ALIGN(c->cmd_len, 4) > CMD_IMAGE_MAX_PL ||
+		    mipi_dsi_create_packet(&packet, &msg))
+			return -EINVAL;
+
+		cmd_image_add_packet(b, &packet);
+		if (c->delay_ms)
+			cmd_image_close_seg(b, c->delay_ms);
+	}
+	cmd_image_close_seg(b, 0);
+
+	return 0;
+}
+
+static int exynos_panel_compile_cmd_set(struct exynos_panel *ctx,
+					const struct exynos_dsi_cmd_set *cmd_set,
+					struct exynos_dsi_cmd_set_image *image)
+{
+	struct cmd_image_builder b = { 0 };
+	int ret;
+
+	ret = exynos_panel_build_cmd_set_image(ctx, cmd_set, &b);
+	if (ret)
+		return ret;
+
+	image->cmd_set = cmd_set;
+	image->segs = devm_kcalloc(ctx->dev, b.num_segs, sizeof(*image->segs), GFP_KERNEL);
+	image->delays_ms = devm_kcalloc(ctx->dev, b.num_segs, sizeof(*image->delays_ms),
+					GFP_KERNEL);
+	b.words = devm_kcalloc(ctx->dev, b.num_words, sizeof(*b.words), GFP_KERNEL);
+	if (!image->segs || !image->delays_ms || !b.words)
+		return -ENOMEM;
+
+	b.image = image;
+	b.num_segs = 0;
+	b.num_words = 0;
+	ret = exynos_panel_build_cmd_set_image(ctx, cmd_set, &b);
+	if (ret)
+		return ret;
+
+	image->num_segs = b.num_segs;
+
+	return 0;
+}
+
+/*
+ * Compiles the constant command sets of the panel into cmd fifo images for the
+ * current panel revision. Command sets that can't be compiled, e.g. with a
+ * command too long for a single batch, keep being sent command by command.
+ */
+static void exynos_panel_compile_cmd_sets(struct exynos_panel *ctx)
+{
+	const struct exynos_panel_desc *desc = ctx->desc;
+	const struct exynos_dsi_cmd_set_images *old_images = READ_ONCE(ctx->cmd_set_images);
+	struct exynos_dsi_cmd_set_images *images;
+	const size_t max_images = 2 + desc->num_binned_lp + desc->num_image_cmd_sets;
+	const struct exynos_dsi_cmd_set *cmd_set;
+	size_t i;
+
+	if (old_images && old_images->panel_rev == ctx->panel_rev)
+		return;
+
+	images = devm_kzalloc(ctx->dev, struct_size(images, images, max_images), GFP_KERNEL);
+	if (!images)
+		return;
+
+	images->panel_rev = ctx->panel_rev;
+	for (i = 0; i < max_images; i++) {
+		if (i == 0)
+			cmd_set = desc->off_cmd_set;
+		else if (i == 1)
+			cmd_set = desc->lp_cmd_set;
+		else if (i < 2 + desc->num_binned_lp)
+			cmd_set = &desc->binned_lp[i - 2].cmd_set;
+		else
+			cmd_set = desc->image_cmd_sets[i - 2 - desc->num_binned_lp];
+
+		if (!cmd_set ||
+		    exynos_panel_compile_cmd_set(ctx, cmd_set, &images->images[images->num_images]))
+			continue;
+
+		images->num_images++;
+	}
+
+	dev_dbg(ctx->dev, "compiled %u command sets for panel_rev 0x%x\n",
+		images->num_images, images->panel_rev);
+
+	/* readers look the images up without locking */
+	smp_store_release(&ctx->cmd_set_images, images);
+}
+
+static const struct exynos_dsi_cmd_set_image *
+exynos_panel_get_cmd_set_image(const struct exynos_panel *ctx,
+			       const struct exynos_dsi_cmd_set *cmd_set)
+{
+	const struct exynos_dsi_cmd_set_images *images = smp_load_acquire(&ctx->cmd_set_images);
+	u32 i;
+
+	if (!images || images->panel_rev != ctx->panel_rev)
+		return NULL;
+
+	for (i = 0; i < images->num_images; i++) {
+		if (images->images[i].cmd_set == cmd_set)
+			return &images->images[i];
+	}
+
+	return NULL;
+}
+
 int exynos_panel_init(struct exynos_panel *ctx)
 {
 	const struct exynos_panel_funcs *funcs = ctx->desc->exynos_panel_func;
@@ -399,6 +629,8 @@ int exynos_panel_init(struct exynos_panel *ctx)
 		ctx->panel_rev = PANEL_REV_LATEST;
 	}
 
+	exynos_panel_compile_cmd_sets(ctx);
+
 	if (funcs && funcs->read_id)
 		ret = funcs->read_id(ctx);
 	else
@@ -726,14 +958,79 @@ int exynos_panel_prepare(struct drm_panel *panel)
 }
 EXPORT_SYMBOL(exynos_panel_prepare);
 
+/*
+ * Queues the commands of @cmd_set on the dsi host and returns without waiting
+ * for them, command delays are handled by the host. @complete is called once
+ * the commands are sent, unless an error is returned here.
+ */
+int exynos_panel_send_cmd_set_async(struct exynos_panel *ctx,
+				    const struct exynos_dsi_cmd_set *cmd_set, u32 flags,
+				    void (*complete)(void *data, int ret), void *data)
+{
+	struct mipi_dsi_device *dsi = to_mipi_dsi_device(ctx->dev);
+	struct exynos_dsi_async_req req = {
+		.complete = complete,
+		.data = data,
+	};
+	struct exynos_dsi_async_cmd *cmds;
+	const struct exynos_dsi_cmd *c, *last_cmd;
+	u16 dsi_flags = MIPI_DSI_MSG_LASTCOMMAND;
+	ssize_t ret;
+
+	if (!cmd_set || !cmd_set->num_cmd)
+		return -ENODATA;
+
+	last_cmd = exynos_panel_get_last_cmd(ctx, cmd_set);
+	if (!last_cmd)
+		return -ENODATA;
+
+	if (flags & PANEL_CMD_SET_IGNORE_VBLANK)
+		dsi_flags |= EXYNOS_DSI_MSG_IGNORE_VBLANK;
+	if (dsi->mode_flags & MIPI_DSI_MODE_LPM)
+		dsi_flags |= MIPI_DSI_MSG_USE_LPM;
+
+	cmds = kcalloc(cmd_set->num_cmd, sizeof(*cmds), GFP_KERNEL);
+	if (!cmds)
+		return -ENOMEM;
+
+	for (c = cmd_set->cmds; c <= last_cmd; c++) {
+		struct exynos_dsi_async_cmd *cmd = &cmds[req.num_cmds];
+
+		if (ctx->panel_rev && !(c->panel_rev & ctx->panel_rev))
+			continue;
+
+		/* same packet types as exynos_dsi_dcs_write_buffer() */
+		if (c->cmd_len == 1)
+			cmd->type = MIPI_DSI_DCS_SHORT_WRITE;
+		else if (c->cmd_len == 2)
+			cmd->type = MIPI_DSI_DCS_SHORT_WRITE_PARAM;
+		else
+			cmd->type = MIPI_DSI_DCS_LONG_WRITE;
+		cmd->flags = dsi_flags;
+		cmd->tx_buf = c->cmd;
+		cmd->tx_len = c->cmd_len;
+		cmd->delay_us = c->delay_ms * 1000;
+		req.num_cmds++;
+	}
+	req.cmds = cmds;
+
+	ret = exynos_dsi_async_write(dsi, &req);
+	kfree(cmds);
+
+	return ret;
+}
+EXPORT_SYMBOL(exynos_panel_send_cmd_set_async);
+
 void exynos_panel_send_cmd_set_flags(struct exynos_panel *ctx,
 				     const struct exynos_dsi_cmd_set *cmd_set, u32 flags)
 {
 	struct mipi_dsi_device *dsi = to_mipi_dsi_device(ctx->dev);
 	const struct exynos_dsi_cmd *c;
-	const struct exynos_dsi_cmd *last_cmd = NULL;
+	const struct exynos_dsi_cmd *last_cmd;
+	const struct exynos_dsi_cmd_set_image *image;
 	const u32 async_mask = PANEL_CMD_SET_BATCH | PANEL_CMD_SET_QUEUE;
 	u16 dsi_flags = 0;
+	u32 i;
 
 	if (!cmd_set || !cmd_set->num_cmd)
 		return;
@@ -741,6 +1038,11 @@ void exynos_panel_send_cmd_set_flags(struct exynos_panel *ctx,
 	/* shouldn't have both queue and batch set together */
 	WARN_ON((flags & async_mask) == async_mask);
 
+	/* falls back to a blocking send if the host can't take it */
+	if ((flags & PANEL_CMD_SET_ASYNC) && !WARN_ON(flags & async_mask) &&
+	    !exynos_panel_send_cmd_set_async(ctx, cmd_set, flags, NULL, NULL))
+		return;
+
 	if (flags & PANEL_CMD_SET_IGNORE_VBLANK)
 		dsi_flags |= EXYNOS_DSI_MSG_IGNORE_VBLANK;
 
@@ -748,18 +1050,27 @@ void exynos_panel_send_cmd_set_flags(struct exynos_panel *ctx,
 	if (!(flags & async_mask))
 		dsi_flags |= MIPI_DSI_MSG_LASTCOMMAND;
 
-	c = &cmd_set->cmds[cmd_set->num_cmd - 1];
-	if (!c->panel_rev) {
-		last_cmd = c;
-	} else {
-		for (; c >= cmd_set->cmds; c--) {
-			if (c->panel_rev & ctx->panel_rev) {
-				last_cmd = c;
-				break;
-			}
+	image = exynos_panel_get_cmd_set_image(ctx, cmd_set);
+	if (image) {
+		/* commands not batched or queued go out right away, as when sent one by one */
+		if (!(flags & async_mask))
+			dsi_flags |= EXYNOS_DSI_MSG_IGNORE_VBLANK;
+
+		for (i = 0; i < image->num_segs; i++) {
+			const u32 delay_ms = image->delays_ms[i];
+
+			if ((i == image->num_segs - 1) && !(flags & PANEL_CMD_SET_QUEUE))
+				dsi_flags |= MIPI_DSI_MSG_LASTCOMMAND;
+
+			exynos_dsi_cmd_image_write(dsi, &image->segs[i], dsi_flags);
+			if (delay_ms)
+				usleep_range(delay_ms * 1000, delay_ms * 1000 + 10);
 		}
+		return;
 	}
 
+	last_cmd = exynos_panel_get_last_cmd(ctx, cmd_set);
+
 	/* no commands to transfer */
 	if (!last_cmd)
 		return;
@@ -2159,6 +2470,38 @@ ssize_t exynos_dsi_dcs_write_buffer(struct mipi_dsi_device *dsi,
 }
 EXPORT_SYMBOL(exynos_dsi_dcs_write_buffer);
 
+ssize_t exynos_dsi_cmd_image_write(struct mipi_dsi_device *dsi,
+				   const struct exynos_dsi_cmd_image *img, u16 flags)
+{
+	return exynos_dsi_dcs_transfer(dsi, 0, img, sizeof(*img),
+				       flags | EXYNOS_DSI_MSG_CMD_IMAGE);
+}
+EXPORT_SYMBOL(exynos_dsi_cmd_image_write);
+
+ssize_t exynos_dsi_async_write(struct mipi_dsi_device *dsi,
+			       const struct exynos_dsi_async_req *req)
+{
+	return exynos_dsi_dcs_transfer(dsi, 0, req, sizeof(*req), EXYNOS_DSI_MSG_ASYNC);
+}
+EXPORT_SYMBOL(exynos_dsi_async_write);
+
+/*
+ * Sends the dcs reads in @reads as one transfer, each entry gets its own
+ * result. Returns the number of successful reads or the first error.
+ */
+ssize_t exynos_dsi_dcs_read_batch(struct mipi_dsi_device *dsi,
+				  struct exynos_dsi_read *reads, u32 num_reads)
+{
+	const struct exynos_dsi_read_batch batch = {
+		.num_reads = num_reads,
+		.reads = reads,
+	};
+
+	return exynos_dsi_dcs_transfer(dsi, MIPI_DSI_DCS_READ, &batch, sizeof(batch),
+				       EXYNOS_DSI_MSG_READ_BATCH);
+}
+EXPORT_SYMBOL(exynos_dsi_dcs_read_batch);
+
 static int exynos_dsi_name_show(struct seq_file *m, void *data)
 {
 	struct mipi_dsi_device *dsi = m->private;
@@ -75,6 +75,12 @@
 /* packetgo feature to batch msgs can wait for vblank, use this flag to ignore explicitly */
 #define PANEL_CMD_SET_IGNORE_VBLANK BIT(2)
 
+/*
+ * indicates that the cmd set doesn't need to be sent by the time the call
+ * returns, it's queued on the dsi host and sent in order with later commands
+ */
+#define PANEL_CMD_SET_ASYNC  BIT(3)
+
 
 #define HBM_FLAG_GHBM_UPDATE    BIT(0)
 #define HBM_FLAG_BL_UPDATE      BIT(1)
@@ -458,6 +464,33 @@ struct exynos_dsi_cmd_set {
 	const struct exynos_dsi_cmd *cmds;
 };
 
+/**
+ * struct exynos_dsi_cmd_set_image - a command set compiled into cmd fifo images.
+ * @cmd_set:   The constant command set compiled.
+ * @num_segs:  Number of segments, a segment ends at a command with a delay or
+ *             once the cmd fifos would be full.
+ * @segs:      Fifo image of each segment.
+ * @delays_ms: Delay time after sending each segment.
+ */
+struct exynos_dsi_cmd_set_image {
+	const struct exynos_dsi_cmd_set *cmd_set;
+	u32 num_segs;
+	struct exynos_dsi_cmd_image *segs;
+	u32 *delays_ms;
+};
+
+/**
+ * struct exynos_dsi_cmd_set_images - command set images for a panel revision.
+ * @panel_rev:  Panel revision the command sets were filtered with.
+ * @num_images: Number of entries in @images.
+ * @images:     Compiled command sets.
+ */
+struct exynos_dsi_cmd_set_images {
+	u32 panel_rev;
+	u32 num_images;
+	struct exynos_dsi_cmd_set_image images[];
+};
+
 /**
  * struct exynos_binned_lp - information for binned lp mode.
  * @name:         Name of this binned lp mode.
@@ -505,6 +538,12 @@ struct exynos_panel_desc {
 	const struct exynos_dsi_cmd_set *lp_cmd_set;
 	const struct exynos_binned_lp *binned_lp;
 	const size_t num_binned_lp;
+	/*
+	 * @image_cmd_sets: constant command sets, on top of off, lp and binned lp,
+	 * compiled into cmd fifo images once the panel revision is known
+	 */
+	const struct exynos_dsi_cmd_set * const *image_cmd_sets;
+	const size_t num_image_cmd_sets;
 	const struct drm_panel_funcs *panel_func;
 	const struct exynos_panel_funcs *exynos_panel_func;
 };
@@ -613,6 +652,8 @@ struct exynos_panel {
 	char panel_id[PANEL_ID_MAX];
 	char panel_extinfo[PANEL_EXTINFO_MAX];
 	u32 panel_rev;
+	/* replaced, never freed until unbind, if the panel revision changes */
+	const struct exynos_dsi_cmd_set_images *cmd_set_images;
 	enum drm_panel_orientation orientation;
 
 	struct device_node *touch_dev;
@@ -931,6 +972,9 @@ void exynos_panel_debugfs_create_cmdset(struct exynos_panel *ctx,
 					const char *name);
 void exynos_panel_send_cmd_set_flags(struct exynos_panel *ctx, const struct exynos_dsi_cmd_set *cmd_set,
 			       u32 flags);
+int exynos_panel_send_cmd_set_async(struct exynos_panel *ctx,
+				    const struct exynos_dsi_cmd_set *cmd_set, u32 flags,
+				    void (*complete)(void *data, int ret), void *data);
 static inline void exynos_panel_send_cmd_set(struct exynos_panel *ctx,
 					     const struct exynos_dsi_cmd_set *cmd_set)
 {
@@ -943,6 +987,12 @@ int exynos_panel_common_init(struct mipi_dsi_device *dsi,
 ssize_t exynos_dsi_dcs_write_buffer(struct mipi_dsi_device *dsi,
 				const void *data, size_t len, u16 flags);
 ssize_t exynos_dsi_cmd_send_flags(struct mipi_dsi_device *dsi, u16 flags);
+ssize_t exynos_dsi_cmd_image_write(struct mipi_dsi_device *dsi,
+				   const struct exynos_dsi_cmd_image *img, u16 flags);
+ssize_t exynos_dsi_async_write(struct mipi_dsi_device *dsi,
+			       const struct exynos_dsi_async_req *req);
+ssize_t exynos_dsi_dcs_read_batch(struct mipi_dsi_device *dsi,
+				  struct exynos_dsi_read *reads, u32 num_reads);
 
 int exynos_panel_probe(struct mipi_dsi_device *dsi);
 int exynos_panel_remove(struct mipi_dsi_device *dsi);
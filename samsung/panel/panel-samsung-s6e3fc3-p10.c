@@ -483,16 +483,20 @@ static int s6e3fc3_p10_set_op_hz(struct exynos_panel *ctx, unsigned int hz)
 	}
 
 	ctx->op_hz = hz;
+	/*
+	 * Queue the switch on the dsi host rather than waiting for ~25 writes,
+	 * later commands are still sent after it.
+	 */
 	if (ctx->op_hz == 60) {
-		exynos_panel_send_cmd_set(ctx,
-			&s6e3fc3_p10_mode_ns_60_cmd_set);
+		exynos_panel_send_cmd_set_flags(ctx,
+			&s6e3fc3_p10_mode_ns_60_cmd_set, PANEL_CMD_SET_ASYNC);
 	} else {
 		if (vrefresh == 60) {
-			exynos_panel_send_cmd_set(ctx,
-				&s6e3fc3_p10_mode_hs_60_cmd_set);
+			exynos_panel_send_cmd_set_flags(ctx,
+				&s6e3fc3_p10_mode_hs_60_cmd_set, PANEL_CMD_SET_ASYNC);
 		} else {
-			exynos_panel_send_cmd_set(ctx,
-				&s6e3fc3_p10_mode_hs_90_cmd_set);
+			exynos_panel_send_cmd_set_flags(ctx,
+				&s6e3fc3_p10_mode_hs_90_cmd_set, PANEL_CMD_SET_ASYNC);
 		}
 	}
 	dev_info(ctx->dev, "set op_hz at %u\n", hz);
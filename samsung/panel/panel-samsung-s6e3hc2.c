@@ -306,6 +306,7 @@ static int s6e3hc2_gamma_read_otp(struct exynos_panel *ctx,
 				  struct s6e3hc2_panel_data *priv_data)
 {
 	struct mipi_dsi_device *dsi = to_mipi_dsi_device(ctx->dev);
+	struct exynos_dsi_read reads[S6E3HC2_NUM_GAMMA_TABLES];
 	ssize_t rc;
 	int i;
 
@@ -316,11 +317,24 @@ static int s6e3hc2_gamma_read_otp(struct exynos_panel *ctx,
 
 		/* store cmd on first byte to send payload as is */
 		*buf = info->cmd;
-		buf++;
 
-		rc = mipi_dsi_dcs_read(dsi, info->cmd, buf, info->len);
-		if (rc != info->len)
-			dev_warn(ctx->dev, "Only got %zd / %d bytes\n", rc, info->len);
+		reads[i] = (struct exynos_dsi_read) {
+			.type = MIPI_DSI_DCS_READ,
+			.tx_buf = &info->cmd,
+			.tx_len = 1,
+			.rx_buf = buf + 1,
+			.rx_len = info->len,
+		};
+	}
+
+	rc = exynos_dsi_dcs_read_batch(dsi, reads, S6E3HC2_NUM_GAMMA_TABLES);
+	if (rc < 0)
+		dev_warn(ctx->dev, "gamma otp read failed (%zd)\n", rc);
+
+	for (i = 0; i < S6E3HC2_NUM_GAMMA_TABLES; i++) {
+		if (reads[i].ret != s6e3hc2_gamma_tables[i].len)
+			dev_warn(ctx->dev, "Only got %zd / %d bytes\n", reads[i].ret,
+				 s6e3hc2_gamma_tables[i].len);
 	}
 
 	return 0;
@@ -588,6 +602,7 @@ static int s6e3hc2_gamma_read_tables(struct exynos_panel *ctx)
 {
 	struct s6e3hc2_panel *spanel = to_spanel(ctx);
 	const struct drm_display_mode *mode;
+	ktime_t start = ktime_get();
 	int i, rc = 0;
 
 	if (spanel->native_gamma_ready)
@@ -619,6 +634,8 @@ static int s6e3hc2_gamma_read_tables(struct exynos_panel *ctx)
 	}
 
 	spanel->native_gamma_ready = true;
+	dev_info(ctx->dev, "gamma tables read in %lldus\n",
+		 ktime_us_delta(ktime_get(), start));
 abort:
 	EXYNOS_DCS_WRITE_TABLE(ctx, lock_cmd_f0);
 
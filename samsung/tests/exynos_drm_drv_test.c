@@ -0,0 +1,400 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * KUnit tests for exynos_drm_drv.c, built into the driver when
+ * CONFIG_DRM_SAMSUNG_KUNIT_TEST is enabled.
+ *
+ * Copyright (C) 2026 Google LLC
+ */
+
+#include <kunit/test.h>
+#include <linux/completion.h>
+#include <linux/kthread.h>
+#include <linux/random.h>
+
+#define WIN_STRESS_ITERATIONS	100000
+#define ALL_WIN_MASK		(BIT(MAX_WIN_PER_DECON) - 1)
+#define SPLIT_TEST_PLANES	2
+
+/*
+ * Just enough of an atomic state for the state iterators: crtcs and planes only have their
+ * index, and planes are attached to crtcs through their plane states.
+ */
+struct split_state_test {
+	struct drm_device dev;
+	struct exynos_drm_atomic_state exynos_state;
+	struct drm_crtc crtcs[MAX_CRTC];
+	struct drm_crtc_state crtc_states[MAX_CRTC];
+	struct __drm_crtcs_state crtcs_state[MAX_CRTC];
+	struct drm_plane planes[SPLIT_TEST_PLANES];
+	struct drm_plane_state old_plane_states[SPLIT_TEST_PLANES];
+	struct drm_plane_state new_plane_states[SPLIT_TEST_PLANES];
+	struct __drm_planes_state planes_state[SPLIT_TEST_PLANES];
+};
+
+static struct split_state_test *split_state_test_alloc(struct kunit *test)
+{
+	struct split_state_test *t = kunit_kzalloc(test, sizeof(*t), GFP_KERNEL);
+	struct drm_atomic_state *state;
+	int i;
+
+	KUNIT_ASSERT_NOT_ERR_OR_NULL(test, t);
+
+	state = &t->exynos_state.base;
+	state->dev = &t->dev;
+	state->crtcs = t->crtcs_state;
+	state->planes = t->planes_state;
+	t->dev.mode_config.num_crtc = MAX_CRTC;
+	t->dev.mode_config.num_total_plane = SPLIT_TEST_PLANES;
+
+	for (i = 0; i < MAX_CRTC; i++) {
+		t->crtcs[i].index = i;
+		t->crtc_states[i].crtc = &t->crtcs[i];
+	}
+
+	for (i = 0; i < SPLIT_TEST_PLANES; i++)
+		t->planes[i].index = i;
+
+	return t;
+}
+
+static void split_state_add_crtc(struct split_state_test *t, int index)
+{
+	struct __drm_crtcs_state *crtc_state = &t->crtcs_state[index];
+
+	crtc_state->ptr = &t->crtcs[index];
+	crtc_state->old_state = &t->crtc_states[index];
+	crtc_state->new_state = &t->crtc_states[index];
+}
+
+static void split_state_add_plane(struct split_state_test *t, int index, int old_crtc,
+				  int new_crtc)
+{
+	struct __drm_planes_state *plane_state = &t->planes_state[index];
+
+	t->old_plane_states[index].crtc = old_crtc < 0 ? NULL : &t->crtcs[old_crtc];
+	t->new_plane_states[index].crtc = new_crtc < 0 ? NULL : &t->crtcs[new_crtc];
+
+	plane_state->ptr = &t->planes[index];
+	plane_state->old_state = &t->old_plane_states[index];
+	plane_state->new_state = &t->new_plane_states[index];
+}
+
+static void exynos_split_crtc_mask_test(struct kunit *test)
+{
+	struct split_state_test *t = split_state_test_alloc(test);
+	struct drm_atomic_state *state = &t->exynos_state.base;
+
+	/* single crtc commits are never split */
+	split_state_add_crtc(t, 0);
+	split_state_add_plane(t, 0, 0, 0);
+	KUNIT_EXPECT_EQ(test, exynos_atomic_get_split_crtc_mask(state), 0u);
+
+	/* page flips on two crtcs go to their own workers */
+	split_state_add_crtc(t, 2);
+	split_state_add_plane(t, 1, 2, 2);
+	KUNIT_EXPECT_EQ(test, exynos_atomic_get_split_crtc_mask(state), (u32)(BIT(0) | BIT(2)));
+
+	/* planes being enabled or disabled don't prevent the split */
+	split_state_add_plane(t, 1, -1, 2);
+	KUNIT_EXPECT_EQ(test, exynos_atomic_get_split_crtc_mask(state), (u32)(BIT(0) | BIT(2)));
+	split_state_add_plane(t, 1, 2, -1);
+	KUNIT_EXPECT_EQ(test, exynos_atomic_get_split_crtc_mask(state), (u32)(BIT(0) | BIT(2)));
+
+	/* a plane moving between crtcs ties them together */
+	split_state_add_plane(t, 1, 2, 0);
+	KUNIT_EXPECT_EQ(test, exynos_atomic_get_split_crtc_mask(state), 0u);
+	split_state_add_plane(t, 1, 2, 2);
+
+	/* so does a modeset on any of them */
+	t->crtc_states[2].active_changed = true;
+	KUNIT_EXPECT_EQ(test, exynos_atomic_get_split_crtc_mask(state), 0u);
+	t->crtc_states[2].active_changed = false;
+
+	state->fake_commit = true;
+	KUNIT_EXPECT_EQ(test, exynos_atomic_get_split_crtc_mask(state), 0u);
+}
+
+/*
+ * The work of the first crtc doesn't finish until the work of the last crtc has run, which
+ * only happens if per crtc works don't serialize on a single worker.
+ */
+struct split_commit_test {
+	struct exynos_drm_atomic_state exynos_state;
+	struct completion last_crtc_done;
+	atomic_t cleanup_cnt;
+	atomic_t run_mask;
+	bool first_crtc_timeout;
+};
+
+static void split_commit_test_work(struct kthread_work *work)
+{
+	struct exynos_drm_crtc_commit *crtc_commit =
+		container_of(work, struct exynos_drm_crtc_commit, work);
+	struct split_commit_test *t =
+		container_of(crtc_commit->state, struct split_commit_test, exynos_state);
+	const int index = crtc_commit - crtc_commit->state->crtc_commit;
+
+	atomic_or(BIT(index), &t->run_mask);
+
+	if (index == 0)
+		t->first_crtc_timeout = !wait_for_completion_timeout(&t->last_crtc_done, HZ);
+	else if (index == MAX_CRTC - 1)
+		complete(&t->last_crtc_done);
+
+	if (exynos_atomic_crtc_commit_done(crtc_commit))
+		atomic_inc(&t->cleanup_cnt);
+}
+
+static void exynos_split_commit_queue_test(struct kunit *test)
+{
+	struct split_commit_test *t = kunit_kzalloc(test, sizeof(*t), GFP_KERNEL);
+	struct kthread_worker *workers[MAX_CRTC];
+	const unsigned long crtc_mask = BIT(MAX_CRTC) - 1;
+	int i;
+
+	KUNIT_ASSERT_NOT_ERR_OR_NULL(test, t);
+	init_completion(&t->last_crtc_done);
+
+	for (i = 0; i < MAX_CRTC; i++) {
+		workers[i] = kthread_create_worker(0, "split_test%d", i);
+		KUNIT_ASSERT_NOT_ERR_OR_NULL(test, workers[i]);
+		t->exynos_state.crtc_commit[i].state = &t->exynos_state;
+	}
+
+	exynos_atomic_queue_crtc_commits(&t->exynos_state, crtc_mask, workers,
+					 split_commit_test_work);
+
+	for (i = 0; i < MAX_CRTC; i++) {
+		kthread_flush_worker(workers[i]);
+		kthread_destroy_worker(workers[i]);
+	}
+
+	KUNIT_EXPECT_EQ(test, (unsigned long)atomic_read(&t->run_mask), crtc_mask);
+	KUNIT_EXPECT_FALSE(test, t->first_crtc_timeout);
+	KUNIT_EXPECT_EQ(test, atomic_read(&t->cleanup_cnt), 1);
+	KUNIT_EXPECT_EQ(test, atomic_read(&t->exynos_state.pending_crtc_commits), 0);
+}
+
+static void exynos_select_windows_prefers_idle(struct kunit *test)
+{
+	const unsigned int pending_win_mask[MAX_CRTC] = { 0x3, 0, 0 };
+	unsigned int wait_crtc_mask = 0;
+
+	/* enough idle windows, pending ones are left alone */
+	KUNIT_EXPECT_EQ(test, exynos_select_windows(0x3f, pending_win_mask, 2, &wait_crtc_mask),
+			0xcu);
+	KUNIT_EXPECT_EQ(test, wait_crtc_mask, 0u);
+
+	/* all idle windows are taken before a single pending one */
+	KUNIT_EXPECT_EQ(test, exynos_select_windows(0x3f, pending_win_mask, 5, &wait_crtc_mask),
+			0x3du);
+	KUNIT_EXPECT_EQ(test, wait_crtc_mask, BIT(0));
+
+	/* not enough windows at all */
+	wait_crtc_mask = 0;
+	KUNIT_EXPECT_EQ(test, exynos_select_windows(0x7, pending_win_mask, 4, &wait_crtc_mask),
+			0u);
+	KUNIT_EXPECT_EQ(test, wait_crtc_mask, 0u);
+}
+
+static void exynos_select_windows_stress(struct kunit *test)
+{
+	struct rnd_state rnd;
+	int n;
+
+	prandom_seed_state(&rnd, 0x5eed);
+
+	for (n = 0; n < WIN_STRESS_ITERATIONS; n++) {
+		const unsigned int available = prandom_u32_state(&rnd) & ALL_WIN_MASK;
+		const size_t count = 1 + prandom_u32_state(&rnd) % MAX_WIN_PER_DECON;
+		unsigned int pending_win_mask[MAX_CRTC] = { 0 };
+		unsigned int pending = 0, free, win_mask, expected_wait = 0;
+		unsigned int wait_crtc_mask = 0;
+		int i;
+
+		/* windows released by each crtc are disjoint and back in the available mask */
+		for (i = 0; i < MAX_CRTC; i++) {
+			pending_win_mask[i] = prandom_u32_state(&rnd) & available & ~pending;
+			pending |= pending_win_mask[i];
+		}
+		free = available & ~pending;
+
+		win_mask = exynos_select_windows(available, pending_win_mask, count,
+						 &wait_crtc_mask);
+
+		if (hweight32(available) < count) {
+			KUNIT_ASSERT_EQ(test, win_mask, 0u);
+			KUNIT_ASSERT_EQ(test, wait_crtc_mask, 0u);
+			continue;
+		}
+
+		KUNIT_ASSERT_EQ(test, (size_t)hweight32(win_mask), count);
+		KUNIT_ASSERT_EQ(test, win_mask & ~available, 0u);
+
+		if (hweight32(free) >= count) {
+			KUNIT_ASSERT_EQ(test, win_mask & pending, 0u);
+			KUNIT_ASSERT_EQ(test, wait_crtc_mask, 0u);
+			continue;
+		}
+
+		KUNIT_ASSERT_EQ(test, win_mask & free, free);
+		for (i = 0; i < MAX_CRTC; i++)
+			if (pending_win_mask[i] & win_mask)
+				expected_wait |= BIT(i);
+		KUNIT_ASSERT_NE(test, expected_wait, 0u);
+		KUNIT_ASSERT_EQ(test, wait_crtc_mask, expected_wait);
+	}
+}
+
+/*
+ * Windows handed over between crtcs while the crtc releasing them still has commits before
+ * hw_done: crtc 0 queues two commits each freeing windows, and a commit on crtc 1 taking all
+ * of them is checked and set up in between. Its commit work must stay blocked until the last
+ * crtc 0 commit releasing them reaches hw_done.
+ */
+struct win_handoff_state {
+	struct exynos_drm_atomic_state exynos_state;
+	struct exynos_drm_crtc_state crtc_state;
+	struct __drm_crtcs_state crtcs_state[MAX_CRTC];
+};
+
+struct win_handoff_test {
+	struct exynos_drm_private private;
+	struct drm_crtc crtcs[MAX_CRTC];
+	struct win_handoff_state a1, a2, b;
+	struct kthread_work b_work;
+	struct completion b_done;
+	unsigned int b_pending_win_mask;
+};
+
+static void win_handoff_state_init(struct win_handoff_test *t, struct win_handoff_state *s,
+				   int index, unsigned int freed_win_mask)
+{
+	s->exynos_state.base.dev = &t->private.drm;
+	s->exynos_state.base.crtcs = s->crtcs_state;
+	s->crtc_state.base.crtc = &t->crtcs[index];
+	s->crtc_state.freed_win_mask = freed_win_mask;
+	s->crtcs_state[index].ptr = &t->crtcs[index];
+	s->crtcs_state[index].new_state = &s->crtc_state.base;
+}
+
+static struct drm_crtc_commit *win_handoff_commit(struct kunit *test, struct drm_crtc *crtc)
+{
+	struct drm_crtc_commit *commit = kzalloc(sizeof(*commit), GFP_KERNEL);
+
+	KUNIT_ASSERT_NOT_ERR_OR_NULL(test, commit);
+	commit->crtc = crtc;
+	init_completion(&commit->hw_done);
+	kref_init(&commit->ref);
+
+	spin_lock(&crtc->commit_lock);
+	list_add(&commit->commit_entry, &crtc->commit_list);
+	spin_unlock(&crtc->commit_lock);
+
+	return commit;
+}
+
+static void win_handoff_hw_done(struct win_handoff_state *s, struct drm_crtc_commit *commit)
+{
+	exynos_atomic_release_windows(s->crtc_state.base.crtc, &s->crtc_state.base);
+	complete_all(&commit->hw_done);
+}
+
+static void win_handoff_test_work(struct kthread_work *work)
+{
+	struct win_handoff_test *t = container_of(work, struct win_handoff_test, b_work);
+	unsigned long flags;
+
+	exynos_atomic_wait_for_windows(&t->b.exynos_state.base);
+
+	spin_lock_irqsave(&t->private.lock, flags);
+	t->b_pending_win_mask = t->private.pending_win_mask[0];
+	spin_unlock_irqrestore(&t->private.lock, flags);
+
+	complete(&t->b_done);
+}
+
+static void exynos_window_handoff_interleave_test(struct kunit *test)
+{
+	struct win_handoff_test *t = kunit_kzalloc(test, sizeof(*t), GFP_KERNEL);
+	const struct exynos_drm_priv_state priv_state = { .available_win_mask = 0x7 };
+	struct drm_crtc_commit *a1, *a2;
+	struct kthread_worker *worker;
+	struct drm_device *dev;
+	int i;
+
+	KUNIT_ASSERT_NOT_ERR_OR_NULL(test, t);
+
+	dev = &t->private.drm;
+	dev->mode_config.num_crtc = MAX_CRTC;
+	INIT_LIST_HEAD(&dev->mode_config.crtc_list);
+	spin_lock_init(&t->private.lock);
+	for (i = 0; i < MAX_CRTC; i++) {
+		t->crtcs[i].dev = dev;
+		t->crtcs[i].index = i;
+		spin_lock_init(&t->crtcs[i].commit_lock);
+		INIT_LIST_HEAD(&t->crtcs[i].commit_list);
+		list_add_tail(&t->crtcs[i].head, &dev->mode_config.crtc_list);
+	}
+	init_completion(&t->b_done);
+	kthread_init_work(&t->b_work, win_handoff_test_work);
+
+	/* two commits on crtc 0 freeing windows 0-1 and 2, neither done in hw yet */
+	win_handoff_state_init(t, &t->a1, 0, 0x3);
+	a1 = win_handoff_commit(test, &t->crtcs[0]);
+	exynos_atomic_setup_windows(&t->a1.exynos_state.base);
+
+	win_handoff_state_init(t, &t->a2, 0, 0x4);
+	a2 = win_handoff_commit(test, &t->crtcs[0]);
+	exynos_atomic_setup_windows(&t->a2.exynos_state.base);
+	KUNIT_EXPECT_EQ(test, t->private.pending_win_mask[0], 0x7u);
+
+	/* crtc 1 needs all of them, and waits for the latest commit on crtc 0 */
+	win_handoff_state_init(t, &t->b, 1, 0);
+	KUNIT_EXPECT_EQ(test, exynos_atomic_find_windows(&t->b.exynos_state.base, &priv_state, 3),
+			0x7u);
+	KUNIT_EXPECT_EQ(test, t->b.exynos_state.win_wait_crtc_mask, (u32)BIT(0));
+	exynos_atomic_setup_windows(&t->b.exynos_state.base);
+	KUNIT_EXPECT_PTR_EQ(test, t->b.exynos_state.win_commits[0], a2);
+	KUNIT_EXPECT_PTR_EQ(test, t->b.exynos_state.win_commits[1], NULL);
+
+	worker = kthread_create_worker(0, "win_handoff_test");
+	KUNIT_ASSERT_NOT_ERR_OR_NULL(test, worker);
+	kthread_queue_work(worker, &t->b_work);
+
+	KUNIT_EXPECT_EQ(test, wait_for_completion_timeout(&t->b_done, msecs_to_jiffies(100)), 0ul);
+
+	/* the first commit is done, window 2 is still in use by crtc 0 */
+	win_handoff_hw_done(&t->a1, a1);
+	KUNIT_EXPECT_EQ(test, t->private.pending_win_mask[0], 0x4u);
+	KUNIT_EXPECT_EQ(test, wait_for_completion_timeout(&t->b_done, msecs_to_jiffies(100)), 0ul);
+
+	win_handoff_hw_done(&t->a2, a2);
+	KUNIT_EXPECT_NE(test, wait_for_completion_timeout(&t->b_done, HZ), 0ul);
+	KUNIT_EXPECT_EQ(test, t->b_pending_win_mask, 0u);
+
+	kthread_flush_worker(worker);
+	kthread_destroy_worker(worker);
+
+	drm_crtc_commit_put(t->b.exynos_state.win_commits[0]);
+	list_del(&a1->commit_entry);
+	list_del(&a2->commit_entry);
+	drm_crtc_commit_put(a1);
+	drm_crtc_commit_put(a2);
+}
+
+static struct kunit_case exynos_drm_drv_test_cases[] = {
+	KUNIT_CASE(exynos_split_crtc_mask_test),
+	KUNIT_CASE(exynos_split_commit_queue_test),
+	KUNIT_CASE(exynos_select_windows_prefers_idle),
+	KUNIT_CASE(exynos_select_windows_stress),
+	KUNIT_CASE(exynos_window_handoff_interleave_test),
+	{}
+};
+
+static struct kunit_suite exynos_drm_drv_test_suite = {
+	.name = "exynos-drm-drv",
+	.test_cases = exynos_drm_drv_test_cases,
+};
+
+kunit_test_suites(&exynos_drm_drv_test_suite);
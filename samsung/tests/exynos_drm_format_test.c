@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * KUnit tests for exynos_drm_format.c, built into the driver when
+ * CONFIG_DRM_SAMSUNG_KUNIT_TEST is enabled.
+ *
+ * Copyright (C) 2026 Google LLC
+ */
+
+#include <kunit/test.h>
+#include <linux/ktime.h>
+
+#define FMT_BENCH_ROUNDS	10000
+
+/* reference lookup, the way formats were searched before the hash */
+static const struct dpu_fmt *dpu_find_fmt_info_linear(u32 fmt)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(dpu_formats_list); i++)
+		if (dpu_formats_list[i].fmt == fmt)
+			return &dpu_formats_list[i];
+
+	return NULL;
+}
+
+static int dpu_fmt_probe_len(u32 fmt)
+{
+	u32 slot = hash_32(fmt, DPU_FMT_HASH_BITS);
+	int len = 1;
+
+	while (dpu_formats_list[dpu_fmt_hash[slot] - 1].fmt != fmt) {
+		slot = (slot + 1) & DPU_FMT_HASH_MASK;
+		len++;
+	}
+
+	return len;
+}
+
+static int dpu_fmt_test_init(struct kunit *test)
+{
+	/* the hash is filled at module init, make sure it is there when built in */
+	if (!dpu_find_fmt_info(dpu_formats_list[0].fmt))
+		dpu_init_fmt_info();
+
+	return 0;
+}
+
+static void dpu_find_fmt_info_matches_list(struct kunit *test)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(dpu_formats_list); i++) {
+		const u32 fmt = dpu_formats_list[i].fmt;
+
+		KUNIT_EXPECT_PTR_EQ(test, dpu_find_fmt_info(fmt), dpu_find_fmt_info_linear(fmt));
+		KUNIT_EXPECT_LE(test, dpu_fmt_probe_len(fmt), 2);
+	}
+
+	KUNIT_EXPECT_PTR_EQ(test, dpu_find_fmt_info(0), NULL);
+	KUNIT_EXPECT_PTR_EQ(test, dpu_find_fmt_info(fourcc_code('X', 'X', 'X', 'X')), NULL);
+}
+
+static void dpu_find_fmt_info_bench(struct kunit *test)
+{
+	const struct dpu_fmt *fmt_info;
+	ktime_t start, hash_ns, linear_ns;
+	unsigned long found = 0;
+	int n, i;
+
+	start = ktime_get();
+	for (n = 0; n < FMT_BENCH_ROUNDS; n++)
+		for (i = 0; i < ARRAY_SIZE(dpu_formats_list); i++) {
+			fmt_info = dpu_find_fmt_info(READ_ONCE(dpu_formats_list[i].fmt));
+			found += !!fmt_info;
+		}
+	hash_ns = ktime_sub(ktime_get(), start);
+
+	start = ktime_get();
+	for (n = 0; n < FMT_BENCH_ROUNDS; n++)
+		for (i = 0; i < ARRAY_SIZE(dpu_formats_list); i++) {
+			fmt_info = dpu_find_fmt_info_linear(READ_ONCE(dpu_formats_list[i].fmt));
+			found += !!fmt_info;
+		}
+	linear_ns = ktime_sub(ktime_get(), start);
+
+	KUNIT_EXPECT_EQ(test, found, 2UL * FMT_BENCH_ROUNDS * ARRAY_SIZE(dpu_formats_list));
+
+	kunit_info(test, "%zu formats, %d rounds: hash %lld ns, linear %lld ns\n",
+		   ARRAY_SIZE(dpu_formats_list), FMT_BENCH_ROUNDS,
+		   ktime_to_ns(hash_ns), ktime_to_ns(linear_ns));
+}
+
+static struct kunit_case dpu_fmt_test_cases[] = {
+	KUNIT_CASE(dpu_find_fmt_info_matches_list),
+	KUNIT_CASE(dpu_find_fmt_info_bench),
+	{}
+};
+
+static struct kunit_suite dpu_fmt_test_suite = {
+	.name = "exynos-drm-format",
+	.init = dpu_fmt_test_init,
+	.test_cases = dpu_fmt_test_cases,
+};
+
+kunit_test_suites(&dpu_fmt_test_suite);
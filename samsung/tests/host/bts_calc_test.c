@@ -0,0 +1,187 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Checks of the BTS bandwidth and DISP clock calculation against values
+ * worked out by hand for a 1440x3040@60 command mode panel.
+ */
+
+#include <drm/drm_fourcc.h>
+
+#include "exynos_drm_bts_calc.h"
+
+#include "host_test.h"
+
+#define LCD_W		1440
+#define LCD_H		3040
+
+/* 1440 * 3040 * 4 bytes * 60 / 1000 */
+#define FULL_AVG_BW	1050624
+/* FULL_AVG_BW * 1.1 */
+#define FULL_RT_BW	1155686
+
+static const struct dpu_bts_params test_params = {
+	.ppc = 2,
+	.ppc_rotator = 4,
+	.ppc_scaler = 2,
+	.delay_comp = 4,
+	.delay_scaler = 2,
+	.bus_width = 16,
+	.bus_util_pct = 65,
+	.rot_util_pct = 60,
+	.afbc_rgb_util_pct = 100,
+	.afbc_yuv_util_pct = 100,
+	.afbc_rgb_rt_util_pct = 100,
+	.afbc_yuv_rt_util_pct = 100,
+	.dfs_lv_cnt = 3,
+	.dfs_lv_khz = { 663000, 400000, 134000 },
+	.ch_num = { 0, 0, 1, 1, 2, 2 },
+};
+
+static const struct dpu_bts_disp_info test_disp = {
+	.width = LCD_W,
+	.height = LCD_H,
+	.dsc_enabled = true,
+	.dsc_count = 2,
+	.slice_count = 2,
+	.fps = 60,
+	.vbp = 15,
+	.vfp = 8,
+	.vsa = 1,
+	.vblank_usec = 500,
+};
+
+static void set_win(struct dpu_bts_frame *frame, int ch, int y, u32 h)
+{
+	struct dpu_bts_win_config *win = &frame->win_config[ch];
+
+	win->state = DPU_WIN_STATE_BUFFER;
+	win->src_w = win->dst_w = LCD_W;
+	win->src_h = win->dst_h = h;
+	win->dst_y = y;
+	win->dpp_ch = ch;
+	win->format = DRM_FORMAT_ARGB8888;
+	win->bpp = 32;
+	frame->win_cnt = max_t(u32, frame->win_cnt, ch + 1);
+}
+
+static void test_full_screen(void)
+{
+	struct dpu_bts_frame frame = { 0 };
+	struct dpu_bts_result res;
+
+	set_win(&frame, 0, 0, LCD_H);
+	dpu_bts_calc(&test_params, &test_disp, &frame, &res);
+
+	EXPECT_EQ(res.read_bw, FULL_AVG_BW);
+	EXPECT_EQ(res.write_bw, 0);
+	EXPECT_EQ(res.total_bw, FULL_AVG_BW);
+	EXPECT_EQ(res.rt_bw[0], FULL_RT_BW);
+	EXPECT_EQ(res.rt_avg_bw, FULL_RT_BW);
+	EXPECT_EQ(res.ch_bw[0], FULL_RT_BW);
+	EXPECT_EQ(res.ch_bw[1], 0);
+	EXPECT_EQ(res.peak, FULL_RT_BW);
+	/* at least what the busiest AXI port needs at bus_util_pct */
+	EXPECT(res.max_disp_freq >= FULL_RT_BW * 100 / (16 * 65));
+}
+
+static void test_overlap(void)
+{
+	struct dpu_bts_frame frame = { 0 };
+	struct dpu_bts_result res;
+
+	/* top half on port 0 overlaps the full screen layer, bottom half on port 1 doesn't */
+	set_win(&frame, 0, 0, LCD_H);
+	set_win(&frame, 1, 0, LCD_H / 2);
+	set_win(&frame, 2, LCD_H / 2, LCD_H / 2);
+	dpu_bts_calc(&test_params, &test_disp, &frame, &res);
+
+	/* half height layers need twice the rt bandwidth per line of their own height */
+	EXPECT_EQ(res.rt_bw[1], res.rt_bw[2]);
+	EXPECT_EQ(res.rt_avg_bw, res.rt_bw[0] + res.rt_bw[1]);
+	EXPECT_EQ(res.ch_bw[0], res.rt_bw[0] + res.rt_bw[1]);
+	EXPECT_EQ(res.ch_bw[1], res.rt_bw[2]);
+	EXPECT_EQ(res.peak, res.ch_bw[0]);
+}
+
+static void test_other_decons(void)
+{
+	struct dpu_bts_frame frame = { 0 };
+	struct dpu_bts_result res;
+
+	set_win(&frame, 2, 0, LCD_H);
+	frame.other_rt_avg_bw = 8 * FULL_RT_BW;
+	frame.other_ch_bw[0] = 2 * FULL_RT_BW;
+	dpu_bts_calc(&test_params, &test_disp, &frame, &res);
+
+	/* only this decon's bandwidth is reported, but the peak includes the others */
+	EXPECT_EQ(res.rt_avg_bw, FULL_RT_BW);
+	EXPECT_EQ(res.ch_bw[1], FULL_RT_BW);
+	EXPECT_EQ(res.peak, 9 * FULL_RT_BW / 4);
+}
+
+static void test_afbc_util(void)
+{
+	struct dpu_bts_params params = test_params;
+	struct dpu_bts_frame frame = { 0 };
+	struct dpu_bts_result res;
+
+	set_win(&frame, 0, 0, LCD_H);
+	frame.win_config[0].is_comp = true;
+	params.afbc_rgb_util_pct = 50;
+	params.afbc_rgb_rt_util_pct = 80;
+	dpu_bts_calc(&params, &test_disp, &frame, &res);
+
+	EXPECT_EQ(res.total_bw, FULL_AVG_BW / 2);
+	EXPECT_EQ(res.rt_avg_bw, FULL_RT_BW * 80 / 100);
+
+	/* yuv utilization is separate */
+	frame.win_config[0].is_yuv = true;
+	dpu_bts_calc(&params, &test_disp, &frame, &res);
+	EXPECT_EQ(res.total_bw, FULL_AVG_BW);
+}
+
+static void test_no_layers(void)
+{
+	struct dpu_bts_frame frame = { 0 };
+	struct dpu_bts_result res;
+
+	frame.win_cnt = MAX_WIN_PER_DECON;
+	dpu_bts_calc(&test_params, &test_disp, &frame, &res);
+
+	EXPECT_EQ(res.total_bw, 0);
+	EXPECT_EQ(res.peak, 0);
+	EXPECT_EQ(res.rt_avg_bw, 0);
+	EXPECT_EQ(res.ch_bw[0], 0);
+	/* colormap still needs DISP clock for a full screen window */
+	EXPECT(res.max_disp_freq > 0);
+	EXPECT(res.resol_clk > 0);
+}
+
+static void test_rotation(void)
+{
+	struct dpu_bts_frame frame = { 0 };
+	struct dpu_bts_result plain, rot;
+
+	set_win(&frame, 0, 0, LCD_H);
+	dpu_bts_calc(&test_params, &test_disp, &frame, &plain);
+
+	frame.win_config[0].src_w = LCD_H;
+	frame.win_config[0].src_h = LCD_W;
+	frame.win_config[0].is_rot = true;
+	dpu_bts_calc(&test_params, &test_disp, &frame, &rot);
+
+	/* rotation has to fetch a whole column within vblank */
+	EXPECT(rot.rt_bw[0] >= plain.rt_bw[0]);
+	EXPECT(rot.max_disp_freq >= plain.max_disp_freq);
+}
+
+int main(void)
+{
+	test_full_screen();
+	test_overlap();
+	test_other_decons();
+	test_afbc_util();
+	test_no_layers();
+	test_rotation();
+
+	return host_test_done("bts_calc_test");
+}
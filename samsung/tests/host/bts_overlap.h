@@ -0,0 +1,215 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Pairwise overlap bandwidth calculation the sweep in exynos_drm_bts_calc.c
+ * replaced, kept as reference for its results and cost, and random window
+ * layouts to compare both on.
+ *
+ * In the reference every window sums up the bandwidth of the windows covering
+ * its first line. @rt_bw and @ch_num are indexed by dpp channel like in
+ * struct dpu_bts_result and struct dpu_bts_params, but may be longer to
+ * evaluate more windows than a decon has.
+ */
+#ifndef __BTS_OVERLAP_H__
+#define __BTS_OVERLAP_H__
+
+#include "exynos_drm_bts_calc.h"
+
+static bool ref_is_win_half_covered(const struct dpu_bts_win_config *config0,
+				    const struct dpu_bts_win_config *config1)
+{
+	u32 start_y0;
+	u32 start_y1, end_y1;
+
+	if (config0 == config1)
+		return true;
+
+	start_y0 = config0->dst_y;
+	start_y1 = config1->dst_y;
+	end_y1 = config1->dst_y + config1->dst_h;
+
+	if (start_y0 >= start_y1 && start_y0 < end_y1)
+		return true;
+
+	return false;
+}
+
+static u32 ref_overlap_bw(int win_cnt, const struct dpu_bts_win_config *win_config,
+			  const struct dpu_bts_win_config *rcd_config, const u32 *rt_bw)
+{
+	int i, j;
+	u32 win_max_overlap_bw = 0, rcd_max_overlap_bw = 0;
+
+	for (i = 0; i < win_cnt; i++) {
+		u32 overlap_bw;
+
+		if (win_config[i].state != DPU_WIN_STATE_BUFFER)
+			continue;
+
+		overlap_bw = 0;
+		for (j = 0; j < win_cnt; j++) {
+			if (win_config[j].state != DPU_WIN_STATE_BUFFER)
+				continue;
+
+			if (ref_is_win_half_covered(&win_config[i], &win_config[j]))
+				overlap_bw += rt_bw[win_config[j].dpp_ch];
+		}
+
+		if (rcd_config->state == DPU_WIN_STATE_BUFFER) {
+			if (ref_is_win_half_covered(&win_config[i], rcd_config))
+				overlap_bw += rt_bw[rcd_config->dpp_ch];
+
+			if (ref_is_win_half_covered(rcd_config, &win_config[i]))
+				rcd_max_overlap_bw += rt_bw[win_config[i].dpp_ch];
+		}
+
+		win_max_overlap_bw = max(win_max_overlap_bw, overlap_bw);
+	}
+
+	if (rcd_config->state == DPU_WIN_STATE_BUFFER)
+		rcd_max_overlap_bw += rt_bw[rcd_config->dpp_ch];
+
+	return max(win_max_overlap_bw, rcd_max_overlap_bw);
+}
+
+static void ref_disp_ch_bw(int win_cnt, const struct dpu_bts_win_config *win_config,
+			   const struct dpu_bts_win_config *rcd_config, const u32 *rt_bw,
+			   const u32 *ch_num, u32 disp_ch_bw[MAX_AXI_PORT])
+{
+	int i, j;
+	u32 rcd_overlap_ch_bw = 0;
+
+	memset(disp_ch_bw, 0, sizeof(u32) * MAX_AXI_PORT);
+	for (i = 0; i < win_cnt; i++) {
+		int dpp_ch = win_config[i].dpp_ch;
+		u32 ch = ch_num[dpp_ch];
+		u32 overlap_ch_bw;
+
+		if (win_config[i].state != DPU_WIN_STATE_BUFFER)
+			continue;
+
+		if (ch >= MAX_AXI_PORT)
+			continue;
+
+		overlap_ch_bw = 0;
+		for (j = 0; j < win_cnt; j++) {
+			if (win_config[j].state != DPU_WIN_STATE_BUFFER)
+				continue;
+
+			if (ch == ch_num[win_config[j].dpp_ch] &&
+			    ref_is_win_half_covered(&win_config[i], &win_config[j]))
+				overlap_ch_bw += rt_bw[win_config[j].dpp_ch];
+		}
+
+		if (rcd_config->state == DPU_WIN_STATE_BUFFER) {
+			int rcd_dpp_ch = rcd_config->dpp_ch;
+
+			if (ch == ch_num[rcd_dpp_ch]) {
+				if (ref_is_win_half_covered(&win_config[i], rcd_config))
+					overlap_ch_bw += rt_bw[rcd_dpp_ch];
+
+				if (ref_is_win_half_covered(rcd_config, &win_config[i]))
+					rcd_overlap_ch_bw += rt_bw[dpp_ch];
+			}
+		}
+		disp_ch_bw[ch] = max(disp_ch_bw[ch], overlap_ch_bw);
+	}
+
+	if (rcd_config->state == DPU_WIN_STATE_BUFFER) {
+		u32 rcd_ch = ch_num[rcd_config->dpp_ch];
+
+		if (rcd_ch < MAX_AXI_PORT) {
+			rcd_overlap_ch_bw += rt_bw[rcd_config->dpp_ch];
+			disp_ch_bw[rcd_ch] = max(disp_ch_bw[rcd_ch], rcd_overlap_ch_bw);
+		}
+	}
+}
+
+#define BTS_LAYOUT_LCD_H		3040
+#define BTS_LAYOUT_MAX_WIN		32
+
+/* @n windows and an optional RCD window, which uses dpp channel @n */
+struct bts_layout {
+	int n;
+	struct dpu_bts_win_config win[BTS_LAYOUT_MAX_WIN];
+	struct dpu_bts_win_config rcd;
+	u32 rt_bw[BTS_LAYOUT_MAX_WIN + 1];
+	u32 ch_num[BTS_LAYOUT_MAX_WIN + 1];
+};
+
+static u32 bts_rand_state = 0x5eed;
+
+/* xorshift32, for layouts reproducible across runs */
+static u32 bts_rand(void)
+{
+	bts_rand_state ^= bts_rand_state << 13;
+	bts_rand_state ^= bts_rand_state >> 17;
+	bts_rand_state ^= bts_rand_state << 5;
+
+	return bts_rand_state;
+}
+
+static void bts_rand_win(struct dpu_bts_win_config *win, int dpp_ch, bool allow_zero_h)
+{
+	/* few distinct lines so that windows often start and end on the same one */
+	static const u32 lines[] = {
+		0, 1, 100, 101, BTS_LAYOUT_LCD_H / 4, BTS_LAYOUT_LCD_H / 2,
+		BTS_LAYOUT_LCD_H - 1, BTS_LAYOUT_LCD_H,
+	};
+	u32 y0, y1;
+
+	memset(win, 0, sizeof(*win));
+
+	switch (bts_rand() % 8) {
+	case 0:
+		win->state = DPU_WIN_STATE_DISABLED;
+		break;
+	case 1:
+		win->state = DPU_WIN_STATE_COLOR;
+		break;
+	default:
+		win->state = DPU_WIN_STATE_BUFFER;
+		break;
+	}
+
+	if (bts_rand() % 2) {
+		y0 = lines[bts_rand() % ARRAY_SIZE(lines)];
+		y1 = lines[bts_rand() % ARRAY_SIZE(lines)];
+	} else {
+		y0 = bts_rand() % BTS_LAYOUT_LCD_H;
+		y1 = bts_rand() % (BTS_LAYOUT_LCD_H + 1);
+	}
+	if (y0 > y1)
+		swap(y0, y1);
+	if (y0 == y1 && !allow_zero_h)
+		y1++;
+
+	win->dst_y = y0;
+	win->dst_h = y1 - y0;
+	win->dst_w = 1 + bts_rand() % 1440;
+	win->src_w = 1 + bts_rand() % 1440;
+	/* at most the 1/4 downscale of the DPP, so that sums of rt bw stay within u32 */
+	win->src_h = 1 + bts_rand() % min_t(u32, 4 * max(win->dst_h, 1U), BTS_LAYOUT_LCD_H);
+	win->bpp = (bts_rand() % 2) ? 32 : 12;
+	win->dpp_ch = dpp_ch;
+}
+
+/* @n windows of random bandwidth, @invalid_ch also picks AXI ports out of range */
+static void bts_rand_layout(struct bts_layout *layout, int n, bool with_rcd, bool invalid_ch)
+{
+	int i;
+
+	layout->n = n;
+	for (i = 0; i <= n; i++) {
+		layout->rt_bw[i] = bts_rand() % (1 << 22);
+		layout->ch_num[i] = bts_rand() % (MAX_AXI_PORT + invalid_ch);
+	}
+
+	for (i = 0; i < n; i++)
+		bts_rand_win(&layout->win[i], i, true);
+
+	bts_rand_win(&layout->rcd, n, true);
+	if (!with_rcd)
+		layout->rcd.state = DPU_WIN_STATE_DISABLED;
+}
+
+#endif /* __BTS_OVERLAP_H__ */
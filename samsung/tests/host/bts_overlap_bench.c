@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Cost of finding the peak overlap bandwidth of a frame with the sweep over
+ * window edges against the pairwise comparison it replaced, for 8, 16 and 32
+ * windows, and of the whole calculation for a fully used decon.
+ */
+
+#include "exynos_drm_bts_calc.c"
+
+#include "bts_overlap.h"
+#include "host_test.h"
+
+#define BENCH_LAYOUTS	256
+#define BENCH_ITERS	200000
+
+static struct bts_layout layouts[BENCH_LAYOUTS];
+
+static u32 bench_sweep(const struct bts_layout *layout, u32 *ch_bw)
+{
+	struct dpu_bts_edge edges[(BTS_LAYOUT_MAX_WIN + 1) * 2];
+	int i, cnt = 0;
+
+	for (i = 0; i < layout->n; i++) {
+		if (layout->win[i].state != DPU_WIN_STATE_BUFFER)
+			continue;
+		cnt = dpu_bts_add_edges(edges, cnt, &layout->win[i], layout->rt_bw[i],
+					layout->ch_num[i]);
+	}
+	if (layout->rcd.state == DPU_WIN_STATE_BUFFER)
+		cnt = dpu_bts_add_edges(edges, cnt, &layout->rcd, layout->rt_bw[layout->n],
+					layout->ch_num[layout->n]);
+
+	return dpu_bts_sweep_edges(edges, cnt, ch_bw);
+}
+
+static u32 bench_pairwise(const struct bts_layout *layout, u32 *ch_bw)
+{
+	ref_disp_ch_bw(layout->n, layout->win, &layout->rcd, layout->rt_bw, layout->ch_num,
+		       ch_bw);
+
+	return ref_overlap_bw(layout->n, layout->win, &layout->rcd, layout->rt_bw);
+}
+
+static void bench_overlap(int n)
+{
+	u32 ch_bw[MAX_AXI_PORT];
+	volatile u32 sink;
+	double pairwise_ns, sweep_ns;
+	unsigned int k;
+	int i;
+
+	for (i = 0; i < BENCH_LAYOUTS; i++)
+		bts_rand_layout(&layouts[i], n, true, false);
+
+	printf("%d windows + RCD:\n", n);
+	k = 0;
+	pairwise_ns = BENCH("pairwise", BENCH_ITERS,
+			    sink = bench_pairwise(&layouts[k++ % BENCH_LAYOUTS], ch_bw));
+	k = 0;
+	sweep_ns = BENCH("sweep", BENCH_ITERS,
+			 sink = bench_sweep(&layouts[k++ % BENCH_LAYOUTS], ch_bw));
+	printf("  %-40s %10.2fx\n", "speedup", pairwise_ns / sweep_ns);
+	(void)sink;
+}
+
+static void bench_calc(void)
+{
+	static const struct dpu_bts_params params = {
+		.ppc = 2,
+		.ppc_rotator = 4,
+		.ppc_scaler = 2,
+		.delay_comp = 4,
+		.delay_scaler = 2,
+		.bus_width = 16,
+		.bus_util_pct = 65,
+		.rot_util_pct = 60,
+		.afbc_rgb_util_pct = 100,
+		.afbc_yuv_util_pct = 100,
+		.afbc_rgb_rt_util_pct = 100,
+		.afbc_yuv_rt_util_pct = 100,
+		.dfs_lv_cnt = 3,
+		.dfs_lv_khz = { 663000, 400000, 134000 },
+		.ch_num = { 0, 0, 1, 1, 2, 2, 0 },
+	};
+	static const struct dpu_bts_disp_info disp = {
+		.width = 1440,
+		.height = BTS_LAYOUT_LCD_H,
+		.dsc_enabled = true,
+		.dsc_count = 2,
+		.slice_count = 2,
+		.fps = 120,
+		.vbp = 15,
+		.vfp = 8,
+		.vsa = 1,
+		.vblank_usec = 500,
+	};
+	static struct dpu_bts_frame frames[BENCH_LAYOUTS];
+	struct dpu_bts_result res;
+	unsigned int k = 0;
+	int i, j;
+
+	for (i = 0; i < BENCH_LAYOUTS; i++) {
+		frames[i].win_cnt = MAX_WIN_PER_DECON;
+		for (j = 0; j < MAX_WIN_PER_DECON; j++) {
+			bts_rand_win(&frames[i].win_config[j], j, false);
+			frames[i].win_config[j].state = DPU_WIN_STATE_BUFFER;
+		}
+		bts_rand_win(&frames[i].rcd_config, MAX_DPP_CNT - 1, false);
+	}
+
+	printf("%d windows + RCD:\n", MAX_WIN_PER_DECON);
+	BENCH("dpu_bts_calc()", BENCH_ITERS,
+	      dpu_bts_calc(&params, &disp, &frames[k++ % BENCH_LAYOUTS], &res));
+}
+
+int main(void)
+{
+	bench_overlap(8);
+	bench_overlap(16);
+	bench_overlap(32);
+	bench_calc();
+
+	return 0;
+}
@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Checks that the sweep over window edges finds the same peak overlap
+ * bandwidth, in total and per DPU AXI port, as the pairwise comparison it
+ * replaced, on a corpus of random window layouts.
+ */
+
+#include "exynos_drm_bts_calc.c"
+
+#include "bts_overlap.h"
+#include "host_test.h"
+
+#define CALC_CORPUS_SIZE	100000
+#define SWEEP_CORPUS_SIZE	20000
+
+static const struct dpu_bts_disp_info test_disp = {
+	.width = 1440,
+	.height = BTS_LAYOUT_LCD_H,
+	.dsc_enabled = true,
+	.dsc_count = 2,
+	.slice_count = 2,
+	.fps = 60,
+	.vbp = 15,
+	.vfp = 8,
+	.vsa = 1,
+	.vblank_usec = 500,
+};
+
+/* whole calculation, with the rt bandwidth of each window derived from its size */
+static void test_calc_corpus(void)
+{
+	struct dpu_bts_params params = {
+		.ppc = 2,
+		.ppc_rotator = 4,
+		.ppc_scaler = 2,
+		.delay_comp = 4,
+		.delay_scaler = 2,
+		.bus_width = 16,
+		.bus_util_pct = 65,
+		.rot_util_pct = 60,
+		.afbc_rgb_util_pct = 100,
+		.afbc_yuv_util_pct = 100,
+		.afbc_rgb_rt_util_pct = 100,
+		.afbc_yuv_rt_util_pct = 100,
+		.dfs_lv_cnt = 1,
+		.dfs_lv_khz = { 400000 },
+	};
+	struct dpu_bts_frame frame;
+	struct dpu_bts_result res;
+	u32 ch_bw[MAX_AXI_PORT];
+	int n, i, mismatches = 0;
+
+	for (n = 0; n < CALC_CORPUS_SIZE; n++) {
+		memset(&frame, 0, sizeof(frame));
+		frame.win_cnt = MAX_WIN_PER_DECON;
+		for (i = 0; i < MAX_WIN_PER_DECON; i++)
+			bts_rand_win(&frame.win_config[i], i, false);
+		bts_rand_win(&frame.rcd_config, MAX_DPP_CNT - 1, false);
+		if (bts_rand() % 2)
+			frame.rcd_config.state = DPU_WIN_STATE_DISABLED;
+		for (i = 0; i < MAX_DPP_CNT; i++)
+			params.ch_num[i] = bts_rand() % MAX_AXI_PORT;
+
+		dpu_bts_calc(&params, &test_disp, &frame, &res);
+		ref_disp_ch_bw(frame.win_cnt, frame.win_config, &frame.rcd_config, res.rt_bw,
+			       params.ch_num, ch_bw);
+
+		if (res.rt_avg_bw != ref_overlap_bw(frame.win_cnt, frame.win_config,
+						    &frame.rcd_config, res.rt_bw) ||
+		    memcmp(res.ch_bw, ch_bw, sizeof(ch_bw)))
+			mismatches++;
+	}
+
+	EXPECT_EQ(mismatches, 0);
+}
+
+/* sweep alone, up to more windows than a decon has and with zero height windows */
+static void test_sweep_corpus(void)
+{
+	static const int win_cnts[] = { 1, 2, 3, 4, 5, 6, 8, 16, 32 };
+	struct dpu_bts_edge edges[(BTS_LAYOUT_MAX_WIN + 1) * 2];
+	struct bts_layout layout;
+	u32 ch_bw[MAX_AXI_PORT], ref_ch_bw[MAX_AXI_PORT];
+	u32 overlap_bw;
+	int n, i, k, cnt, mismatches = 0;
+
+	for (n = 0; n < SWEEP_CORPUS_SIZE; n++) {
+		for (k = 0; k < ARRAY_SIZE(win_cnts); k++) {
+			bts_rand_layout(&layout, win_cnts[k], n % 2, true);
+
+			cnt = 0;
+			for (i = 0; i < layout.n; i++) {
+				if (layout.win[i].state != DPU_WIN_STATE_BUFFER)
+					continue;
+				cnt = dpu_bts_add_edges(edges, cnt, &layout.win[i], layout.rt_bw[i],
+							layout.ch_num[i]);
+			}
+			if (layout.rcd.state == DPU_WIN_STATE_BUFFER)
+				cnt = dpu_bts_add_edges(edges, cnt, &layout.rcd,
+							layout.rt_bw[layout.n],
+							layout.ch_num[layout.n]);
+
+			overlap_bw = dpu_bts_sweep_edges(edges, cnt, ch_bw);
+			ref_disp_ch_bw(layout.n, layout.win, &layout.rcd, layout.rt_bw,
+				       layout.ch_num, ref_ch_bw);
+
+			if (overlap_bw != ref_overlap_bw(layout.n, layout.win, &layout.rcd,
+							 layout.rt_bw) ||
+			    memcmp(ch_bw, ref_ch_bw, sizeof(ch_bw))) {
+				if (!mismatches)
+					fprintf(stderr, "first mismatch: layout %d of %d windows\n",
+						n, layout.n);
+				mismatches++;
+			}
+		}
+	}
+
+	EXPECT_EQ(mismatches, 0);
+}
+
+int main(void)
+{
+	test_calc_corpus();
+	test_sweep_corpus();
+
+	return host_test_done("bts_overlap_test");
+}
@@ -0,0 +1,404 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Replays the window configurations of atomic commits recorded in a decon
+ * event log through the BTS calculation and reports bandwidth and DISP clock
+ * of every frame, then how fast the calculation itself runs.
+ *
+ * The input is what the event_raw debugfs file of a crtc streams, e.g.
+ *
+ *   adb shell cat /sys/kernel/debug/dri/0/crtc-0/event_raw > decon0.raw
+ *   bts_replay -m 1440x3040@120 -f 663000,400000,134000 decon0.raw
+ *
+ * DPU characteristics default to the ones the driver falls back to without
+ * device tree properties and can be overridden with -p, like
+ * -p afbc_rgb_rt_util_pct=80 to evaluate a different AFBC utilization.
+ */
+
+#include <errno.h>
+#include <getopt.h>
+#include <stdlib.h>
+
+#include "exynos_drm_bts_calc.h"
+
+#include "host_test.h"
+
+/* enum dpu_event_type value of DPU_EVT_ATOMIC_COMMIT records */
+#define BTS_REPLAY_ATOMIC_COMMIT	23
+#define BTS_REPLAY_MAX_RECORD		4096
+#define BTS_REPLAY_DEFAULT_LOOPS	1000
+
+/* header of the struct dpu_log records of event_raw */
+struct bts_replay_log_hdr {
+	u32 seq;
+	u16 size;
+	u16 type;
+	ktime_t time;
+};
+
+/* struct dpu_log_atomic, data of DPU_EVT_ATOMIC_COMMIT records */
+struct bts_replay_atomic {
+	struct decon_win_config win_config[MAX_WIN_PER_DECON];
+	struct decon_win_config rcd_win_config;
+};
+
+struct bts_replay {
+	struct dpu_bts_params params;
+	struct dpu_bts_disp_info disp;
+	struct dpu_bts_frame *frames;
+	size_t frame_cnt;
+	size_t frame_max;
+	u32 event_type;
+};
+
+#define BTS_PARAM(name)	{ #name, offsetof(struct dpu_bts_params, name) }
+
+static const struct {
+	const char *name;
+	size_t offset;
+} bts_replay_params[] = {
+	BTS_PARAM(ppc_rotator),
+	BTS_PARAM(ppc_scaler),
+	BTS_PARAM(delay_comp),
+	BTS_PARAM(delay_scaler),
+	BTS_PARAM(bus_width),
+	BTS_PARAM(bus_util_pct),
+	BTS_PARAM(rot_util_pct),
+	BTS_PARAM(afbc_rgb_util_pct),
+	BTS_PARAM(afbc_yuv_util_pct),
+	BTS_PARAM(afbc_rgb_rt_util_pct),
+	BTS_PARAM(afbc_yuv_rt_util_pct),
+};
+
+/* same defaults as decon_parse_dt() */
+static void bts_replay_init(struct bts_replay *rp)
+{
+	struct dpu_bts_params *params = &rp->params;
+	struct dpu_bts_disp_info *disp = &rp->disp;
+
+	params->ppc = 2;
+	params->ppc_rotator = 4;
+	params->ppc_scaler = 2;
+	params->delay_comp = 4;
+	params->delay_scaler = 2;
+	params->bus_width = 16;
+	params->bus_util_pct = 65;
+	params->rot_util_pct = 60;
+	params->afbc_rgb_util_pct = 100;
+	params->afbc_yuv_util_pct = 100;
+	params->afbc_rgb_rt_util_pct = 100;
+	params->afbc_yuv_rt_util_pct = 100;
+	params->dfs_lv_cnt = 1;
+	params->dfs_lv_khz[0] = 400000;
+
+	disp->width = 1440;
+	disp->height = 3040;
+	disp->fps = 60;
+	disp->vbp = 15;
+	disp->vfp = 8;
+	disp->vsa = 1;
+	disp->vblank_usec = 500;
+	disp->dsc_enabled = true;
+	disp->dsc_count = 2;
+	disp->slice_count = 2;
+
+	rp->event_type = BTS_REPLAY_ATOMIC_COMMIT;
+}
+
+static int bts_replay_set_param(struct bts_replay *rp, const char *arg)
+{
+	const char *eq = strchr(arg, '=');
+	size_t i;
+
+	if (!eq)
+		return -EINVAL;
+
+	for (i = 0; i < ARRAY_SIZE(bts_replay_params); i++) {
+		if (strlen(bts_replay_params[i].name) != eq - arg ||
+		    strncmp(bts_replay_params[i].name, arg, eq - arg))
+			continue;
+
+		*(u32 *)((char *)&rp->params + bts_replay_params[i].offset) =
+			strtoul(eq + 1, NULL, 0);
+		return 0;
+	}
+
+	if (!strncmp(arg, "ppc=", 4)) {
+		rp->params.ppc = strtoul(eq + 1, NULL, 0);
+		return 0;
+	}
+
+	return -EINVAL;
+}
+
+/* parses up to @max comma separated values, returns how many were found */
+static int bts_replay_parse_list(const char *arg, u32 *vals, int max)
+{
+	char *end;
+	int cnt = 0;
+
+	while (*arg && cnt < max) {
+		vals[cnt++] = strtoul(arg, &end, 0);
+		if (*end != ',')
+			break;
+		arg = end + 1;
+	}
+
+	return cnt;
+}
+
+static int bts_replay_add_frame(struct bts_replay *rp, const struct bts_replay_atomic *atomic)
+{
+	struct dpu_bts_frame *frame;
+	int i;
+
+	if (rp->frame_cnt == rp->frame_max) {
+		size_t max = rp->frame_max ? rp->frame_max * 2 : 256;
+		struct dpu_bts_frame *frames = realloc(rp->frames, max * sizeof(*frames));
+
+		if (!frames)
+			return -ENOMEM;
+		rp->frames = frames;
+		rp->frame_max = max;
+	}
+
+	frame = &rp->frames[rp->frame_cnt++];
+	memset(frame, 0, sizeof(*frame));
+	for (i = 0; i < MAX_WIN_PER_DECON; i++)
+		frame->win_config[i] = atomic->win_config[i].win;
+	frame->rcd_config = atomic->rcd_win_config.win;
+	frame->win_cnt = MAX_WIN_PER_DECON;
+
+	return 0;
+}
+
+static int bts_replay_load(struct bts_replay *rp, FILE *f)
+{
+	union {
+		struct bts_replay_log_hdr hdr;
+		u8 buf[BTS_REPLAY_MAX_RECORD];
+	} rec;
+	size_t data_size;
+	int ret;
+
+	while (fread(&rec.hdr, sizeof(rec.hdr), 1, f) == 1) {
+		if (rec.hdr.size < sizeof(rec.hdr) || rec.hdr.size > sizeof(rec)) {
+			fprintf(stderr, "bad record size %u at seq %u\n", rec.hdr.size,
+				rec.hdr.seq);
+			return -EINVAL;
+		}
+
+		data_size = rec.hdr.size - sizeof(rec.hdr);
+		if (fread(rec.buf + sizeof(rec.hdr), 1, data_size, f) != data_size) {
+			fprintf(stderr, "truncated record at seq %u\n", rec.hdr.seq);
+			return -EINVAL;
+		}
+
+		if (rec.hdr.type != rp->event_type)
+			continue;
+
+		if (data_size < sizeof(struct bts_replay_atomic)) {
+			fprintf(stderr, "short atomic commit record at seq %u\n", rec.hdr.seq);
+			return -EINVAL;
+		}
+
+		ret = bts_replay_add_frame(rp, (const void *)(rec.buf + sizeof(rec.hdr)));
+		if (ret)
+			return ret;
+	}
+
+	return ferror(f) ? -EIO : 0;
+}
+
+/* the DFS level a DISP clock vote ends up at */
+static u32 bts_replay_disp_level(const struct dpu_bts_params *params, u32 freq)
+{
+	int i;
+
+	for (i = params->dfs_lv_cnt - 1; i > 0; i--) {
+		if (freq <= params->dfs_lv_khz[i])
+			break;
+	}
+
+	return params->dfs_lv_khz[i];
+}
+
+static void bts_replay_report(const struct bts_replay *rp, bool verbose)
+{
+	u64 sum_peak = 0, sum_rt = 0, sum_avg = 0, sum_disp = 0;
+	u32 max_peak = 0, max_rt = 0, max_avg = 0, max_disp = 0;
+	struct dpu_bts_result res;
+	size_t i;
+
+	if (verbose)
+		printf("%6s %10s %10s %10s %10s %10s\n", "frame", "peak", "rt", "avg",
+		       "disp", "disp_lv");
+
+	for (i = 0; i < rp->frame_cnt; i++) {
+		dpu_bts_calc(&rp->params, &rp->disp, &rp->frames[i], &res);
+
+		if (verbose)
+			printf("%6zu %10u %10u %10u %10u %10u\n", i, res.peak, res.rt_avg_bw,
+			       res.total_bw, res.max_disp_freq,
+			       bts_replay_disp_level(&rp->params, res.max_disp_freq));
+
+		sum_peak += res.peak;
+		sum_rt += res.rt_avg_bw;
+		sum_avg += res.total_bw;
+		sum_disp += res.max_disp_freq;
+		max_peak = max(max_peak, res.peak);
+		max_rt = max(max_rt, res.rt_avg_bw);
+		max_avg = max(max_avg, res.total_bw);
+		max_disp = max(max_disp, res.max_disp_freq);
+	}
+
+	printf("%zu frames, %ux%u@%u\n", rp->frame_cnt, rp->disp.width, rp->disp.height,
+	       rp->disp.fps);
+	printf("%-8s %12s %12s\n", "", "mean", "max");
+	printf("%-8s %12llu %12u KB/s\n", "peak", sum_peak / rp->frame_cnt, max_peak);
+	printf("%-8s %12llu %12u KB/s\n", "rt", sum_rt / rp->frame_cnt, max_rt);
+	printf("%-8s %12llu %12u KB/s\n", "avg", sum_avg / rp->frame_cnt, max_avg);
+	printf("%-8s %12llu %12u kHz\n", "disp", sum_disp / rp->frame_cnt, max_disp);
+}
+
+static void bts_replay_throughput(const struct bts_replay *rp, long loops)
+{
+	struct dpu_bts_result res;
+	size_t n = 0;
+	double ns;
+
+	ns = BENCH("dpu_bts_calc() per frame", loops * (long)rp->frame_cnt,
+		   dpu_bts_calc(&rp->params, &rp->disp, &rp->frames[n++ % rp->frame_cnt],
+				&res));
+
+	printf("  %-40s %10.0f frames/s\n", "throughput", 1e9 / ns);
+}
+
+static void usage(const char *prog)
+{
+	size_t i;
+
+	fprintf(stderr,
+		"usage: %s [options] <event_raw file>\n"
+		"  -m WxH@FPS        display mode (1440x3040@60)\n"
+		"  -V                video mode panel\n"
+		"  -t VBP,VFP,VSA    vertical porches (15,8,1)\n"
+		"  -b USEC           command mode vblank (500)\n"
+		"  -d CNT,SLICES     dsc count and slices, 0 for no dsc (2,2)\n"
+		"  -i ID             decon id (0)\n"
+		"  -f KHZ,...        DISP DFS levels, highest first (400000)\n"
+		"  -c PORT,...       DPU AXI port of each dpp channel (all 0)\n"
+		"  -p NAME=VAL       DPU characteristic, one of ppc",
+		prog);
+	for (i = 0; i < ARRAY_SIZE(bts_replay_params); i++)
+		fprintf(stderr, " %s", bts_replay_params[i].name);
+	fprintf(stderr,
+		"\n"
+		"  -e TYPE           event type of atomic commit records (%u)\n"
+		"  -n LOOPS          replays of the whole log for throughput (%u)\n"
+		"  -v                report every frame\n",
+		BTS_REPLAY_ATOMIC_COMMIT, BTS_REPLAY_DEFAULT_LOOPS);
+}
+
+int main(int argc, char **argv)
+{
+	static struct bts_replay rp;
+	long loops = BTS_REPLAY_DEFAULT_LOOPS;
+	bool verbose = false;
+	u32 vals[MAX_DPP_CNT];
+	FILE *f;
+	int opt, ret, cnt;
+
+	bts_replay_init(&rp);
+
+	while ((opt = getopt(argc, argv, "m:Vt:b:d:i:f:c:p:e:n:vh")) != -1) {
+		switch (opt) {
+		case 'm':
+			if (sscanf(optarg, "%ux%u@%u", &rp.disp.width, &rp.disp.height,
+				   &rp.disp.fps) != 3) {
+				usage(argv[0]);
+				return 2;
+			}
+			break;
+		case 'V':
+			rp.disp.video_mode = true;
+			break;
+		case 't':
+			if (bts_replay_parse_list(optarg, vals, 3) != 3) {
+				usage(argv[0]);
+				return 2;
+			}
+			rp.disp.vbp = vals[0];
+			rp.disp.vfp = vals[1];
+			rp.disp.vsa = vals[2];
+			break;
+		case 'b':
+			rp.disp.vblank_usec = strtoul(optarg, NULL, 0);
+			break;
+		case 'd':
+			cnt = bts_replay_parse_list(optarg, vals, 2);
+			rp.disp.dsc_enabled = cnt && vals[0];
+			rp.disp.dsc_count = rp.disp.dsc_enabled ? vals[0] : 0;
+			rp.disp.slice_count = (rp.disp.dsc_enabled && cnt == 2) ? vals[1] : 0;
+			break;
+		case 'i':
+			rp.disp.id = strtoul(optarg, NULL, 0);
+			break;
+		case 'f':
+			rp.params.dfs_lv_cnt = bts_replay_parse_list(optarg, rp.params.dfs_lv_khz,
+								     BTS_DFS_MAX);
+			break;
+		case 'c':
+			bts_replay_parse_list(optarg, rp.params.ch_num, MAX_DPP_CNT);
+			break;
+		case 'p':
+			if (bts_replay_set_param(&rp, optarg)) {
+				fprintf(stderr, "unknown parameter %s\n", optarg);
+				usage(argv[0]);
+				return 2;
+			}
+			break;
+		case 'e':
+			rp.event_type = strtoul(optarg, NULL, 0);
+			break;
+		case 'n':
+			loops = strtol(optarg, NULL, 0);
+			break;
+		case 'v':
+			verbose = true;
+			break;
+		default:
+			usage(argv[0]);
+			return opt == 'h' ? 0 : 2;
+		}
+	}
+
+	if (optind != argc - 1 || !rp.params.dfs_lv_cnt) {
+		usage(argv[0]);
+		return 2;
+	}
+
+	f = strcmp(argv[optind], "-") ? fopen(argv[optind], "rb") : stdin;
+	if (!f) {
+		perror(argv[optind]);
+		return 1;
+	}
+
+	ret = bts_replay_load(&rp, f);
+	if (f != stdin)
+		fclose(f);
+	if (ret)
+		return 1;
+
+	if (!rp.frame_cnt) {
+		fprintf(stderr, "no atomic commit records found\n");
+		return 1;
+	}
+
+	bts_replay_report(&rp, verbose);
+	if (loops > 0)
+		bts_replay_throughput(&rp, loops);
+
+	free(rp.frames);
+
+	return 0;
+}
@@ -0,0 +1,247 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Smoke test of the gs101 CAL running on the simulated register backend:
+ * each IP gets a register file in host memory and a few accessors are
+ * checked against the registers they are expected to program.
+ */
+
+#include <stdlib.h>
+
+#include <decon_cal.h>
+#include <dpp_cal.h>
+#include <dqe_cal.h>
+#include <dsim_cal.h>
+#include <hdr_cal.h>
+
+#include "regs-decon.h"
+#include "regs-dpp.h"
+#include "regs-dqe.h"
+#include "regs-dsim.h"
+#include "regs-hdr.h"
+
+#include "host_test.h"
+
+#define SIM_REGS_SIZE	0x20000
+
+static u32 *sim_regs_alloc(void)
+{
+	u32 *regs = calloc(1, SIM_REGS_SIZE);
+
+	if (!regs) {
+		perror("calloc");
+		exit(1);
+	}
+
+	return regs;
+}
+
+#define REG(regs, offset)	((regs)[(offset) / 4])
+
+static void test_hdr(void)
+{
+	u32 *regs = sim_regs_alloc();
+	struct hdr_oetf_lut lut;
+	int i;
+
+	hdr_regs_desc_init(regs, 0x1000, "hdr", 0);
+
+	for (i = 0; i < DRM_SAMSUNG_HDR_OETF_LUT_LEN; i++) {
+		lut.posx[i] = i * 2;
+		lut.posy[i] = i * 3;
+	}
+
+	hdr_reg_set_oetf_lut(0, &lut);
+	EXPECT_EQ(REG(regs, HDR_LSI_L_OETF_POSX(0)), OETF_POSX_L(0) | OETF_POSX_H(2));
+	EXPECT_EQ(REG(regs, HDR_LSI_L_OETF_POSX(16)), OETF_POSX_L(64));
+	EXPECT(REG(regs, HDR_LSI_L_MOD_CTRL) & MOD_CTRL_OEN_MASK);
+
+	hdr_reg_set_oetf_lut(0, NULL);
+	EXPECT(!(REG(regs, HDR_LSI_L_MOD_CTRL) & MOD_CTRL_OEN_MASK));
+
+	free(regs);
+}
+
+static void test_dqe(void)
+{
+	u32 *regs = sim_regs_alloc();
+	const u32 hist_offset = regs_dqe_offset[DQE_V2].hist_offset;
+	struct histogram_roi roi = { 10, 20, 300, 400 };
+	struct histogram_bins bins;
+	int i;
+
+	dqe_regs_desc_init(regs, 0x2000, "dqe", DQE_V2, 0);
+
+	dqe_reg_set_histogram_roi(0, &roi);
+	EXPECT_EQ(REG(regs, DQE_HIST_START + hist_offset),
+		  HIST_START_X(10) | HIST_START_Y(20));
+	EXPECT_EQ(REG(regs, DQE_HIST_SIZE + hist_offset), HIST_HSIZE(300) | HIST_VSIZE(400));
+
+	for (i = 0; i < HISTOGRAM_BIN_COUNT / 2; i++)
+		REG(regs, DQE_HIST_BIN(i) + hist_offset) = ((2 * i + 1) << 16) | (2 * i);
+	dqe_reg_get_histogram_bins(0, &bins);
+	for (i = 0; i < HISTOGRAM_BIN_COUNT; i++)
+		EXPECT_EQ(bins.data[i], i);
+
+	free(regs);
+}
+
+static void test_dqe_cgc_lut(void)
+{
+	static struct cgc_lut lut;
+	const size_t full_writes = 3 * DRM_SAMSUNG_CGC_LUT_REG_CNT + 1;
+	u32 *regs = sim_regs_alloc();
+	int i;
+
+	dqe_regs_desc_init(regs, 0x2000, "dqe", DQE_V2, 0);
+	dqe_reg_invalidate_lut_shadow(0);
+
+	for (i = 0; i < DRM_SAMSUNG_CGC_LUT_REG_CNT; i++) {
+		lut.r_values[i] = i;
+		lut.g_values[i] = i + 1;
+		lut.b_values[i] = i + 2;
+	}
+	cal_sim_reset();
+	dqe_reg_set_cgc_lut(0, &lut);
+	EXPECT_EQ(cal_sim_get_write_count(), full_writes);
+	EXPECT_EQ(REG(regs, DQE_CGC_LUT_B(DRM_SAMSUNG_CGC_LUT_REG_CNT - 1)),
+		  DRM_SAMSUNG_CGC_LUT_REG_CNT + 1);
+	/* so is the next one, for the other bank of a double buffered table */
+	cal_sim_reset();
+	dqe_reg_set_cgc_lut(0, &lut);
+	EXPECT_EQ(cal_sim_get_write_count(), full_writes);
+
+	/* a changed word is written with this update and the next one, plus CGC_CON */
+	lut.g_values[100] = 0xabc;
+	cal_sim_reset();
+	dqe_reg_set_cgc_lut(0, &lut);
+	EXPECT_EQ(cal_sim_get_write_count(), 2);
+	EXPECT_EQ(REG(regs, DQE_CGC_LUT_G(100)), 0xabc);
+	cal_sim_reset();
+	dqe_reg_set_cgc_lut(0, &lut);
+	EXPECT_EQ(cal_sim_get_write_count(), 2);
+	cal_sim_reset();
+	dqe_reg_set_cgc_lut(0, &lut);
+	EXPECT_EQ(cal_sim_get_write_count(), 1);
+
+	/* after the DQE lost its context every word is written again */
+	REG(regs, DQE_CGC_LUT_R(5)) = 0;
+	dqe_reg_invalidate_lut_shadow(0);
+	cal_sim_reset();
+	dqe_reg_set_cgc_lut(0, &lut);
+	EXPECT_EQ(cal_sim_get_write_count(), full_writes);
+	EXPECT_EQ(REG(regs, DQE_CGC_LUT_R(5)), 5);
+	cal_sim_reset();
+
+	free(regs);
+}
+
+static void test_decon(void)
+{
+	u32 *regs[REGS_DECON_TYPE_MAX];
+	struct cal_sim_write log[4];
+	int i;
+
+	for (i = 0; i < REGS_DECON_TYPE_MAX; i++) {
+		regs[i] = sim_regs_alloc();
+		decon_regs_desc_init(regs[i], 0x3000 + i * SIM_REGS_SIZE, "decon", i, 0);
+	}
+
+	cal_sim_set_write_log(log, ARRAY_SIZE(log));
+	decon_reg_update_req_window(0, 1);
+	decon_reg_update_req_window(0, 3);
+	EXPECT_EQ(cal_sim_get_write_count(), 2);
+	EXPECT_EQ(REG(regs[REGS_DECON], SHD_REG_UP_REQ),
+		  SHD_REG_UP_REQ_WIN(1) | SHD_REG_UP_REQ_WIN(3));
+	EXPECT_EQ(log[1].addr, (uintptr_t)&REG(regs[REGS_DECON], SHD_REG_UP_REQ));
+	EXPECT(!log[1].protected);
+	cal_sim_set_write_log(NULL, 0);
+
+	for (i = 0; i < REGS_DECON_TYPE_MAX; i++)
+		free(regs[i]);
+}
+
+static void test_dpp(void)
+{
+	u32 *dma_regs = sim_regs_alloc();
+	u32 *dpp_regs = sim_regs_alloc();
+
+	dpp_regs_desc_init(dma_regs, 0x4000, "dma", REGS_DMA, 0);
+	dpp_regs_desc_init(dpp_regs, 0x5000, "dpp", REGS_DPP, 0);
+
+	/* pending irqs are written back to clear them */
+	REG(dma_regs, RDMA_IRQ) = 0x3;
+	EXPECT_EQ(idma_reg_get_irq_and_clear(0), 0x3);
+	EXPECT(dpp_reg_get_write_cnt(0) > 0);
+
+	free(dma_regs);
+	free(dpp_regs);
+}
+
+static void test_dsim(void)
+{
+	u32 *regs[REGS_DSIM_TYPE_MAX];
+	const u32 swrst[] = { DSIM_SWRST_FUNCRST, DSIM_SWRST_FUNCRST, 0 };
+	static struct cal_sim_write log[MAX_PL_FIFO / 4];
+	u32 payload[80];
+	size_t reads, offset, len;
+	int i;
+
+	for (i = 0; i < REGS_DSIM_TYPE_MAX; i++) {
+		regs[i] = sim_regs_alloc();
+		dsim_regs_desc_init(regs[i], 0x6000 + i * SIM_REGS_SIZE, "dsim", i, 0);
+	}
+
+	for (i = 0; i < ARRAY_SIZE(payload); i++)
+		payload[i] = 0x01010101 * (i + 1) + 0x00020406;
+
+	/* payloads reach the fifo as the bytes packed little endian, with one barrier */
+	cal_sim_set_write_log(log, ARRAY_SIZE(log));
+	for (offset = 0; offset < 4; offset++) {
+		for (len = 0; len <= 300; len++) {
+			const u8 *buf = (const u8 *)payload + offset;
+			size_t words = 0;
+
+			cal_sim_reset();
+			cal_sim_set_write_log(log, ARRAY_SIZE(log));
+			dsim_reg_wr_tx_payloads(0, buf, len);
+			EXPECT_EQ(cal_sim_get_write_count(), DIV_ROUND_UP(len, 4));
+			EXPECT_EQ(cal_sim_get_barrier_count(), 1);
+
+			for (i = 0; i < DIV_ROUND_UP(len, 4); i++) {
+				u32 word = 0;
+				size_t j;
+
+				for (j = 0; j < 4 && i * 4 + j < len; j++)
+					word |= buf[i * 4 + j] << (j * 8);
+				words += log[i].val == word &&
+					 log[i].addr == (uintptr_t)&REG(regs[REGS_DSIM_DSI], DSIM_PAYLOAD);
+			}
+			EXPECT_EQ(words, DIV_ROUND_UP(len, 4));
+		}
+	}
+	cal_sim_set_write_log(NULL, 0);
+
+	/* reset completes once hw clears the bit, after a couple of polls */
+	cal_sim_reset();
+	cal_sim_script_read(&REG(regs[REGS_DSIM_DSI], DSIM_SWRST), swrst, ARRAY_SIZE(swrst));
+	dsim_reg_function_reset(0);
+	reads = cal_sim_get_read_count();
+	EXPECT(reads >= ARRAY_SIZE(swrst));
+	EXPECT(REG(regs[REGS_DSIM_DSI], DSIM_SWRST) & DSIM_SWRST_FUNCRST);
+	cal_sim_reset();
+
+	for (i = 0; i < REGS_DSIM_TYPE_MAX; i++)
+		free(regs[i]);
+}
+
+int main(void)
+{
+	test_hdr();
+	test_dqe();
+	test_dqe_cgc_lut();
+	test_decon();
+	test_dpp();
+	test_dsim();
+
+	return host_test_done("cal_sim_test");
+}
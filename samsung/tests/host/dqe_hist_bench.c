@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Cost of the histogram bin readout that frame done used to do in hard IRQ
+ * context and that now runs on the dqe histogram worker, on the simulated
+ * registers. The frame done IRQ itself only latches a sequence number and a
+ * timestamp now, with no register access.
+ *
+ * Register reads are what the IRQ no longer does per frame. The time is the
+ * host cost of the accessors; on the device every read is an MMIO access, and
+ * the latency from frame done to the end of the readout is reported by the
+ * dpu_histogram_readout tracepoint.
+ */
+
+#include <stdlib.h>
+
+#include <dqe_cal.h>
+
+#include "host_test.h"
+
+#define SIM_REGS_SIZE	0x20000
+#define BENCH_ITERS	200000
+
+int main(void)
+{
+	u32 *regs = calloc(1, SIM_REGS_SIZE);
+	struct histogram_bins bins;
+	size_t reads;
+	double ns;
+
+	if (!regs) {
+		perror("calloc");
+		return 1;
+	}
+
+	dqe_regs_desc_init(regs, 0x2000, "dqe", DQE_V2, 0);
+
+	printf("histogram readout, %d bins:\n", HISTOGRAM_BIN_COUNT);
+
+	cal_sim_reset();
+	ns = BENCH("dqe_reg_get_histogram_bins()", BENCH_ITERS,
+		   dqe_reg_get_histogram_bins(0, &bins));
+	reads = cal_sim_get_read_count();
+
+	printf("  %-40s %10zu -> 0\n", "register reads in frame done IRQ",
+	       reads / BENCH_ITERS);
+	printf("  %-40s %10.1f -> 0\n", "readout ns in frame done IRQ", ns);
+
+	free(regs);
+
+	return 0;
+}
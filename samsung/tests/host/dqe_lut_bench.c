@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Register writes and time of DQE LUT updates on the simulated register
+ * backend, writing every LUT register against writing only the words that
+ * changed since the last update.
+ *
+ * Each update changes a number of LUT entries and programs the table twice,
+ * like exynos_cgc_update() does on a change and on the next commit. A full
+ * write is forced by invalidating the LUT images before every update.
+ */
+
+#include <stdlib.h>
+
+#include <dqe_cal.h>
+
+#include "host_test.h"
+
+#define SIM_REGS_SIZE	0x20000
+#define BENCH_ITERS	2000
+
+static struct cgc_lut cgc_lut;
+static struct drm_color_lut gamma_lut[DEGAMMA_LUT_SIZE];
+
+static void cgc_update(int changed, bool full)
+{
+	const int stride = DRM_SAMSUNG_CGC_LUT_REG_CNT / changed;
+	int i;
+
+	for (i = 0; i < changed; i++) {
+		cgc_lut.r_values[i * stride] ^= 1;
+		cgc_lut.g_values[i * stride] ^= 1;
+		cgc_lut.b_values[i * stride] ^= 1;
+	}
+
+	for (i = 0; i < 2; i++) {
+		if (full)
+			dqe_reg_invalidate_lut_shadow(0);
+		dqe_reg_set_cgc_lut(0, &cgc_lut);
+	}
+}
+
+static void gamma_update(int changed, bool full,
+			 void (*set_lut)(u32 dqe_id, const struct drm_color_lut *lut))
+{
+	const int stride = DEGAMMA_LUT_SIZE / changed;
+	int i;
+
+	for (i = 0; i < changed; i++) {
+		gamma_lut[i * stride].red ^= 1;
+		gamma_lut[i * stride].green ^= 1;
+		gamma_lut[i * stride].blue ^= 1;
+	}
+
+	for (i = 0; i < 2; i++) {
+		if (full)
+			dqe_reg_invalidate_lut_shadow(0);
+		set_lut(0, gamma_lut);
+	}
+}
+
+static void degamma_update(int changed, bool full)
+{
+	gamma_update(changed, full, dqe_reg_set_degamma_lut);
+}
+
+static void regamma_update(int changed, bool full)
+{
+	gamma_update(changed, full, dqe_reg_set_regamma_lut);
+}
+
+static void bench_lut(const char *name, int changed, int size,
+		      void (*update)(int changed, bool full))
+{
+	double full_ns, delta_ns;
+	size_t full_writes, delta_writes;
+
+	printf("%s, %d of %d entries changed:\n", name, changed, size);
+
+	cal_sim_reset();
+	full_ns = BENCH("full", BENCH_ITERS, update(changed, true));
+	full_writes = cal_sim_get_write_count();
+
+	cal_sim_reset();
+	delta_ns = BENCH("changed words", BENCH_ITERS, update(changed, false));
+	delta_writes = cal_sim_get_write_count();
+
+	printf("  %-40s %10zu -> %zu\n", "register writes/update",
+	       full_writes / BENCH_ITERS, delta_writes / BENCH_ITERS);
+	printf("  %-40s %10.2fx\n", "speedup", full_ns / delta_ns);
+}
+
+int main(void)
+{
+	u32 *regs = calloc(1, SIM_REGS_SIZE);
+	int i;
+
+	if (!regs) {
+		perror("calloc");
+		return 1;
+	}
+
+	dqe_regs_desc_init(regs, 0x2000, "dqe", DQE_V2, 0);
+
+	srand(0x5eed);
+	for (i = 0; i < DRM_SAMSUNG_CGC_LUT_REG_CNT; i++) {
+		cgc_lut.r_values[i] = rand() & 0x3fff;
+		cgc_lut.g_values[i] = rand() & 0x3fff;
+		cgc_lut.b_values[i] = rand() & 0x3fff;
+	}
+	for (i = 0; i < DEGAMMA_LUT_SIZE; i++)
+		gamma_lut[i].red = gamma_lut[i].green = gamma_lut[i].blue = i * 64;
+
+	bench_lut("CGC", 1, DRM_SAMSUNG_CGC_LUT_REG_CNT, cgc_update);
+	bench_lut("CGC", 16, DRM_SAMSUNG_CGC_LUT_REG_CNT, cgc_update);
+	bench_lut("CGC", 256, DRM_SAMSUNG_CGC_LUT_REG_CNT, cgc_update);
+	bench_lut("CGC", DRM_SAMSUNG_CGC_LUT_REG_CNT, DRM_SAMSUNG_CGC_LUT_REG_CNT, cgc_update);
+	bench_lut("degamma", 1, DEGAMMA_LUT_SIZE, degamma_update);
+	bench_lut("regamma", 1, REGAMMA_LUT_SIZE, regamma_update);
+	bench_lut("regamma", REGAMMA_LUT_SIZE, REGAMMA_LUT_SIZE, regamma_update);
+
+	free(regs);
+
+	return 0;
+}
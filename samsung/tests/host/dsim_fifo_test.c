@@ -0,0 +1,522 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Splitting of dsim command batches into packet go bursts that fit the cmd
+ * fifos, checked against a fake dsim that models the packet header and
+ * payload fifos on top of the simulated registers.
+ *
+ * Messages and command images are queued with dsim_plan_cmd_batch(), which
+ * the driver shares to decide when a batch is split, started, flushed or
+ * skipped for a packet sent on its own. The test only carries out the steps
+ * it asks for on the simulated registers.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <dsim_cal.h>
+
+#include "regs-dsim.h"
+
+#include "host_test.h"
+
+#define SIM_REGS_SIZE		0x20000
+#define SIM_LOG_SIZE		(1 << 16)
+
+#define DSI_DCS_SHORT_WRITE		0x05
+#define DSI_DCS_SHORT_WRITE_PARAM	0x15
+#define DSI_DCS_LONG_WRITE		0x39
+
+#define STREAM_MAX_PKTS		1024
+#define STREAM_MAX_PL		(64 * 1024)
+
+#define REG(regs, offset)	((regs)[(offset) / 4])
+
+/* packets in the order they went out on the link, or were queued by the test */
+struct dsi_stream {
+	u32 hdr[STREAM_MAX_PKTS];
+	u32 num_pkts;
+	u8 pl[STREAM_MAX_PL];
+	u32 pl_len;
+};
+
+/* ready-made fifo words, laid out like struct exynos_dsi_cmd_image */
+struct cmd_image {
+	u32 num_pkts;
+	u32 pl_len;
+	u32 num_words;
+	u32 words[MAX_PH_FIFO + MAX_PL_FIFO / 4];
+};
+
+static u32 *dsi_regs;
+
+static struct {
+	struct cal_sim_write log[SIM_LOG_SIZE];
+	size_t log_pos;
+	u32 ph[MAX_PH_FIFO];
+	u32 ph_cnt;
+	u32 pl[MAX_PL_FIFO / 4];
+	u32 pl_cnt;
+	u32 max_ph_cnt;
+	u32 max_pl_cnt;
+	u32 bursts;
+	int overflows;
+	int errors;
+	struct dsi_stream out;
+} fake;
+
+static struct {
+	u32 pend_ph;
+	u32 pend_pl;
+	struct dsi_stream in;
+} host;
+
+static bool dsi_is_long(u8 type)
+{
+	return type == DSI_DCS_LONG_WRITE;
+}
+
+static void stream_add(struct dsi_stream *s, u32 hdr, const u8 *pl, u32 len)
+{
+	if (s->num_pkts == STREAM_MAX_PKTS || s->pl_len + len > STREAM_MAX_PL) {
+		fake.errors++;
+		return;
+	}
+
+	s->hdr[s->num_pkts++] = hdr;
+	memcpy(s->pl + s->pl_len, pl, len);
+	s->pl_len += len;
+}
+
+/* sends out every packet in the fifos, with the payload of the long ones */
+static void fake_dsim_transmit(void)
+{
+	u32 i, pl_pos = 0;
+
+	for (i = 0; i < fake.ph_cnt; i++) {
+		const u32 hdr = fake.ph[i] & 0xffffff;
+		const u8 type = hdr & 0xff;
+		u32 wc = 0;
+
+		if (dsi_is_long(type)) {
+			wc = hdr >> 8;
+			if (pl_pos + DIV_ROUND_UP(wc, 4) > fake.pl_cnt) {
+				fake.errors++;
+				break;
+			}
+		}
+
+		stream_add(&fake.out, hdr, (const u8 *)&fake.pl[pl_pos], wc);
+		pl_pos += DIV_ROUND_UP(wc, 4);
+	}
+
+	/* payload nobody asked for */
+	if (pl_pos != fake.pl_cnt)
+		fake.errors++;
+
+	fake.ph_cnt = 0;
+	fake.pl_cnt = 0;
+}
+
+/*
+ * Runs the fake dsim over the register writes since the last call. Headers
+ * written with packet go disabled are sent at once, otherwise packets wait in
+ * the fifos until packet go is ready, which the hardware clears once the
+ * burst is sent.
+ */
+static void fake_dsim_sync(void)
+{
+	const uintptr_t pkthdr = (uintptr_t)&REG(dsi_regs, DSIM_PKTHDR);
+	const uintptr_t payload = (uintptr_t)&REG(dsi_regs, DSIM_PAYLOAD);
+	const uintptr_t cmd_config = (uintptr_t)&REG(dsi_regs, DSIM_CMD_CONFIG);
+	const size_t cnt = cal_sim_get_write_count();
+
+	if (cnt > SIM_LOG_SIZE) {
+		fake.errors++;
+		return;
+	}
+
+	for (; fake.log_pos < cnt; fake.log_pos++) {
+		const struct cal_sim_write *w = &fake.log[fake.log_pos];
+
+		if (w->addr == pkthdr) {
+			if (fake.ph_cnt == MAX_PH_FIFO) {
+				fake.overflows++;
+				continue;
+			}
+			fake.ph[fake.ph_cnt++] = w->val;
+			fake.max_ph_cnt = max(fake.max_ph_cnt, fake.ph_cnt);
+			if (!(REG(dsi_regs, DSIM_CMD_CONFIG) & DSIM_CMD_CONFIG_PKT_GO_EN))
+				fake_dsim_transmit();
+		} else if (w->addr == payload) {
+			if (fake.pl_cnt == MAX_PL_FIFO / 4) {
+				fake.overflows++;
+				continue;
+			}
+			fake.pl[fake.pl_cnt++] = w->val;
+			fake.max_pl_cnt = max(fake.max_pl_cnt, fake.pl_cnt);
+		} else if (w->addr == cmd_config) {
+			const u32 go = DSIM_CMD_CONFIG_PKT_GO_EN | DSIM_CMD_CONFIG_PKT_GO_RDY;
+
+			if ((w->val & go) == go) {
+				fake_dsim_transmit();
+				fake.bursts++;
+				REG(dsi_regs, DSIM_CMD_CONFIG) &= ~DSIM_CMD_CONFIG_PKT_GO_RDY;
+			}
+		}
+	}
+}
+
+static void fake_dsim_reset(void)
+{
+	memset(&fake.log_pos, 0, sizeof(fake) - offsetof(typeof(fake), log_pos));
+	memset(&host, 0, sizeof(host));
+	REG(dsi_regs, DSIM_CMD_CONFIG) = 0;
+	cal_sim_reset();
+	cal_sim_set_write_log(fake.log, SIM_LOG_SIZE);
+}
+
+/* sends out the pending batch, like a packet go burst of the driver */
+static void host_flush(void)
+{
+	dsim_reg_ready_packetgo(0, true);
+	fake_dsim_sync();
+	dsim_reg_enable_packetgo(0, false);
+	host.pend_ph = 0;
+	host.pend_pl = 0;
+}
+
+/* takes the steps of dsim_plan_cmd_batch() that come before writing the packets */
+static int host_queue(u32 ph, u32 pl, bool last, bool image)
+{
+	const int steps = dsim_plan_cmd_batch(host.pend_ph, host.pend_pl, ph, pl, last, image);
+
+	if (steps < 0)
+		return steps;
+
+	if (steps & DSIM_BATCH_SPLIT)
+		host_flush();
+
+	if (steps & DSIM_BATCH_SINGLE)
+		return steps;
+
+	if (steps & DSIM_BATCH_START)
+		dsim_reg_enable_packetgo(0, true);
+	host.pend_ph += ph;
+	host.pend_pl += pl;
+
+	return steps;
+}
+
+static void host_write_packet(u8 type, const u8 *buf, u32 len)
+{
+	u8 d0 = buf[0], d1 = len > 1 ? buf[1] : 0;
+
+	if (dsi_is_long(type)) {
+		dsim_reg_wr_tx_payloads(0, buf, len);
+		d0 = len & 0xff;
+		d1 = len >> 8;
+	}
+	dsim_reg_wr_tx_header(0, type, d0, d1, false);
+
+	stream_add(&host.in, type | d0 << 8 | d1 << 16, buf, dsi_is_long(type) ? len : 0);
+}
+
+/* a single message in command mode, without FORCE_BATCH */
+static int host_write_msg(u8 type, const u8 *buf, u32 len, bool last)
+{
+	const int steps = host_queue(1, dsi_is_long(type) ? ALIGN(len, 4) : 0, last, false);
+
+	if (steps < 0)
+		return steps;
+
+	host_write_packet(type, buf, len);
+	if (steps & DSIM_BATCH_SINGLE)
+		fake_dsim_sync();
+	else if (steps & DSIM_BATCH_FLUSH)
+		host_flush();
+
+	return 0;
+}
+
+/* a command image in command mode */
+static int host_write_image(const struct cmd_image *img, bool last)
+{
+	const u32 *w = img->words;
+	const int steps = host_queue(img->num_pkts, img->pl_len, last, true);
+
+	if (steps < 0)
+		return steps;
+
+	while (w < img->words + img->num_words) {
+		const u8 type = *w & 0xff;
+		const u32 wc = (*w >> 8) & 0xffff;
+
+		if (dsi_is_long(type)) {
+			host_write_packet(type, (const u8 *)(w + 1), wc);
+			w += 1 + DIV_ROUND_UP(wc, 4);
+		} else {
+			const u8 buf[] = { *w >> 8, *w >> 16 };
+
+			host_write_packet(type, buf, type == DSI_DCS_SHORT_WRITE ? 1 : 2);
+			w++;
+		}
+	}
+
+	if (steps & DSIM_BATCH_FLUSH)
+		host_flush();
+
+	return 0;
+}
+
+static void image_init(struct cmd_image *img)
+{
+	memset(img, 0, offsetof(struct cmd_image, words));
+}
+
+static void image_add(struct cmd_image *img, u8 type, const u8 *buf, u32 len)
+{
+	u32 *w = &img->words[img->num_words];
+
+	if (dsi_is_long(type)) {
+		w[0] = type | len << 8;
+		memset(w + 1, 0, ALIGN(len, 4));
+		memcpy(w + 1, buf, len);
+		img->num_words += 1 + DIV_ROUND_UP(len, 4);
+		img->pl_len += ALIGN(len, 4);
+	} else {
+		w[0] = type | buf[0] << 8 | (len > 1 ? buf[1] << 16 : 0);
+		img->num_words++;
+	}
+	img->num_pkts++;
+}
+
+static void expect_stream_sent(void)
+{
+	EXPECT_EQ(fake.overflows, 0);
+	EXPECT_EQ(fake.errors, 0);
+	EXPECT_EQ(fake.ph_cnt, 0);
+	EXPECT_EQ(fake.out.num_pkts, host.in.num_pkts);
+	EXPECT_EQ(fake.out.pl_len, host.in.pl_len);
+	EXPECT(!memcmp(fake.out.hdr, host.in.hdr, sizeof(u32) * host.in.num_pkts));
+	EXPECT(!memcmp(fake.out.pl, host.in.pl, host.in.pl_len));
+}
+
+static u8 test_buf[MAX_PL_FIFO + 4];
+
+/* the decisions themselves, at the edges of both fifos */
+static void test_plan_steps(void)
+{
+	const u32 thr = PL_FIFO_THRESHOLD;
+
+	/* a message ending an empty batch goes out on its own */
+	EXPECT_EQ(dsim_plan_cmd_batch(0, 0, 1, 0, true, false), DSIM_BATCH_SINGLE);
+	EXPECT_EQ(dsim_plan_cmd_batch(0, 0, 1, 4, false, false), DSIM_BATCH_START);
+	EXPECT_EQ(dsim_plan_cmd_batch(3, 8, 1, 4, true, false), DSIM_BATCH_FLUSH);
+
+	/* an image always goes with packet go */
+	EXPECT_EQ(dsim_plan_cmd_batch(0, 0, 4, 0, true, true), DSIM_BATCH_START | DSIM_BATCH_FLUSH);
+
+	/* a message filling the header fifo or passing the payload threshold ends the batch */
+	EXPECT_EQ(dsim_plan_cmd_batch(MAX_PH_FIFO - 2, 0, 1, 0, false, false), 0);
+	EXPECT_EQ(dsim_plan_cmd_batch(MAX_PH_FIFO - 1, 0, 1, 0, false, false), DSIM_BATCH_FLUSH);
+	EXPECT_EQ(dsim_plan_cmd_batch(1, thr - 4, 1, 4, false, false), 0);
+	EXPECT_EQ(dsim_plan_cmd_batch(1, thr - 4, 1, 8, false, false), DSIM_BATCH_FLUSH);
+	EXPECT_EQ(dsim_plan_cmd_batch(0, 0, 1, thr + 4, false, false), DSIM_BATCH_SINGLE);
+	/* images don't, they were sized by the panel */
+	EXPECT_EQ(dsim_plan_cmd_batch(1, thr - 4, 2, 8, false, true), 0);
+
+	/* packets not fitting next to the pending ones split the batch */
+	EXPECT_EQ(dsim_plan_cmd_batch(MAX_PH_FIFO, 0, 1, 0, false, false),
+		  DSIM_BATCH_SPLIT | DSIM_BATCH_START);
+	EXPECT_EQ(dsim_plan_cmd_batch(MAX_PH_FIFO, 0, 1, 0, true, false),
+		  DSIM_BATCH_SPLIT | DSIM_BATCH_SINGLE);
+	EXPECT_EQ(dsim_plan_cmd_batch(2, MAX_PL_FIFO - 4, 3, 8, true, true),
+		  DSIM_BATCH_SPLIT | DSIM_BATCH_START | DSIM_BATCH_FLUSH);
+
+	/* and packets never fitting are rejected */
+	EXPECT_EQ(dsim_plan_cmd_batch(0, 0, MAX_PH_FIFO + 1, 0, true, true), -EINVAL);
+	EXPECT_EQ(dsim_plan_cmd_batch(0, 0, 1, MAX_PL_FIFO + 4, true, false), -EINVAL);
+}
+
+static void test_ph_fifo_exact(void)
+{
+	struct cmd_image img;
+	int i;
+
+	/* a batch of messages is sent once it fills the header fifo */
+	fake_dsim_reset();
+	for (i = 0; i < MAX_PH_FIFO; i++)
+		EXPECT_EQ(host_write_msg(DSI_DCS_SHORT_WRITE_PARAM, test_buf + i, 2, false), 0);
+	EXPECT_EQ(fake.bursts, 1);
+	EXPECT_EQ(fake.max_ph_cnt, MAX_PH_FIFO);
+	EXPECT_EQ(host_write_msg(DSI_DCS_SHORT_WRITE, test_buf, 1, true), 0);
+	expect_stream_sent();
+
+	/* images filling the header fifo exactly go out in one burst */
+	fake_dsim_reset();
+	image_init(&img);
+	for (i = 0; i < MAX_PH_FIFO / 2; i++)
+		image_add(&img, DSI_DCS_SHORT_WRITE_PARAM, test_buf + i, 2);
+	EXPECT_EQ(host_write_image(&img, false), 0);
+	EXPECT_EQ(host_write_image(&img, true), 0);
+	EXPECT_EQ(fake.bursts, 1);
+	EXPECT_EQ(fake.max_ph_cnt, MAX_PH_FIFO);
+	expect_stream_sent();
+
+	/* one more packet splits the batch */
+	fake_dsim_reset();
+	EXPECT_EQ(host_write_image(&img, false), 0);
+	EXPECT_EQ(host_write_image(&img, false), 0);
+	EXPECT_EQ(host_write_msg(DSI_DCS_SHORT_WRITE, test_buf, 1, true), 0);
+	EXPECT_EQ(fake.bursts, 1);
+	EXPECT_EQ(fake.max_ph_cnt, MAX_PH_FIFO);
+	expect_stream_sent();
+}
+
+static void test_pl_fifo_exact(void)
+{
+	struct cmd_image img;
+
+	/* two halves of the payload fifo fit, with a short packet after them */
+	fake_dsim_reset();
+	image_init(&img);
+	image_add(&img, DSI_DCS_LONG_WRITE, test_buf, MAX_PL_FIFO / 2 - 1);
+	EXPECT_EQ(img.pl_len, MAX_PL_FIFO / 2);
+	EXPECT_EQ(host_write_image(&img, false), 0);
+	EXPECT_EQ(host_write_image(&img, false), 0);
+	EXPECT_EQ(host_write_msg(DSI_DCS_SHORT_WRITE, test_buf, 1, true), 0);
+	EXPECT_EQ(fake.bursts, 1);
+	EXPECT_EQ(fake.max_pl_cnt, MAX_PL_FIFO / 4);
+	expect_stream_sent();
+
+	/* a third one goes in a second burst, in order */
+	fake_dsim_reset();
+	EXPECT_EQ(host_write_image(&img, false), 0);
+	EXPECT_EQ(host_write_image(&img, false), 0);
+	EXPECT_EQ(host_write_image(&img, true), 0);
+	EXPECT_EQ(fake.bursts, 2);
+	EXPECT_EQ(fake.max_pl_cnt, MAX_PL_FIFO / 4);
+	expect_stream_sent();
+
+	/* a single packet filling the payload fifo */
+	fake_dsim_reset();
+	EXPECT_EQ(host_write_msg(DSI_DCS_LONG_WRITE, test_buf, MAX_PL_FIFO, true), 0);
+	EXPECT_EQ(fake.max_pl_cnt, MAX_PL_FIFO / 4);
+	expect_stream_sent();
+
+	/* and one that never fits is rejected without writing anything */
+	fake_dsim_reset();
+	EXPECT_EQ(host_write_msg(DSI_DCS_LONG_WRITE, test_buf, MAX_PL_FIFO + 1, true), -EINVAL);
+	image_init(&img);
+	image_add(&img, DSI_DCS_LONG_WRITE, test_buf, MAX_PL_FIFO + 1);
+	EXPECT_EQ(host_write_image(&img, true), -EINVAL);
+	EXPECT_EQ(cal_sim_get_write_count(), 0);
+}
+
+/* the fewest bursts a sequence of images fits in, cutting only where needed */
+static u32 greedy_bursts(const struct cmd_image *imgs, int cnt)
+{
+	u32 ph = 0, pl = 0, bursts = 1;
+	int i;
+
+	for (i = 0; i < cnt; i++) {
+		if (ph + imgs[i].num_pkts > MAX_PH_FIFO || pl + imgs[i].pl_len > MAX_PL_FIFO) {
+			bursts++;
+			ph = 0;
+			pl = 0;
+		}
+		ph += imgs[i].num_pkts;
+		pl += imgs[i].pl_len;
+	}
+
+	return bursts;
+}
+
+#define RANDOM_BATCHES	2000
+#define RANDOM_IMAGES	8
+
+static void test_random_batches(void)
+{
+	static struct cmd_image imgs[RANDOM_IMAGES];
+	int n, i, j, cnt, mismatches = 0;
+
+	srand(0x5eed);
+	for (i = 0; i < ARRAY_SIZE(test_buf); i++)
+		test_buf[i] = rand();
+
+	/* images as the panel compiles them, up to 31 packets and 75% of the payload fifo */
+	for (n = 0; n < RANDOM_BATCHES; n++) {
+		fake_dsim_reset();
+		cnt = 1 + rand() % RANDOM_IMAGES;
+		for (i = 0; i < RANDOM_IMAGES; i++) {
+			const u32 num_pkts = 1 + rand() % (MAX_PH_FIFO - 1);
+
+			image_init(&imgs[i]);
+			for (j = 0; j < num_pkts; j++) {
+				const u32 len = 1 + rand() % 200;
+
+				if (imgs[i].pl_len + ALIGN(len, 4) > PL_FIFO_THRESHOLD)
+					break;
+				image_add(&imgs[i], len > 2 ? DSI_DCS_LONG_WRITE :
+					  len == 2 ? DSI_DCS_SHORT_WRITE_PARAM :
+					  DSI_DCS_SHORT_WRITE, test_buf + rand() % 256, len);
+			}
+		}
+		for (i = 0; i < cnt; i++)
+			EXPECT_EQ(host_write_image(&imgs[i], i == cnt - 1), 0);
+
+		expect_stream_sent();
+		if (fake.bursts != greedy_bursts(imgs, cnt))
+			mismatches++;
+	}
+	EXPECT_EQ(mismatches, 0);
+
+	/* messages and images mixed */
+	for (n = 0; n < RANDOM_BATCHES; n++) {
+		fake_dsim_reset();
+		cnt = 1 + rand() % 64;
+		for (i = 0; i < cnt; i++) {
+			const bool last = i == cnt - 1;
+
+			if (rand() % 4) {
+				const u32 len = 1 + rand() % (MAX_PL_FIFO / 2);
+
+				EXPECT_EQ(host_write_msg(len > 2 ? DSI_DCS_LONG_WRITE :
+							 len == 2 ? DSI_DCS_SHORT_WRITE_PARAM :
+							 DSI_DCS_SHORT_WRITE,
+							 test_buf + rand() % 256, len, last), 0);
+			} else {
+				EXPECT_EQ(host_write_image(&imgs[rand() % RANDOM_IMAGES], last), 0);
+			}
+		}
+
+		expect_stream_sent();
+	}
+}
+
+int main(void)
+{
+	u32 *regs[REGS_DSIM_TYPE_MAX];
+	int i;
+
+	for (i = 0; i < REGS_DSIM_TYPE_MAX; i++) {
+		regs[i] = calloc(1, SIM_REGS_SIZE);
+		if (!regs[i]) {
+			perror("calloc");
+			return 1;
+		}
+		dsim_regs_desc_init(regs[i], 0x6000 + i * SIM_REGS_SIZE, "dsim", i, 0);
+	}
+	dsi_regs = regs[REGS_DSIM_DSI];
+
+	test_plan_steps();
+	test_ph_fifo_exact();
+	test_pl_fifo_exact();
+	test_random_batches();
+
+	cal_sim_set_write_log(NULL, 0);
+	for (i = 0; i < REGS_DSIM_TYPE_MAX; i++)
+		free(regs[i]);
+
+	return host_test_done("dsim_fifo_test");
+}
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Cost of pushing long packet payloads into the dsim payload fifo on the
+ * simulated registers: dsim_reg_wr_tx_payloads() against the byte loop
+ * dsim_write_payload() had before, which wrote every word with writel().
+ */
+
+#include <stdlib.h>
+
+#include <dsim_cal.h>
+
+#include "host_test.h"
+
+#define SIM_REGS_SIZE	0x20000
+#define BENCH_ITERS	20000
+
+/* the loop dsim_write_payload() used, without its per word debug print */
+static void dsim_write_payload_bytes(u32 id, const u8 *buf, size_t len)
+{
+	const u8 *p = buf;
+	const u8 *end = buf + len;
+	u32 payload;
+
+	while (p < end) {
+		size_t pkt_size = min_t(size_t, 4, end - p);
+
+		if (pkt_size >= 4)
+			payload = p[0] | p[1] << 8 | p[2] << 16 | p[3] << 24;
+		else if (pkt_size == 3)
+			payload = p[0] | p[1] << 8 | p[2] << 16;
+		else if (pkt_size == 2)
+			payload = p[0] | p[1] << 8;
+		else if (pkt_size == 1)
+			payload = p[0];
+
+		dsim_reg_wr_tx_payload(id, payload);
+
+		p += pkt_size;
+	}
+}
+
+static u32 payload_buf[MAX_PL_FIFO / 4 + 1];
+
+static void bench_payload(size_t len, size_t offset)
+{
+	const u8 *buf = (const u8 *)payload_buf + offset;
+	double bytes_ns, burst_ns;
+	size_t bytes_barriers, burst_barriers;
+
+	printf("%zu bytes, %s:\n", len, offset ? "unaligned" : "word aligned");
+
+	cal_sim_reset();
+	bytes_ns = BENCH("byte loop", BENCH_ITERS, dsim_write_payload_bytes(0, buf, len));
+	bytes_barriers = cal_sim_get_barrier_count();
+
+	cal_sim_reset();
+	burst_ns = BENCH("dsim_reg_wr_tx_payloads()", BENCH_ITERS,
+			 dsim_reg_wr_tx_payloads(0, buf, len));
+	burst_barriers = cal_sim_get_barrier_count();
+
+	printf("  %-40s %10zu -> %zu\n", "write barriers/payload",
+	       bytes_barriers / BENCH_ITERS, burst_barriers / BENCH_ITERS);
+	printf("  %-40s %10.2fx\n", "speedup", bytes_ns / burst_ns);
+}
+
+int main(void)
+{
+	static const size_t lens[] = { 8, 33, 128, 300, 1024, MAX_PL_FIFO - 1 };
+	u32 *regs[REGS_DSIM_TYPE_MAX];
+	int i;
+
+	for (i = 0; i < REGS_DSIM_TYPE_MAX; i++) {
+		regs[i] = calloc(1, SIM_REGS_SIZE);
+		if (!regs[i]) {
+			perror("calloc");
+			return 1;
+		}
+		dsim_regs_desc_init(regs[i], 0x6000 + i * SIM_REGS_SIZE, "dsim", i, 0);
+	}
+
+	srand(0x5eed);
+	for (i = 0; i < ARRAY_SIZE(payload_buf); i++)
+		payload_buf[i] = rand();
+
+	for (i = 0; i < ARRAY_SIZE(lens); i++) {
+		bench_payload(lens[i], 0);
+		bench_payload(lens[i], 1);
+	}
+
+	for (i = 0; i < REGS_DSIM_TYPE_MAX; i++)
+		free(regs[i]);
+
+	return 0;
+}
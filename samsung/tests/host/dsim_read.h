@@ -0,0 +1,239 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * A fake panel answering dsim read requests on the simulated registers, and
+ * reads driven against it through the CAL calls exynos_drm_dsim.c makes:
+ * dsim_reg_wr_rx_request() builds the packets up to the bus turnaround and
+ * dsim_reg_rd_rx_packet() takes the response apart. Single reads go one
+ * transfer each like mipi_dsi_dcs_read(), batches share one transfer and the
+ * maximum return packet size like dsim_read_batch().
+ *
+ * The panel looks at the packet headers written since the last request. A set
+ * maximum return packet size header limits the responses that follow, a dcs
+ * read with bus turnaround is answered through scripted reads of the rx fifo.
+ * Responses come from a register file per dcs command, so a truncated or
+ * misrouted response shows up in the data read back.
+ */
+#ifndef __DSIM_READ_H__
+#define __DSIM_READ_H__
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <dsim_cal.h>
+#include <video/mipi_display.h>
+
+#include "regs-dsim.h"
+
+#define SIM_REGS_SIZE		0x20000
+#define SIM_LOG_SIZE		4096
+
+#define PANEL_REG_LEN		MAX_RX_FIFO
+
+#define REG(regs, offset)	((regs)[(offset) / 4])
+
+/* what a sequence of reads cost on the link */
+struct dsi_link_stats {
+	u32 transfers;		/* dsim_transfer() calls, each takes pm and cmd_lock */
+	u32 tx_pkts;
+	u32 turnarounds;
+	u32 tx_bytes;
+	u32 rx_bytes;
+};
+
+/* struct exynos_dsi_read for dcs reads */
+struct host_read {
+	u8 cmd;
+	u8 *rx_buf;
+	size_t rx_len;
+	ssize_t ret;
+};
+
+static u32 *dsim_regs[REGS_DSIM_TYPE_MAX];
+
+static struct {
+	struct cal_sim_write log[SIM_LOG_SIZE];
+	size_t log_pos;
+	u8 regs[256][PANEL_REG_LEN];
+	int mute_cmd;		/* dcs command left unanswered, -1 for none */
+	u16 max_ret;
+	u32 rx[1 + DIV_ROUND_UP(PANEL_REG_LEN, 4)];
+	bool responded;
+	struct dsi_link_stats stats;
+	int errors;
+} panel;
+
+static void fake_panel_respond(u8 cmd)
+{
+	const u32 len = clamp(panel.max_ret, 1, PANEL_REG_LEN);
+	const u8 *p = panel.regs[cmd];
+	u32 i, n = 0;
+
+	if (cmd == panel.mute_cmd)
+		return;
+
+	if (len <= 2) {
+		panel.rx[n++] = (len == 2 ? MIPI_DSI_RX_DCS_SHORT_READ_RESPONSE_2BYTE | p[1] << 16 :
+			MIPI_DSI_RX_DCS_SHORT_READ_RESPONSE_1BYTE) | p[0] << 8;
+		panel.stats.rx_bytes += 4;
+	} else {
+		panel.rx[n++] = MIPI_DSI_RX_DCS_LONG_READ_RESPONSE | len << 8;
+		for (i = 0; i < len; i += 4) {
+			u32 word = 0, j;
+
+			for (j = 0; j < 4 && i + j < len; j++)
+				word |= p[i + j] << (j * 8);
+			panel.rx[n++] = word;
+		}
+		/* header, payload and checksum */
+		panel.stats.rx_bytes += 4 + len + 2;
+	}
+
+	if (cal_sim_script_read(&REG(dsim_regs[REGS_DSIM_DSI], DSIM_RXFIFO), panel.rx, n))
+		panel.errors++;
+	panel.responded = true;
+}
+
+/* lets the panel see the packet headers written since the last call */
+static void fake_panel_sync(void)
+{
+	const uintptr_t pkthdr = (uintptr_t)&REG(dsim_regs[REGS_DSIM_DSI], DSIM_PKTHDR);
+	const size_t cnt = cal_sim_get_write_count();
+
+	if (cnt > SIM_LOG_SIZE) {
+		panel.errors++;
+		return;
+	}
+
+	for (; panel.log_pos < cnt; panel.log_pos++) {
+		const struct cal_sim_write *w = &panel.log[panel.log_pos];
+		const u8 type = w->val & 0xff;
+		const u16 data = (w->val >> 8) & 0xffff;
+
+		if (w->addr != pkthdr)
+			continue;
+
+		panel.stats.tx_pkts++;
+		panel.stats.tx_bytes += 4;
+
+		if (type == MIPI_DSI_SET_MAXIMUM_RETURN_PACKET_SIZE) {
+			panel.max_ret = data;
+		} else if (w->val & DSIM_PKTHDR_BTA_TYPE(1)) {
+			panel.stats.turnarounds++;
+			if (type == MIPI_DSI_DCS_READ)
+				fake_panel_respond(data & 0xff);
+			else
+				panel.errors++;
+		}
+	}
+}
+
+/* power on state: the panel returns a single byte until told otherwise */
+static void fake_panel_reset(void)
+{
+	panel.log_pos = 0;
+	panel.mute_cmd = -1;
+	panel.max_ret = 1;
+	panel.responded = false;
+	memset(&panel.stats, 0, sizeof(panel.stats));
+	panel.errors = 0;
+	REG(dsim_regs[REGS_DSIM_DSI], DSIM_FIFOCTRL) = DSIM_FIFOCTRL_EMPTY_RX;
+	cal_sim_reset();
+	cal_sim_set_write_log(panel.log, SIM_LOG_SIZE);
+}
+
+static void fake_panel_init(void)
+{
+	int i, j;
+
+	for (i = 0; i < REGS_DSIM_TYPE_MAX; i++) {
+		dsim_regs[i] = calloc(1, SIM_REGS_SIZE);
+		if (!dsim_regs[i]) {
+			perror("calloc");
+			exit(1);
+		}
+		dsim_regs_desc_init(dsim_regs[i], 0x6000 + i * SIM_REGS_SIZE, "dsim", i, 0);
+	}
+
+	for (i = 0; i < ARRAY_SIZE(panel.regs); i++)
+		for (j = 0; j < PANEL_REG_LEN; j++)
+			panel.regs[i][j] = i * 31 + j * 7 + 1;
+
+	fake_panel_reset();
+}
+
+static void fake_panel_exit(void)
+{
+	int i;
+
+	cal_sim_set_write_log(NULL, 0);
+	cal_sim_reset();
+	for (i = 0; i < REGS_DSIM_TYPE_MAX; i++)
+		free(dsim_regs[i]);
+}
+
+/*
+ * A dcs read, the ph fifo drains at once and rd_comp completes if the panel
+ * responded. @max_ret is NULL outside of a batch.
+ */
+static ssize_t host_read(u8 cmd, u8 *rx_buf, size_t rx_len, u16 *max_ret)
+{
+	ssize_t ret;
+
+	if (rx_len > MAX_RX_FIFO)
+		return -EINVAL;
+
+	dsim_reg_clear_int(0, DSIM_INTSRC_RX_DATA_DONE);
+	dsim_reg_clear_int(0, DSIM_INTSRC_SFR_PH_FIFO_EMPTY);
+
+	panel.responded = false;
+	dsim_reg_wr_rx_request(0, MIPI_DSI_DCS_READ, cmd, 0, rx_len, max_ret);
+	fake_panel_sync();
+	if (!panel.responded)
+		return -ETIMEDOUT;
+
+	ret = dsim_reg_rd_rx_packet(0, rx_buf, rx_len);
+
+	if (!dsim_reg_rx_fifo_is_empty(0))
+		panel.errors++;
+
+	return ret;
+}
+
+/* mipi_dsi_dcs_read(), a transfer of its own */
+static ssize_t host_dcs_read(u8 cmd, u8 *rx_buf, size_t rx_len)
+{
+	panel.stats.transfers++;
+
+	return host_read(cmd, rx_buf, rx_len, NULL);
+}
+
+/* a batch the way dsim_read_batch() runs it, reads stop at the first failure */
+static int host_read_batch(struct host_read *reads, u32 num_reads)
+{
+	u16 max_ret = 0;
+	int ret = 0;
+	u32 i;
+
+	panel.stats.transfers++;
+
+	for (i = 0; i < num_reads; i++) {
+		struct host_read *r = &reads[i];
+
+		if (ret < 0) {
+			r->ret = -ECANCELED;
+			continue;
+		}
+
+		r->ret = host_read(r->cmd, r->rx_buf, r->rx_len, &max_ret);
+		if (r->ret < 0) {
+			ret = r->ret;
+			continue;
+		}
+
+		ret++;
+	}
+
+	return ret;
+}
+
+#endif /* __DSIM_READ_H__ */
@@ -0,0 +1,212 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Dsim reads through the CAL against a fake panel: every read of a batch gets
+ * the response to its own command at its own length, the maximum return
+ * packet size is only sent when the length changes, and a failed read cancels
+ * the rest of the batch without anything more going out.
+ */
+
+#include "dsim_read.h"
+
+#include "host_test.h"
+
+#define MAX_READS	64
+
+static u8 rx_bufs[MAX_READS][PANEL_REG_LEN];
+
+static void setup_reads(struct host_read *reads, const u8 *cmds, const size_t *lens,
+			u32 num_reads)
+{
+	u32 i;
+
+	memset(rx_bufs, 0, sizeof(rx_bufs));
+	for (i = 0; i < num_reads; i++) {
+		reads[i] = (struct host_read) {
+			.cmd = cmds[i],
+			.rx_buf = rx_bufs[i],
+			.rx_len = lens[i],
+			.ret = 0,
+		};
+	}
+}
+
+/* reads that succeeded hold exactly their panel register, nothing past it */
+static int check_reads(const struct host_read *reads, u32 num_reads)
+{
+	int bad = 0;
+	u32 i, j;
+
+	for (i = 0; i < num_reads; i++) {
+		const struct host_read *r = &reads[i];
+
+		if (r->ret < 0)
+			continue;
+		if (r->ret != r->rx_len ||
+		    memcmp(r->rx_buf, panel.regs[r->cmd], r->rx_len))
+			bad++;
+		for (j = r->rx_len; j < PANEL_REG_LEN; j++)
+			bad += r->rx_buf[j] != 0;
+	}
+
+	return bad;
+}
+
+static void test_single_reads(void)
+{
+	static const size_t lens[] = { 1, 2, 3, 4, 5, 47, 135, 180, MAX_RX_FIFO };
+	u8 buf[PANEL_REG_LEN];
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(lens); i++) {
+		fake_panel_reset();
+		memset(buf, 0, sizeof(buf));
+		EXPECT_EQ(host_dcs_read(0xc8, buf, lens[i]), lens[i]);
+		EXPECT(!memcmp(buf, panel.regs[0xc8], lens[i]));
+		EXPECT_EQ(panel.stats.tx_pkts, 2);
+		EXPECT_EQ(panel.errors, 0);
+	}
+
+	fake_panel_reset();
+	EXPECT_EQ(host_dcs_read(0xc8, buf, MAX_RX_FIFO + 1), -EINVAL);
+	EXPECT_EQ(cal_sim_get_write_count(), 0);
+}
+
+/* the s6e3hc2 otp gamma tables, all of different lengths */
+static void test_gamma_otp_batch(void)
+{
+	static const u8 cmds[] = { 0xc8, 0xc9, 0xb3 };
+	static const size_t lens[] = { 45 * 3, 45 * 4, 2 + 45 };
+	struct host_read reads[ARRAY_SIZE(cmds)];
+
+	fake_panel_reset();
+	setup_reads(reads, cmds, lens, ARRAY_SIZE(cmds));
+	EXPECT_EQ(host_read_batch(reads, ARRAY_SIZE(cmds)), ARRAY_SIZE(cmds));
+	EXPECT_EQ(check_reads(reads, ARRAY_SIZE(cmds)), 0);
+	EXPECT_EQ(panel.stats.transfers, 1);
+	EXPECT_EQ(panel.stats.tx_pkts, 2 * ARRAY_SIZE(cmds));
+	EXPECT_EQ(panel.errors, 0);
+}
+
+/* reads of one length, like id registers, share one maximum return packet size */
+static void test_same_len_batch(void)
+{
+	u8 cmds[16];
+	size_t lens[16];
+	struct host_read reads[16];
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(cmds); i++) {
+		cmds[i] = 0xa1 + i;
+		lens[i] = 3;
+	}
+
+	fake_panel_reset();
+	setup_reads(reads, cmds, lens, ARRAY_SIZE(cmds));
+	EXPECT_EQ(host_read_batch(reads, ARRAY_SIZE(cmds)), ARRAY_SIZE(cmds));
+	EXPECT_EQ(check_reads(reads, ARRAY_SIZE(cmds)), 0);
+	EXPECT_EQ(panel.stats.tx_pkts, 1 + ARRAY_SIZE(cmds));
+	EXPECT_EQ(panel.stats.turnarounds, ARRAY_SIZE(cmds));
+	EXPECT_EQ(panel.errors, 0);
+}
+
+static void test_random_batches(void)
+{
+	u8 cmds[MAX_READS];
+	size_t lens[MAX_READS];
+	struct host_read reads[MAX_READS];
+	int iter, bad = 0;
+
+	srand(0x5eed);
+	for (iter = 0; iter < 2000; iter++) {
+		const u32 num_reads = 1 + rand() % MAX_READS;
+		u32 i, len_changes = 0;
+
+		for (i = 0; i < num_reads; i++) {
+			cmds[i] = rand();
+			/* runs of equal lengths, sometimes long responses */
+			if (i && rand() % 3)
+				lens[i] = lens[i - 1];
+			else
+				lens[i] = rand() % 4 ? 1 + rand() % 4 : 1 + rand() % MAX_RX_FIFO;
+			len_changes += !i || lens[i] != lens[i - 1];
+		}
+
+		fake_panel_reset();
+		setup_reads(reads, cmds, lens, num_reads);
+		bad += host_read_batch(reads, num_reads) != num_reads;
+		bad += check_reads(reads, num_reads);
+		bad += panel.stats.tx_pkts != len_changes + num_reads;
+		bad += panel.errors;
+	}
+	EXPECT_EQ(bad, 0);
+}
+
+/* responses other than read responses, as dsim_reg_rd_rx_packet() sees them */
+static void test_rx_packets(void)
+{
+	u32 *rx_fifo = &REG(dsim_regs[REGS_DSIM_DSI], DSIM_RXFIFO);
+	const u32 ack = MIPI_DSI_RX_ACKNOWLEDGE_AND_ERROR_REPORT;
+	const u32 ecc_err = ack | MIPI_DSI_ERR_ECC_MULTI_BIT << 8;
+	const u32 eot = MIPI_DSI_RX_END_OF_TRANSMISSION;
+	const u32 bad = 0x3f;
+	u8 buf[4] = { 0 };
+
+	fake_panel_reset();
+	cal_sim_script_read(rx_fifo, &ack, 1);
+	EXPECT_EQ(dsim_reg_rd_rx_packet(0, buf, sizeof(buf)), 0);
+	cal_sim_script_read(rx_fifo, &ecc_err, 1);
+	EXPECT_EQ(dsim_reg_rd_rx_packet(0, buf, sizeof(buf)), -EINVAL);
+	cal_sim_script_read(rx_fifo, &eot, 1);
+	EXPECT_EQ(dsim_reg_rd_rx_packet(0, buf, sizeof(buf)), 0);
+	cal_sim_script_read(rx_fifo, &bad, 1);
+	EXPECT_EQ(dsim_reg_rd_rx_packet(0, buf, sizeof(buf)), -EBUSY);
+	EXPECT_EQ(cal_sim_get_read_count(), 4);
+
+	/* nothing of them lands in the buffer */
+	EXPECT_EQ(buf[0] | buf[1] | buf[2] | buf[3], 0);
+}
+
+/* a read the panel never answers times out and the remaining ones are cancelled */
+static void test_failed_read(void)
+{
+	static const u8 cmds[] = { 0xda, 0xdb, 0xdc, 0xdd, 0xde };
+	static const size_t lens[] = { 1, 1, 4, 4, 1 };
+	struct host_read reads[ARRAY_SIZE(cmds)];
+
+	fake_panel_reset();
+	panel.mute_cmd = 0xdc;
+	setup_reads(reads, cmds, lens, ARRAY_SIZE(cmds));
+	EXPECT_EQ(host_read_batch(reads, ARRAY_SIZE(cmds)), -ETIMEDOUT);
+	EXPECT_EQ(reads[0].ret, 1);
+	EXPECT_EQ(reads[1].ret, 1);
+	EXPECT_EQ(reads[2].ret, -ETIMEDOUT);
+	EXPECT_EQ(reads[3].ret, -ECANCELED);
+	EXPECT_EQ(reads[4].ret, -ECANCELED);
+	EXPECT_EQ(check_reads(reads, ARRAY_SIZE(cmds)), 0);
+	/* nothing is sent after the failed read */
+	fake_panel_sync();
+	EXPECT_EQ(panel.stats.tx_pkts, 5);
+
+	/* once the panel answers again so does the next batch */
+	panel.mute_cmd = -1;
+	setup_reads(reads, cmds + 3, lens + 3, 2);
+	EXPECT_EQ(host_read_batch(reads, 2), 2);
+	EXPECT_EQ(check_reads(reads, 2), 0);
+	EXPECT_EQ(panel.errors, 0);
+}
+
+int main(void)
+{
+	fake_panel_init();
+
+	test_single_reads();
+	test_gamma_otp_batch();
+	test_same_len_batch();
+	test_random_batches();
+	test_rx_packets();
+	test_failed_read();
+
+	fake_panel_exit();
+
+	return host_test_done("dsim_read_test");
+}
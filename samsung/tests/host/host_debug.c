@@ -0,0 +1,26 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Host side replacements for the driver debug helpers the CAL calls into.
+ */
+
+#include <cal_config.h>
+#include <drm/drm_print.h>
+
+#define ROW_LEN		32
+
+/* same layout as the driver's dump: offset prefix, then 32-bit words */
+void dpu_print_hex_dump(struct drm_printer *p, void __iomem *regs,
+			const void *buf, size_t len)
+{
+	size_t i, j;
+
+	for (i = 0; i < len; i += ROW_LEN) {
+		const u32 *ptr = (const u32 *)((const u8 *)buf + i);
+		const size_t words = (len - i < ROW_LEN ? len - i : ROW_LEN) / 4;
+
+		drm_printf(p, "[%08lX] ", (unsigned long)((const u8 *)buf - (u8 *)regs + i));
+		for (j = 0; j < words; j++)
+			drm_printf(p, "%08x ", ptr[j]);
+		drm_printf(p, "\n");
+	}
+}
@@ -0,0 +1,57 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Minimal check and benchmark helpers for the host programs.
+ */
+#ifndef __HOST_TEST_H__
+#define __HOST_TEST_H__
+
+#include <stdio.h>
+#include <linux/ktime.h>
+
+static int host_test_failures;
+
+#define EXPECT(cond)							\
+	do {								\
+		if (!(cond)) {						\
+			fprintf(stderr, "%s:%d: %s: expected %s\n",	\
+				__FILE__, __LINE__, __func__, #cond);	\
+			host_test_failures++;				\
+		}							\
+	} while (0)
+
+#define EXPECT_EQ(a, b)							\
+	do {								\
+		unsigned long long __a = (a), __b = (b);		\
+		if (__a != __b) {					\
+			fprintf(stderr, "%s:%d: %s: %s == %s (0x%llx != 0x%llx)\n", \
+				__FILE__, __LINE__, __func__, #a, #b,	\
+				__a, __b);				\
+			host_test_failures++;				\
+		}							\
+	} while (0)
+
+/* returns the exit status of the test program */
+static inline int host_test_done(const char *name)
+{
+	printf("%s: %s\n", name, host_test_failures ? "FAIL" : "PASS");
+
+	return host_test_failures ? 1 : 0;
+}
+
+/* runs @body @iters times and reports the mean time per iteration */
+#define BENCH(name, iters, body)					\
+	({								\
+		const ktime_t __start = ktime_get();			\
+		long __i;						\
+		s64 __ns;						\
+									\
+		for (__i = 0; __i < (iters); __i++) {			\
+			body;						\
+		}							\
+		__ns = ktime_to_ns(ktime_sub(ktime_get(), __start));	\
+		printf("  %-40s %10.1f ns/iter\n", name,		\
+		       (double)__ns / (iters));				\
+		(double)__ns / (iters);					\
+	})
+
+#endif /* __HOST_TEST_H__ */
@@ -0,0 +1,14 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Host build stub: full barriers for everything.
+ */
+#ifndef __HOST_ASM_BARRIER_H__
+#define __HOST_ASM_BARRIER_H__
+
+#define mb()		__sync_synchronize()
+#define rmb()		__sync_synchronize()
+#ifndef wmb
+#define wmb()		__sync_synchronize()
+#endif
+
+#endif /* __HOST_ASM_BARRIER_H__ */
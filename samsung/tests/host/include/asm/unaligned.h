@@ -0,0 +1,17 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Host build stub: byte wise little endian loads, whatever the host order.
+ */
+#ifndef __HOST_ASM_UNALIGNED_H__
+#define __HOST_ASM_UNALIGNED_H__
+
+#include <linux/types.h>
+
+static inline u32 get_unaligned_le32(const void *p)
+{
+	const u8 *b = p;
+
+	return b[0] | b[1] << 8 | b[2] << 16 | (u32)b[3] << 24;
+}
+
+#endif /* __HOST_ASM_UNALIGNED_H__ */
@@ -0,0 +1,40 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * Host build stub: the fourcc codes of the formats supported by the DPU.
+ */
+#ifndef __HOST_DRM_FOURCC_H__
+#define __HOST_DRM_FOURCC_H__
+
+#include <linux/types.h>
+
+#define fourcc_code(a, b, c, d)	((__u32)(a) | ((__u32)(b) << 8) | \
+				 ((__u32)(c) << 16) | ((__u32)(d) << 24))
+
+#define DRM_FORMAT_C8		fourcc_code('C', '8', ' ', ' ')
+
+#define DRM_FORMAT_RGB565	fourcc_code('R', 'G', '1', '6')
+#define DRM_FORMAT_BGR565	fourcc_code('B', 'G', '1', '6')
+
+#define DRM_FORMAT_XRGB8888	fourcc_code('X', 'R', '2', '4')
+#define DRM_FORMAT_XBGR8888	fourcc_code('X', 'B', '2', '4')
+#define DRM_FORMAT_RGBX8888	fourcc_code('R', 'X', '2', '4')
+#define DRM_FORMAT_BGRX8888	fourcc_code('B', 'X', '2', '4')
+#define DRM_FORMAT_ARGB8888	fourcc_code('A', 'R', '2', '4')
+#define DRM_FORMAT_ABGR8888	fourcc_code('A', 'B', '2', '4')
+#define DRM_FORMAT_RGBA8888	fourcc_code('R', 'A', '2', '4')
+#define DRM_FORMAT_BGRA8888	fourcc_code('B', 'A', '2', '4')
+
+#define DRM_FORMAT_ARGB2101010	fourcc_code('A', 'R', '3', '0')
+#define DRM_FORMAT_ABGR2101010	fourcc_code('A', 'B', '3', '0')
+#define DRM_FORMAT_RGBA1010102	fourcc_code('R', 'A', '3', '0')
+#define DRM_FORMAT_BGRA1010102	fourcc_code('B', 'A', '3', '0')
+
+#define DRM_FORMAT_Y010		fourcc_code('Y', '0', '1', '0')
+#define DRM_FORMAT_YUV420_8BIT	fourcc_code('Y', 'U', '0', '8')
+#define DRM_FORMAT_YUV420_10BIT	fourcc_code('Y', 'U', '1', '0')
+
+#define DRM_FORMAT_NV12		fourcc_code('N', 'V', '1', '2')
+#define DRM_FORMAT_NV21		fourcc_code('N', 'V', '2', '1')
+#define DRM_FORMAT_P010		fourcc_code('P', '0', '1', '0')
+
+#endif /* __HOST_DRM_FOURCC_H__ */
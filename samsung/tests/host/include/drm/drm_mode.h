@@ -0,0 +1,17 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * Host build stub: drm_color_lut from the drm uapi.
+ */
+#ifndef __HOST_DRM_MODE_H__
+#define __HOST_DRM_MODE_H__
+
+#include <linux/types.h>
+
+struct drm_color_lut {
+	__u16 red;
+	__u16 green;
+	__u16 blue;
+	__u16 reserved;
+};
+
+#endif /* __HOST_DRM_MODE_H__ */
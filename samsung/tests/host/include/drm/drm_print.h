@@ -0,0 +1,23 @@
+/* SPDX-License-Identifier: MIT */
+/*
+ * Host build stub: drm_printf() goes to the stream behind the printer, or
+ * stdout when there is none.
+ */
+#ifndef __HOST_DRM_PRINT_H__
+#define __HOST_DRM_PRINT_H__
+
+#include <stdio.h>
+
+struct drm_printer {
+	FILE *f;
+};
+
+#define drm_printf(p, fmt, ...)	\
+	fprintf(((p) && (p)->f) ? (p)->f : stdout, fmt, ##__VA_ARGS__)
+
+#define DRM_DEBUG(fmt, ...)	do { } while (0)
+#define DRM_INFO(fmt, ...)	printf(fmt, ##__VA_ARGS__)
+#define DRM_WARN(fmt, ...)	fprintf(stderr, fmt, ##__VA_ARGS__)
+#define DRM_ERROR(fmt, ...)	fprintf(stderr, fmt, ##__VA_ARGS__)
+
+#endif /* __HOST_DRM_PRINT_H__ */
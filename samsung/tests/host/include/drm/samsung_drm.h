@@ -0,0 +1,96 @@
+/* SPDX-License-Identifier: GPL-2.0-only WITH Linux-syscall-note */
+/*
+ * Host build stub: the color and histogram structures of the samsung_drm
+ * uapi that the CAL programs into registers.
+ */
+#ifndef __HOST_SAMSUNG_DRM_H__
+#define __HOST_SAMSUNG_DRM_H__
+
+#include <linux/types.h>
+
+#define DRM_SAMSUNG_HDR_EOTF_LUT_LEN	129
+
+struct hdr_eotf_lut {
+	__u16 posx[DRM_SAMSUNG_HDR_EOTF_LUT_LEN];
+	__u32 posy[DRM_SAMSUNG_HDR_EOTF_LUT_LEN];
+};
+
+#define DRM_SAMSUNG_HDR_OETF_LUT_LEN	33
+
+struct hdr_oetf_lut {
+	__u16 posx[DRM_SAMSUNG_HDR_OETF_LUT_LEN];
+	__u16 posy[DRM_SAMSUNG_HDR_OETF_LUT_LEN];
+};
+
+#define DRM_SAMSUNG_HDR_GM_DIMENS	3
+
+struct hdr_gm_data {
+	__u32 coeffs[DRM_SAMSUNG_HDR_GM_DIMENS * DRM_SAMSUNG_HDR_GM_DIMENS];
+	__u32 offsets[DRM_SAMSUNG_HDR_GM_DIMENS];
+};
+
+#define DRM_SAMSUNG_HDR_TM_LUT_LEN	33
+
+struct hdr_tm_data {
+	__u16 coeff_r;
+	__u16 coeff_g;
+	__u16 coeff_b;
+	__u16 rng_x_min;
+	__u16 rng_x_max;
+	__u16 rng_y_min;
+	__u16 rng_y_max;
+	__u16 posx[DRM_SAMSUNG_HDR_TM_LUT_LEN];
+	__u32 posy[DRM_SAMSUNG_HDR_TM_LUT_LEN];
+};
+
+#define DRM_SAMSUNG_CGC_LUT_REG_CNT	2457
+
+struct cgc_lut {
+	__u32 r_values[DRM_SAMSUNG_CGC_LUT_REG_CNT];
+	__u32 g_values[DRM_SAMSUNG_CGC_LUT_REG_CNT];
+	__u32 b_values[DRM_SAMSUNG_CGC_LUT_REG_CNT];
+};
+
+#define DRM_SAMSUNG_MATRIX_DIMENS	3
+
+struct exynos_matrix {
+	__u16 coeffs[DRM_SAMSUNG_MATRIX_DIMENS * DRM_SAMSUNG_MATRIX_DIMENS];
+	__u16 offsets[DRM_SAMSUNG_MATRIX_DIMENS];
+};
+
+struct dither_config {
+	__u8 en:1;
+	__u8 mode:1;
+	__u8 frame_con:1;
+	__u8 frame_offset:2;
+	__u8 table_sel_r:1;
+	__u8 table_sel_g:1;
+	__u8 table_sel_b:1;
+	__u32 reserved:24;
+};
+
+struct histogram_roi {
+	__u16 start_x;
+	__u16 start_y;
+	__u16 hsize;
+	__u16 vsize;
+};
+
+struct histogram_weights {
+	__u16 weight_r;
+	__u16 weight_g;
+	__u16 weight_b;
+};
+
+#define HISTOGRAM_BIN_COUNT	256
+
+struct histogram_bins {
+	__u16 data[HISTOGRAM_BIN_COUNT];
+};
+
+enum exynos_prog_pos {
+	POST_DQE,
+	PRE_DQE,
+};
+
+#endif /* __HOST_SAMSUNG_DRM_H__ */
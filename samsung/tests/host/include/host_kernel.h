@@ -0,0 +1,19 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Force included in every host build translation unit, standing in for the
+ * headers the kernel build makes implicitly available to the CAL.
+ */
+#ifndef __HOST_KERNEL_H__
+#define __HOST_KERNEL_H__
+
+#define __iomem
+#define IS_ENABLED(option)	0
+
+#include <linux/kernel.h>
+#include <linux/bitmap.h>
+#include <linux/mutex.h>
+#include <linux/time.h>
+#include <drm/drm_fourcc.h>
+#include <drm/drm_print.h>
+
+#endif /* __HOST_KERNEL_H__ */
@@ -0,0 +1,17 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Host build stub: the kernel's multiplicative 32-bit hash, bit for bit.
+ */
+#ifndef __HOST_LINUX_HASH_H__
+#define __HOST_LINUX_HASH_H__
+
+#include <linux/types.h>
+
+#define GOLDEN_RATIO_32		0x61C88647
+
+static inline u32 hash_32(u32 val, unsigned int bits)
+{
+	return (val * GOLDEN_RATIO_32) >> (32 - bits);
+}
+
+#endif /* __HOST_LINUX_HASH_H__ */
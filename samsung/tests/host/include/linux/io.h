@@ -0,0 +1,5 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Host build stub: provided by cal_config.h on top of cal_sim.c.
+ */
+#include <cal_config.h>
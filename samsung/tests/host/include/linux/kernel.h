@@ -0,0 +1,74 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Host build stub: the subset of kernel helpers used by the CAL.
+ */
+#ifndef __HOST_LINUX_KERNEL_H__
+#define __HOST_LINUX_KERNEL_H__
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <linux/types.h>
+
+#define BIT(nr)			(1UL << (nr))
+#define BIT_ULL(nr)		(1ULL << (nr))
+#define BITS_PER_LONG		(8 * sizeof(long))
+#define GENMASK(h, l)		(((~0UL) - (1UL << (l)) + 1) & \
+				 (~0UL >> (BITS_PER_LONG - 1 - (h))))
+#define GENMASK_ULL(h, l)	(((~0ULL) - (1ULL << (l)) + 1) & \
+				 (~0ULL >> (63 - (h))))
+
+#define ARRAY_SIZE(arr)		(sizeof(arr) / sizeof((arr)[0]))
+#define DIV_ROUND_UP(n, d)	(((n) + (d) - 1) / (d))
+#define DIV_ROUND_CLOSEST(x, d)	(((x) + ((d) / 2)) / (d))
+#define DIV_ROUND_UP_ULL(n, d)	DIV_ROUND_UP((unsigned long long)(n), (d))
+#define ALIGN(x, a)		(((x) + (a) - 1) & ~((__typeof__(x))(a) - 1))
+#define IS_ALIGNED(x, a)	(((x) & ((__typeof__(x))(a) - 1)) == 0)
+
+#define min(x, y)		({ __typeof__(x) _x = (x); __typeof__(y) _y = (y); \
+				   _x < _y ? _x : _y; })
+#define max(x, y)		({ __typeof__(x) _x = (x); __typeof__(y) _y = (y); \
+				   _x > _y ? _x : _y; })
+#define max3(x, y, z)		max(max(x, y), z)
+#define min_t(t, x, y)		min((t)(x), (t)(y))
+#define max_t(t, x, y)		max((t)(x), (t)(y))
+#define clamp(v, lo, hi)	min(max(v, lo), hi)
+#define mult_frac(x, n, d)	({ __typeof__(x) _q = (x) / (d); \
+				   __typeof__(x) _r = (x) % (d); \
+				   _q * (n) + _r * (n) / (d); })
+#define swap(a, b)		do { __typeof__(a) _t = (a); (a) = (b); (b) = _t; } while (0)
+
+#define likely(x)		__builtin_expect(!!(x), 1)
+#ifndef unlikely
+#define unlikely(x)		__builtin_expect(!!(x), 0)
+#endif
+#define __maybe_unused		__attribute__((unused))
+#define __always_unused		__attribute__((unused))
+#define __packed		__attribute__((packed))
+#define fallthrough		__attribute__((fallthrough))
+#define READ_ONCE(x)		(*(const volatile __typeof__(x) *)&(x))
+#define WRITE_ONCE(x, v)	(*(volatile __typeof__(x) *)&(x) = (v))
+
+#define cpu_to_le32(x)		((u32)(x))
+#define le32_to_cpu(x)		((u32)(x))
+
+#define scnprintf(buf, size, fmt, ...)					\
+	({								\
+		size_t __size = (size);					\
+		int __n = snprintf(buf, __size, fmt, ##__VA_ARGS__);	\
+		__n < 0 ? 0 : ((size_t)__n >= __size ?			\
+			(__size ? (int)__size - 1 : 0) : __n);		\
+	})
+
+#define BUILD_BUG_ON(cond)	_Static_assert(!(cond), #cond)
+
+#define hweight32(w)		__builtin_popcount((u32)(w))
+#define hweight64(w)		__builtin_popcountll((u64)(w))
+
+static inline int fls(unsigned int x)
+{
+	return x ? 32 - __builtin_clz(x) : 0;
+}
+
+#endif /* __HOST_LINUX_KERNEL_H__ */
@@ -0,0 +1,26 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Host build stub: monotonic clock in nanoseconds.
+ */
+#ifndef __HOST_LINUX_KTIME_H__
+#define __HOST_LINUX_KTIME_H__
+
+#include <time.h>
+#include <linux/time.h>
+#include <linux/types.h>
+
+static inline ktime_t ktime_get(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (ktime_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+#define ktime_get_ns()		((u64)ktime_get())
+#define ktime_sub(a, b)		((a) - (b))
+#define ktime_to_ns(kt)		((s64)(kt))
+#define ktime_to_us(kt)		((s64)(kt) / NSEC_PER_USEC)
+
+#endif /* __HOST_LINUX_KTIME_H__ */
@@ -0,0 +1,19 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Host build stub: mutexes on top of pthreads.
+ */
+#ifndef __HOST_LINUX_MUTEX_H__
+#define __HOST_LINUX_MUTEX_H__
+
+#include <pthread.h>
+
+struct mutex {
+	pthread_mutex_t lock;
+};
+
+#define DEFINE_MUTEX(name)	struct mutex name = { PTHREAD_MUTEX_INITIALIZER }
+#define mutex_init(m)		pthread_mutex_init(&(m)->lock, NULL)
+#define mutex_lock(m)		pthread_mutex_lock(&(m)->lock)
+#define mutex_unlock(m)		pthread_mutex_unlock(&(m)->lock)
+
+#endif /* __HOST_LINUX_MUTEX_H__ */
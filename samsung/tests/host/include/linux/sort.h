@@ -0,0 +1,12 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Host build stub: sort() on top of qsort().
+ */
+#ifndef __HOST_LINUX_SORT_H__
+#define __HOST_LINUX_SORT_H__
+
+#include <stdlib.h>
+
+#define sort(base, num, size, cmp_func, swap_func)	qsort(base, num, size, cmp_func)
+
+#endif /* __HOST_LINUX_SORT_H__ */
@@ -0,0 +1,10 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Host build stub: string functions from the C library.
+ */
+#ifndef __HOST_LINUX_STRING_H__
+#define __HOST_LINUX_STRING_H__
+
+#include <string.h>
+
+#endif /* __HOST_LINUX_STRING_H__ */
@@ -0,0 +1,34 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Host build stub: kernel integer types on top of the C library.
+ */
+#ifndef __HOST_LINUX_TYPES_H__
+#define __HOST_LINUX_TYPES_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef unsigned long long u64;
+typedef int8_t s8;
+typedef int16_t s16;
+typedef int32_t s32;
+typedef long long s64;
+
+typedef uint8_t __u8;
+typedef uint16_t __u16;
+typedef uint32_t __u32;
+typedef unsigned long long __u64;
+typedef int8_t __s8;
+typedef int16_t __s16;
+typedef int32_t __s32;
+typedef long long __s64;
+
+typedef u64 phys_addr_t;
+typedef u64 dma_addr_t;
+typedef s64 ktime_t;
+
+#endif /* __HOST_LINUX_TYPES_H__ */
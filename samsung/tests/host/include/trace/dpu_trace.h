@@ -0,0 +1,12 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Host build stub: no tracing outside the kernel.
+ */
+#ifndef __HOST_DPU_TRACE_H__
+#define __HOST_DPU_TRACE_H__
+
+#define DPU_ATRACE_BEGIN(name)		do { } while (0)
+#define DPU_ATRACE_END(name)		do { } while (0)
+#define DPU_ATRACE_INT(name, value)	do { } while (0)
+
+#endif /* __HOST_DPU_TRACE_H__ */